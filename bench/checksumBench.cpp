@@ -0,0 +1,81 @@
+/**
+ * Host-side benchmark for frame checksums.
+ * Compares the 8-bit sum against table-driven CRC-16 and slice-by-4 CRC-32 on typical frame sizes,
+ * and reports the time to check a full 4096 byte reader buffer, the most one `SerialSocket::update` can receive.
+ * The V5 brain's Cortex-A9 is several times slower than a desktop, so compare the ratios rather than absolute times.
+ *
+ * Build and run from the repository root:
+ *   g++ -O2 -std=gnu++20 -Iinclude bench/checksumBench.cpp -o checksumBench && ./checksumBench
+ */
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <random>
+#include "vexbridge/utils/checksum.hpp"
+
+using namespace vexbridge::utils;
+using Clock = std::chrono::steady_clock;
+
+/// @brief Prevents the compiler from removing unused checksums
+volatile uint32_t sink = 0;
+
+/**
+ * Measures the throughput of a checksum.
+ * @param type The checksum algorithm.
+ * @param frameSize The number of bytes per call.
+ * @return The throughput in bytes per second.
+ */
+double measure(ChecksumType type, size_t frameSize)
+{
+    constexpr size_t TOTAL_BYTES = 256 * 1024 * 1024;
+
+    std::vector<uint8_t> frame(frameSize);
+    std::mt19937 random(frameSize);
+    for (uint8_t &byte : frame)
+        byte = random();
+
+    size_t iterations = TOTAL_BYTES / frameSize;
+    uint32_t result = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        frame[0] = i;
+        result ^= Checksum::calc(type, frame);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    sink = result;
+
+    return iterations * frameSize / seconds;
+}
+
+int main()
+{
+    const size_t frameSizes[] = {12, 64, 256, 1024, 4096};
+    const struct
+    {
+        const char *name;
+        ChecksumType type;
+    } checksums[] = {
+        {"sum8", ChecksumType::SUM8},
+        {"crc16", ChecksumType::CRC16},
+        {"crc32", ChecksumType::CRC32},
+    };
+
+    printf("%-8s", "MB/s");
+    for (size_t frameSize : frameSizes)
+        printf(" %10zuB", frameSize);
+    printf(" %16s\n", "us per 4096B");
+
+    for (auto &checksum : checksums)
+    {
+        printf("%-8s", checksum.name);
+        double largestThroughput = 0;
+        for (size_t frameSize : frameSizes)
+        {
+            largestThroughput = measure(checksum.type, frameSize);
+            printf(" %11.0f", largestThroughput / 1e6);
+        }
+        printf(" %16.2f\n", 4096 / largestThroughput * 1e6);
+    }
+    return 0;
+}
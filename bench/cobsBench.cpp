@@ -0,0 +1,163 @@
+/**
+ * Host-side benchmark comparing COBS framing to `ByteStuffer` escaping.
+ * Reports wire overhead and encode/decode throughput on a telemetry mix modeled on a match:
+ * odometry poses, motor temperatures, flags, log strings, and synced paths.
+ *
+ * Build and run from the repository root:
+ *   g++ -O2 -std=gnu++20 -Iinclude -Ibench bench/cobsBench.cpp bench/host/prosShim.cpp -o cobsBench -lpthread && ./cobsBench
+ */
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "vexbridge/serial/serialization/serialPacketEncoder.hpp"
+#include "vexbridge/utils/cobs.hpp"
+
+using namespace vexbridge::serial;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Encodes a packet as an unstuffed frame.
+ */
+Buffer makeFrame(SerialPacket &packet, uint16_t seq)
+{
+    Buffer stuffedFrame = SerialPacketEncoder::encode(packet, seq);
+    return ByteStuffer::decode(stuffedFrame);
+}
+
+/**
+ * Builds the unstuffed frames of one second of telemetry.
+ */
+std::vector<Buffer> makeTelemetry()
+{
+    std::vector<Buffer> frames;
+    uint16_t seq = 0;
+
+    for (int tick = 0; tick < 50; tick++)
+    {
+        double t = tick * 0.02;
+
+        // Odometry pose
+        const double pose[] = {24 + 10 * std::sin(t), -36 + 5 * std::cos(t), std::fmod(t * 90, 360)};
+        for (int i = 0; i < 3; i++)
+        {
+            UpdateDoublePacket packet;
+            packet.type = SerialPacketTypeID::UPDATE_DOUBLE;
+            packet.valueID = i;
+            packet.newValue = pose[i];
+            frames.push_back(makeFrame(packet, seq++));
+        }
+
+        // Motor temperatures and velocities
+        for (int i = 0; i < 8; i++)
+        {
+            UpdateFloatPacket packet;
+            packet.type = SerialPacketTypeID::UPDATE_FLOAT;
+            packet.valueID = 10 + i;
+            packet.newValue = i % 2 ? 35.0f + tick / 10 : 200.0f * std::sin(t + i);
+            frames.push_back(makeFrame(packet, seq++));
+        }
+
+        // Flags
+        UpdateBoolPacket flag;
+        flag.type = SerialPacketTypeID::UPDATE_BOOL;
+        flag.valueID = 20;
+        flag.newValue = tick % 10 == 0;
+        frames.push_back(makeFrame(flag, seq++));
+    }
+
+    // Log strings
+    for (int i = 0; i < 5; i++)
+    {
+        UpdateStringPacket packet;
+        packet.type = SerialPacketTypeID::UPDATE_STRING;
+        packet.valueID = 30;
+        packet.newValue = "AutoStep " + std::to_string(i) + ": drive to pose finished";
+        frames.push_back(makeFrame(packet, seq++));
+    }
+
+    // Synced path, as sent by `VBPath::sync`
+    UpdateFloatArrayPacket path;
+    path.type = SerialPacketTypeID::UPDATE_FLOAT_ARRAY;
+    path.valueID = 40;
+    for (int i = 0; i < 300; i++)
+        path.newValue.push_back(i < 50 ? 0.0f : 48.0f * std::sin(i * 0.01f));
+    frames.push_back(makeFrame(path, seq++));
+
+    return frames;
+}
+
+int main()
+{
+    constexpr int ROUNDS = 2000;
+    std::vector<Buffer> frames = makeTelemetry();
+
+    // Wire overhead
+    size_t rawBytes = 0;
+    size_t stuffedBytes = 0;
+    size_t cobsBytes = 0;
+    std::vector<uint8_t> output(8192);
+    std::vector<uint8_t> decoded(8192);
+    for (const Buffer &frame : frames)
+    {
+        rawBytes += frame.size();
+        stuffedBytes += ByteStuffer::encode(frame).size();
+        size_t cobsSize = Cobs::encode(frame, output);
+        cobsBytes += cobsSize;
+
+        // Check the round trip
+        size_t decodedSize = Cobs::decode(std::span<const uint8_t>(output.data(), cobsSize - 1), decoded.data());
+        if (decodedSize != frame.size() || memcmp(decoded.data(), frame.data(), frame.size()) != 0)
+        {
+            printf("COBS round trip failed\n");
+            return 1;
+        }
+    }
+
+    printf("%zu frames, %zu raw bytes\n", frames.size(), rawBytes);
+    printf("%-14s %12s %12s\n", "framing", "wire bytes", "overhead");
+    printf("%-14s %12zu %11.1f%%\n", "byte stuffing", stuffedBytes, 100.0 * (stuffedBytes - rawBytes) / rawBytes);
+    printf("%-14s %12zu %11.1f%%\n", "cobs", cobsBytes, 100.0 * (cobsBytes - rawBytes) / rawBytes);
+
+    // Encode and decode throughput
+    std::vector<Buffer> stuffedFrames;
+    std::vector<Buffer> cobsFrames;
+    for (const Buffer &frame : frames)
+    {
+        stuffedFrames.push_back(ByteStuffer::encode(frame));
+        size_t cobsSize = Cobs::encode(frame, output);
+        cobsFrames.emplace_back(output.begin(), output.begin() + cobsSize);
+    }
+
+    size_t sink = 0;
+    auto start = Clock::now();
+    for (int round = 0; round < ROUNDS; round++)
+        for (const Buffer &frame : frames)
+            sink += ByteStuffer::encode(frame).size();
+    double stuffEncodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int round = 0; round < ROUNDS; round++)
+        for (const Buffer &frame : frames)
+            sink += Cobs::encode(frame, output);
+    double cobsEncodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int round = 0; round < ROUNDS; round++)
+        for (const Buffer &frame : stuffedFrames)
+            sink += ByteStuffer::decode(frame, decoded.data());
+    double stuffDecodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int round = 0; round < ROUNDS; round++)
+        for (const Buffer &frame : cobsFrames)
+            sink += Cobs::decode(std::span<const uint8_t>(frame.data(), frame.size() - 1), decoded.data());
+    double cobsDecodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double totalRawBytes = (double)rawBytes * ROUNDS;
+    printf("\n%-14s %14s %14s\n", "MB/s (raw)", "encode", "decode");
+    printf("%-14s %14.0f %14.0f\n", "byte stuffing", totalRawBytes / stuffEncodeSeconds / 1e6, totalRawBytes / stuffDecodeSeconds / 1e6);
+    printf("%-14s %14.0f %14.0f\n", "cobs", totalRawBytes / cobsEncodeSeconds / 1e6, totalRawBytes / cobsDecodeSeconds / 1e6);
+    return sink == 0;
+}
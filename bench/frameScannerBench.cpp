@@ -0,0 +1,127 @@
+/**
+ * Host-side benchmark for splitting a serial stream into VEXBridge frames.
+ * Compares `SerialFrameScanner` against the previous vector-based reader at 1, 16, and 128 frames per read.
+ * Both sides include packet deserialization. The legacy reader also drops frames once a read exceeds its 2048 byte limit.
+ *
+ * Build and run from the repository root:
+ *   g++ -O2 -std=gnu++20 -Iinclude -Ibench bench/frameScannerBench.cpp bench/host/prosShim.cpp -o frameScannerBench -lpthread && ./frameScannerBench
+ */
+#include <chrono>
+#include <cstdio>
+#include "vexbridge/serial/serialization/serialPacketEncoder.hpp"
+#include "vexbridge/serial/serialization/serialPacketDecoder.hpp"
+#include "vexbridge/serial/serialization/serialFrameScanner.hpp"
+
+using namespace vexbridge::serial;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The reader algorithm used before `SerialFrameScanner`.
+ * Appends each read to a vector, decodes the whole vector, and erases from the front.
+ */
+struct LegacyReader
+{
+    Buffer readBuffer;
+
+    std::unique_ptr<SerialPacket> readPacket(const Buffer &inputBuffer)
+    {
+        readBuffer.insert(readBuffer.end(), inputBuffer.begin(), inputBuffer.end());
+        if (readBuffer.size() > 2048)
+            readBuffer.erase(readBuffer.begin(), readBuffer.begin() + readBuffer.size() - 2048);
+
+        for (size_t i = 0; i < readBuffer.size(); i++)
+        {
+            if (readBuffer[i] == ByteStuffer::ESCAPE_FLAG)
+            {
+                i++;
+                continue;
+            }
+            if (readBuffer[i] != ByteStuffer::END_FLAG)
+                continue;
+            try
+            {
+                auto packet = SerialPacketDecoder::decode(readBuffer);
+                readBuffer.erase(readBuffer.begin(), readBuffer.begin() + i + 1);
+                return packet;
+            }
+            catch (std::exception &e)
+            {
+            }
+            readBuffer.erase(readBuffer.begin(), readBuffer.begin() + i + 1);
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * Encodes a burst of float updates into a single read.
+ */
+Buffer makeBurst(int framesPerRead)
+{
+    Buffer burst;
+    for (int i = 0; i < framesPerRead; i++)
+    {
+        UpdateFloatPacket packet;
+        packet.type = SerialPacketTypeID::UPDATE_FLOAT;
+        packet.id = i;
+        packet.valueID = i;
+        packet.newValue = 0.5f * i;
+        Buffer frame = SerialPacketEncoder::encode(packet);
+        burst.insert(burst.end(), frame.begin(), frame.end());
+    }
+    return burst;
+}
+
+int main()
+{
+    constexpr int TOTAL_FRAMES = 200000;
+    const int framesPerReadOptions[] = {1, 16, 128};
+
+    printf("%-16s %18s %18s\n", "frames/read", "legacy frames/s", "scanner frames/s");
+    for (int framesPerRead : framesPerReadOptions)
+    {
+        Buffer burst = makeBurst(framesPerRead);
+        int reads = TOTAL_FRAMES / framesPerRead;
+
+        // Legacy reader decodes one frame per call, like `readPacketsFromSerial` looping on `readPacketFromSerial`
+        LegacyReader legacyReader;
+        size_t legacyFrames = 0;
+        Buffer empty;
+        auto legacyStart = Clock::now();
+        for (int i = 0; i < reads; i++)
+        {
+            if (legacyReader.readPacket(burst))
+                legacyFrames++;
+            while (legacyReader.readPacket(empty))
+                legacyFrames++;
+        }
+        double legacySeconds = std::chrono::duration<double>(Clock::now() - legacyStart).count();
+
+        // Ring buffer scanner
+        SerialFrameScanner<4096> scanner;
+        size_t scannerFrames = 0;
+        auto scannerStart = Clock::now();
+        for (int i = 0; i < reads; i++)
+        {
+            std::span<const uint8_t> input(burst.data(), burst.size());
+            while (!input.empty())
+            {
+                if (scanner.getFree() == 0)
+                    scanner.clear();
+                input = input.subspan(scanner.write(input));
+
+                std::span<const uint8_t> frame;
+                while (scanner.nextFrame(frame))
+                    if (SerialPacketDecoder::decodeFrame(frame))
+                        scannerFrames++;
+            }
+        }
+        double scannerSeconds = std::chrono::duration<double>(Clock::now() - scannerStart).count();
+
+        printf("%-16d %18.0f %18.0f\n",
+               framesPerRead,
+               legacyFrames / legacySeconds,
+               scannerFrames / scannerSeconds);
+    }
+    return 0;
+}
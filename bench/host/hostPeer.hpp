@@ -0,0 +1,470 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "vexbridge/serial/drivers/serialDriver.hpp"
+#include "vexbridge/serial/serialization/serialPacketEncoder.hpp"
+#include "vexbridge/serial/serialization/serialPacketDecoder.hpp"
+#include "vexbridge/serial/serialization/serialFrameScanner.hpp"
+#include "vexbridge/serial/packetTypes/assignLabelPacket.hpp"
+#include "vexbridge/serial/packetTypes/genericAckPacket.hpp"
+#include "vexbridge/serial/packetTypes/resetPacket.hpp"
+#include "vexbridge/serial/packetTypes/fetchValuesPacket.hpp"
+#include "vexbridge/serial/packetTypes/visionFramePacket.hpp"
+#include "vexbridge/serial/packetTypes/pingPacket.hpp"
+#include "vexbridge/serial/packetTypes/updateDoublePacket.hpp"
+#include "vexbridge/serial/helpers/resetPacketHandler.hpp"
+
+using namespace vexbridge::serial;
+
+/**
+ * Minimal host side of the VEXBridge protocol, used to run the robot's protocol stack on Linux.
+ * Takes part in the reset handshake, answers clock synchronization requests, acknowledges every reliable packet,
+ * and records labels, numeric values, and records.
+ * Runs in the caller's thread, so `update` must be called repeatedly. Counters may be read from other threads.
+ */
+class HostPeer
+{
+public:
+    /**
+     * Creates a new host peer.
+     * @param serialDriver The driver connected to the robot side.
+     * @param framingType How frames are delimited. Must match the robot side.
+     */
+    HostPeer(std::shared_ptr<SerialDriver> serialDriver, FramingType framingType = FramingType::BYTE_STUFFING)
+        : framingType(framingType),
+          serialDriver(serialDriver)
+    {
+        frameScanner.setFramingType(framingType);
+    }
+
+    /**
+     * Only decodes and records packets, without replying or acknowledging.
+     * Used to read replayed recordings, where the robot side is not listening.
+     * Frames are checked with the checksum set by `setChecksumType`, since no handshake takes place.
+     * @param isPassive True to stop replying.
+     */
+    void setPassive(bool isPassive)
+    {
+        this->isPassive = isPassive;
+    }
+
+    /**
+     * Sets the checksum frames are checked and written with, until the next `ResetPacket`.
+     * @param checksumType The checksum algorithm, such as the one of a recording.
+     */
+    void setChecksumType(ChecksumType checksumType)
+    {
+        this->checksumType = checksumType;
+    }
+
+    /**
+     * Stamps every packet sent with `updateDouble` or `sendVisionFrame` with the host's clock.
+     * @param isTimestamped True to stamp packets.
+     */
+    void setTimestamped(bool isTimestamped)
+    {
+        this->isTimestamped = isTimestamped;
+    }
+
+    /**
+     * Gets the time on the host's clock.
+     * Counts from a different start than the robot side's clock, as a real host would.
+     * @return The time in microseconds, modulo 2^32.
+     */
+    static uint32_t getTime()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Reads and handles every packet waiting on the serial driver.
+     */
+    void update()
+    {
+        while (true)
+        {
+            // Drop the buffered bytes if they fill the scanner without an end flag
+            if (frameScanner.getFree() == 0)
+                frameScanner.clear();
+
+            // Read directly into the scanner
+            std::span<uint8_t> writeSpan = frameScanner.getWriteSpan();
+            int32_t bytesRead = serialDriver->read(writeSpan);
+            if (bytesRead <= 0)
+                return;
+            frameScanner.commit(bytesRead);
+
+            // Handle every complete frame
+            std::span<const uint8_t> frame;
+            while (frameScanner.nextFrame(frame))
+                handleFrame(frame);
+        }
+    }
+
+    /**
+     * Starts the reset handshake, as a host connecting after the robot side's startup `ResetPacket` would.
+     * The robot side answers with its own `ResetPacket`. Call again if `isConnected` stays false, since the answer may be lost.
+     */
+    void sendReset()
+    {
+        ResetPacket resetPacket;
+        resetPacket.type = SerialPacketTypeID::RESET;
+        resetPacket.flags = SerialPacketFlag::NO_ACK;
+        resetPacket.supportedChecksums = ResetPacketHandler::SUPPORTED_CHECKSUMS;
+        write(resetPacket, 0);
+    }
+
+    /**
+     * Checks if the robot side has sent or answered a `ResetPacket`.
+     * @return True once the checksum has been agreed on.
+     */
+    bool isConnected() const
+    {
+        return isResetReceived;
+    }
+
+    /**
+     * Gets the label assigned to a value.
+     * @param valueID The ID of the value.
+     * @return The label or an empty string if none was assigned.
+     */
+    std::string getLabel(uint16_t valueID) const
+    {
+        auto it = labels.find(valueID);
+        return it == labels.end() ? "" : it->second;
+    }
+
+    /**
+     * Gets the latest value of a bool, int, float, or double.
+     * @param valueID The ID of the value.
+     * @param defaultValue The value to return if no update was received.
+     * @return The latest value or the default value.
+     */
+    double getNumber(uint16_t valueID, double defaultValue = 0) const
+    {
+        auto it = numbers.find(valueID);
+        return it == numbers.end() ? defaultValue : it->second;
+    }
+
+    /**
+     * Gets the schema announced with the label of a record.
+     * @param valueID The ID of the value.
+     * @return The schema or an empty string if the value is not a record.
+     */
+    std::string getSchema(uint16_t valueID) const
+    {
+        auto it = schemas.find(valueID);
+        return it == schemas.end() ? "" : it->second;
+    }
+
+    /**
+     * Gets the latest packed value of a record.
+     * @param valueID The ID of the value.
+     * @return The packed record or an empty buffer if no update was received.
+     */
+    Buffer getRecord(uint16_t valueID) const
+    {
+        auto it = records.find(valueID);
+        return it == records.end() ? Buffer() : it->second;
+    }
+
+    /**
+     * Gets the number of labels assigned by the robot side.
+     * @return The number of labels.
+     */
+    size_t getLabelCount() const
+    {
+        return labels.size();
+    }
+
+    /**
+     * Asks the robot side to send every label and value.
+     */
+    void fetchValues()
+    {
+        FetchValuesPacket fetchValuesPacket;
+        fetchValuesPacket.type = SerialPacketTypeID::FETCH_VALUES;
+        write(fetchValuesPacket, 0);
+    }
+
+    /**
+     * Sends a double value to the robot side, as the dashboard does when a value is edited.
+     * @param valueID The ID of the value.
+     * @param value The new value.
+     * @param captureTime The time the value was captured on the host's clock in microseconds. Only sent if timestamped.
+     */
+    void updateDouble(uint16_t valueID, double value, uint32_t captureTime = getTime())
+    {
+        UpdateDoublePacket updatePacket;
+        updatePacket.type = SerialPacketTypeID::UPDATE_DOUBLE;
+        updatePacket.valueID = valueID;
+        updatePacket.newValue = value;
+        stamp(updatePacket, captureTime);
+        write(updatePacket, nextSeq++);
+    }
+
+    /**
+     * Sends a camera frame to the robot side, as a vision coprocessor would.
+     * @param valueID The ID the frames of the camera are sent to.
+     * @param frameNumber The number of the frame.
+     * @param captureTime The time the frame was captured on the coprocessor's clock in milliseconds.
+     * @param frameAge The time from capture until now in milliseconds.
+     * @param targets The targets in the frame.
+     */
+    void sendVisionFrame(uint16_t valueID, uint32_t frameNumber, uint32_t captureTime, uint16_t frameAge, const std::vector<VisionTarget> &targets)
+    {
+        VisionFramePacket framePacket;
+        framePacket.type = SerialPacketTypeID::VISION_FRAME;
+        framePacket.valueID = valueID;
+        framePacket.frameNumber = frameNumber;
+        framePacket.captureTime = captureTime;
+        framePacket.frameAge = frameAge;
+        framePacket.targets = targets;
+        stamp(framePacket, getTime());
+        write(framePacket, nextSeq++);
+    }
+
+    /// @brief Number of packets decoded, including duplicates
+    std::atomic<uint32_t> packetCount = 0;
+
+    /// @brief Number of value updates received, counting each entry of a batch
+    std::atomic<uint32_t> valueUpdateCount = 0;
+
+    /// @brief Number of clock synchronization requests answered
+    std::atomic<uint32_t> pingCount = 0;
+
+    /// @brief Number of frames dropped because they failed to decode
+    std::atomic<uint32_t> corruptFrameCount = 0;
+
+protected:
+    /**
+     * Decodes and handles a single unstuffed frame.
+     * @param frame The unstuffed frame.
+     */
+    void handleFrame(std::span<const uint8_t> frame)
+    {
+        uint32_t receiveTime = getTime();
+        std::unique_ptr<SerialPacket> packet;
+        try
+        {
+            packet = SerialPacketDecoder::decodeFrame(frame, checksumType);
+        }
+        catch (std::exception &e)
+        {
+            // Corrupt frames are resent by the robot side
+            corruptFrameCount++;
+            return;
+        }
+        packetCount++;
+
+        // ACKs do not need a reply
+        if (packet->type == SerialPacketTypeID::GENERIC_ACK || packet->type == SerialPacketTypeID::SELECTIVE_ACK)
+            return;
+
+        // Answer the robot side's `ResetPacket` with our own and agree on a checksum
+        // The reply is sent before the ACK, so the ACK is checked with the agreed checksum
+        if (auto resetPacket = dynamic_cast<ResetPacket *>(packet.get()))
+        {
+            if (!resetPacket->isReply)
+            {
+                ResetPacket reply;
+                reply.type = SerialPacketTypeID::RESET;
+                reply.flags = SerialPacketFlag::NO_ACK;
+                reply.isReply = true;
+                reply.supportedChecksums = ResetPacketHandler::SUPPORTED_CHECKSUMS;
+                write(reply, 0);
+            }
+            checksumType = ResetPacketHandler::getSharedChecksum(resetPacket->supportedChecksums);
+            isResetReceived = true;
+        }
+
+        // Reply to clock synchronization requests with our own times
+        if (auto pingPacket = dynamic_cast<PingPacket *>(packet.get()))
+        {
+            if (!pingPacket->isReply)
+            {
+                PingPacket reply;
+                reply.type = SerialPacketTypeID::PING;
+                reply.flags = SerialPacketFlag::NO_ACK;
+                reply.isReply = true;
+                reply.originTime = pingPacket->originTime;
+                reply.receiveTime = receiveTime;
+                reply.transmitTime = getTime();
+                write(reply, 0);
+                pingCount++;
+            }
+            return;
+        }
+
+        // Record labels and values
+        if (auto assignLabelPacket = dynamic_cast<AssignLabelPacket *>(packet.get()))
+            recordLabel(assignLabelPacket->valueID, assignLabelPacket->label, assignLabelPacket->schema);
+        else if (auto batchPacket = dynamic_cast<BatchPacketV2 *>(packet.get()))
+            batchPacket->forEachEntry([&](SerialPacketTypeID type, uint16_t valueID, BufferReader &reader)
+                                      { recordBatchEntry(type, valueID, reader); });
+        else if (auto batchPacket = dynamic_cast<BatchPacket *>(packet.get()))
+            valueUpdateCount += batchPacket->subPackets.size();
+        else
+            recordValue(packet.get());
+
+        // Best-effort packets must not be acknowledged
+        if (packet->flags & SerialPacketFlag::NO_ACK)
+            return;
+
+        // Acknowledge the packet
+        GenericAckPacket ack;
+        ack.type = SerialPacketTypeID::GENERIC_ACK;
+        write(ack, packet->id);
+    }
+
+    /**
+     * Records a label and the schema of its record, if any.
+     * @param valueID The ID of the value.
+     * @param label The label of the value.
+     * @param schema The schema of the record or an empty string.
+     */
+    void recordLabel(uint16_t valueID, const std::string &label, const std::string &schema)
+    {
+        labels[valueID] = label;
+        if (!schema.empty())
+            schemas[valueID] = schema;
+    }
+
+    /**
+     * Records a label, numeric value, or record of a `BatchPacketV2` entry.
+     * @param type The type ID of the entry.
+     * @param valueID The ID of the value.
+     * @param reader The reader positioned at the value.
+     */
+    void recordBatchEntry(SerialPacketTypeID type, uint16_t valueID, BufferReader &reader)
+    {
+        if (type == SerialPacketTypeID::ASSIGN_LABEL)
+        {
+            std::string label;
+            BatchPacketV2::readValue(reader, label);
+            recordLabel(valueID, label, reader.hasData() ? reader.readString16() : "");
+            return;
+        }
+        valueUpdateCount++;
+
+        switch (type)
+        {
+        case SerialPacketTypeID::UPDATE_BOOL:
+            return recordBatchNumber<bool>(valueID, reader);
+        case SerialPacketTypeID::UPDATE_INT:
+            return recordBatchNumber<int>(valueID, reader);
+        case SerialPacketTypeID::UPDATE_FLOAT:
+            return recordBatchNumber<float>(valueID, reader);
+        case SerialPacketTypeID::UPDATE_DOUBLE:
+            return recordBatchNumber<double>(valueID, reader);
+        case SerialPacketTypeID::UPDATE_RECORD:
+            return BatchPacketV2::readValue(reader, records[valueID]);
+        default:
+            return;
+        }
+    }
+
+    template <typename T>
+    void recordBatchNumber(uint16_t valueID, BufferReader &reader)
+    {
+        T value;
+        BatchPacketV2::readValue(reader, value);
+        numbers[valueID] = value;
+    }
+
+    /**
+     * Records the value of an update packet.
+     * @param packet The packet to record.
+     */
+    void recordValue(SerialPacket *packet)
+    {
+        if (packet->type >= SerialPacketTypeID::UPDATE_BOOL && packet->type <= SerialPacketTypeID::UPDATE_QUANTIZED_ARRAY)
+            valueUpdateCount++;
+
+        if (auto updatePacket = dynamic_cast<UpdateValuePacket<bool> *>(packet))
+            numbers[updatePacket->valueID] = updatePacket->newValue;
+        else if (auto updatePacket = dynamic_cast<UpdateValuePacket<int> *>(packet))
+            numbers[updatePacket->valueID] = updatePacket->newValue;
+        else if (auto updatePacket = dynamic_cast<UpdateValuePacket<float> *>(packet))
+            numbers[updatePacket->valueID] = updatePacket->newValue;
+        else if (auto updatePacket = dynamic_cast<UpdateValuePacket<double> *>(packet))
+            numbers[updatePacket->valueID] = updatePacket->newValue;
+        else if (auto updatePacket = dynamic_cast<UpdateRecordPacket *>(packet))
+            records[updatePacket->valueID] = updatePacket->newValue;
+    }
+
+    /**
+     * Stamps a packet with a time on the host's clock if timestamps are enabled.
+     * @param packet The packet to stamp.
+     * @param captureTime The time its data was captured in microseconds.
+     */
+    void stamp(SerialPacket &packet, uint32_t captureTime)
+    {
+        if (!isTimestamped)
+            return;
+        packet.flags |= SerialPacketFlag::HAS_TIMESTAMP;
+        packet.timestamp = captureTime;
+    }
+
+    /**
+     * Encodes and writes a packet.
+     * Does nothing while passive.
+     * @param packet The packet to write.
+     * @param seq The sequence number to send the packet with.
+     */
+    void write(const SerialPacket &packet, uint16_t seq)
+    {
+        if (isPassive)
+            return;
+        SerialPacketEncoder::encode(packet, seq, checksumType, framingType, frameBuffer);
+        serialDriver->write(std::span<const uint8_t>(frameBuffer));
+    }
+
+private:
+    /// @brief Maximum number of buffered bytes
+    static constexpr size_t MAX_BUFFER_SIZE = 65536;
+
+    /// @brief Splits received bytes into frames
+    SerialFrameScanner<MAX_BUFFER_SIZE> frameScanner;
+
+    /// @brief Frame being written
+    Buffer frameBuffer;
+
+    /// @brief Checksum agreed on with the robot side
+    ChecksumType checksumType = ChecksumType::SUM8;
+
+    /// @brief How frames are delimited
+    FramingType framingType;
+
+    /// @brief True once the robot side has sent or answered a `ResetPacket`
+    bool isResetReceived = false;
+
+    /// @brief True to only decode and record packets
+    bool isPassive = false;
+
+    /// @brief True to stamp sent values with the host's clock
+    bool isTimestamped = false;
+
+    /// @brief Sequence number of the next value sent to the robot side
+    uint16_t nextSeq = 0;
+
+    /// @brief Labels assigned by the robot side, indexed by value ID
+    std::unordered_map<uint16_t, std::string> labels;
+
+    /// @brief Latest numeric values, indexed by value ID
+    std::unordered_map<uint16_t, double> numbers;
+
+    /// @brief Schemas announced with the labels of records, indexed by value ID
+    std::unordered_map<uint16_t, std::string> schemas;
+
+    /// @brief Latest packed records, indexed by value ID
+    std::unordered_map<uint16_t, Buffer> records;
+
+    std::shared_ptr<SerialDriver> serialDriver;
+};
@@ -0,0 +1,160 @@
+/**
+ * Implements the parts of the PROS RTOS API used by VEXBridge on top of the C++ standard library,
+ * so the protocol stack can be built and run on Linux.
+ * Tasks are detached threads, mutexes are timed mutexes, and the clock starts when the program starts.
+ * Task notifications are counters guarded by a condition variable.
+ */
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "pros/rtos.hpp"
+
+using SteadyClock = std::chrono::steady_clock;
+
+/**
+ * Notification counter of a task.
+ */
+struct TaskNotification
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    uint32_t value = 0;
+};
+
+/// @brief Notification counter of the calling thread. Created on first use by threads that are not tasks.
+static thread_local TaskNotification *currentNotification = nullptr;
+
+/// @brief Time the program started. `millis` and `micros` count from here.
+static const SteadyClock::time_point startTime = SteadyClock::now();
+
+namespace pros
+{
+    namespace c
+    {
+        extern "C" uint32_t millis(void)
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(SteadyClock::now() - startTime).count();
+        }
+
+        extern "C" uint64_t micros(void)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - startTime).count();
+        }
+
+        extern "C" void delay(const uint32_t milliseconds)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        }
+
+        extern "C" void task_delay(const uint32_t milliseconds)
+        {
+            delay(milliseconds);
+        }
+    }
+
+    inline namespace rtos
+    {
+        Task::Task(task_fn_t function, void *parameters, std::uint32_t, std::uint16_t, const char *)
+        {
+            // Tasks run forever, so their notification counters are never freed
+            TaskNotification *notification = new TaskNotification();
+            task = notification;
+
+            std::thread([function, parameters, notification]
+                        {
+                            currentNotification = notification;
+                            function(parameters); })
+                .detach();
+        }
+
+        Task::Task(task_fn_t function, void *parameters, const char *name)
+            : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name)
+        {
+        }
+
+        Task::Task(task_t task) : task(task)
+        {
+        }
+
+        Task Task::current()
+        {
+            // The main thread gets its notification counter on first use
+            if (!currentNotification)
+                currentNotification = new TaskNotification();
+            return Task((task_t)currentNotification);
+        }
+
+        void Task::delay(const std::uint32_t milliseconds)
+        {
+            pros::c::delay(milliseconds);
+        }
+
+        std::uint32_t Task::notify()
+        {
+            TaskNotification *notification = (TaskNotification *)task;
+            {
+                std::lock_guard<std::mutex> lock(notification->mutex);
+                notification->value++;
+            }
+            notification->condition.notify_one();
+            return 1;
+        }
+
+        std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout)
+        {
+            if (!currentNotification)
+                currentNotification = new TaskNotification();
+            TaskNotification *notification = currentNotification;
+
+            // Wait for a notification, then decrement or clear the counter
+            std::unique_lock<std::mutex> lock(notification->mutex);
+            notification->condition.wait_for(lock, std::chrono::milliseconds(timeout), [&]
+                                             { return notification->value > 0; });
+            std::uint32_t value = notification->value;
+            if (clear_on_exit)
+                notification->value = 0;
+            else if (value > 0)
+                notification->value--;
+            return value;
+        }
+
+        Mutex::Mutex()
+            : mutex(new std::timed_mutex(), [](void *mutex)
+                    { delete (std::timed_mutex *)mutex; })
+        {
+        }
+
+        bool Mutex::take()
+        {
+            ((std::timed_mutex *)mutex.get())->lock();
+            return true;
+        }
+
+        bool Mutex::take(std::uint32_t timeout)
+        {
+            return ((std::timed_mutex *)mutex.get())->try_lock_for(std::chrono::milliseconds(timeout));
+        }
+
+        bool Mutex::give()
+        {
+            ((std::timed_mutex *)mutex.get())->unlock();
+            return true;
+        }
+
+        void Mutex::lock()
+        {
+            take();
+        }
+
+        void Mutex::unlock()
+        {
+            give();
+        }
+
+        bool Mutex::try_lock()
+        {
+            return take(0);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include <errno.h>
+#include <stdlib.h>
+#include "vexbridge/serial/drivers/serialDriver.hpp"
+#include "vexbridge/utils/buffer.h"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * Interface for reading and writing data through a Linux pseudo-terminal.
+     * Lets the protocol stack run on a host and talk to a peer in another process through the kernel's tty layer.
+     * \note Host only. Uses POSIX calls that do not exist on the V5.
+     */
+    class PtySerialDriver : public SerialDriver
+    {
+    public:
+        /**
+         * Opens a new pseudo-terminal and connects to its master side.
+         * The peer opens the path returned by `getDevicePath`.
+         * @throws std::runtime_error if the pseudo-terminal cannot be opened.
+         */
+        PtySerialDriver()
+        {
+            // Open the master side
+            fileDescriptor = posix_openpt(O_RDWR | O_NOCTTY);
+            if (fileDescriptor < 0 || grantpt(fileDescriptor) != 0 || unlockpt(fileDescriptor) != 0)
+                throw std::runtime_error("Failed to open pseudo-terminal.");
+            devicePath = ptsname(fileDescriptor);
+
+            configure();
+        }
+
+        /**
+         * Connects to an existing terminal, such as the slave side of another `PtySerialDriver`.
+         * @param devicePath The path of the terminal.
+         * @throws std::runtime_error if the terminal cannot be opened.
+         */
+        PtySerialDriver(const std::string &devicePath)
+            : devicePath(devicePath)
+        {
+            fileDescriptor = open(devicePath.c_str(), O_RDWR | O_NOCTTY);
+            if (fileDescriptor < 0)
+                throw std::runtime_error("Failed to open " + devicePath + ".");
+
+            configure();
+        }
+
+        ~PtySerialDriver()
+        {
+            if (fileDescriptor >= 0)
+                close(fileDescriptor);
+        }
+
+        // Disable copy and assignment
+        PtySerialDriver(const PtySerialDriver &) = delete;
+        PtySerialDriver &operator=(const PtySerialDriver &) = delete;
+
+        /**
+         * Gets the path of the terminal.
+         * For a new pseudo-terminal, this is the slave side the peer should open.
+         * @return The path of the terminal.
+         */
+        const std::string &getDevicePath() const
+        {
+            return devicePath;
+        }
+
+        bool write(Buffer &buffer) override
+        {
+            return write(std::span<const uint8_t>(buffer));
+        }
+
+        bool write(std::span<const uint8_t> bytes) override
+        {
+            // Write until every byte is accepted
+            // The terminal is non-blocking, so wait for space when its buffer is full
+            size_t bytesWritten = 0;
+            while (bytesWritten < bytes.size())
+            {
+                ssize_t writeRes = ::write(fileDescriptor, bytes.data() + bytesWritten, bytes.size() - bytesWritten);
+                stats.sdkCalls++;
+                if (writeRes >= 0)
+                {
+                    bytesWritten += writeRes;
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EINTR)
+                    break;
+
+                // Give up if the peer stops reading
+                pollfd pollRequest = {fileDescriptor, POLLOUT, 0};
+                if (poll(&pollRequest, 1, WRITE_TIMEOUT) <= 0)
+                    break;
+            }
+
+            stats.bytesWritten += bytesWritten;
+            return bytesWritten == bytes.size();
+        }
+
+        using SerialDriver::read;
+
+        int32_t read(std::span<uint8_t> output) override
+        {
+            // Read whatever is available without blocking
+            ssize_t bytesRead = ::read(fileDescriptor, output.data(), output.size());
+            stats.sdkCalls++;
+            if (bytesRead < 0)
+                return errno == EAGAIN || errno == EINTR ? 0 : -1;
+
+            stats.bytesRead += bytesRead;
+            return bytesRead;
+        }
+
+        SerialDriverStats getStats() const override
+        {
+            return stats;
+        }
+
+    private:
+        /**
+         * Switches the terminal to raw, non-blocking mode, so bytes are passed through unchanged.
+         * @throws std::runtime_error if the terminal cannot be configured.
+         */
+        void configure()
+        {
+            termios settings;
+            if (tcgetattr(fileDescriptor, &settings) != 0)
+                throw std::runtime_error("Failed to read terminal settings.");
+            cfmakeraw(&settings);
+            if (tcsetattr(fileDescriptor, TCSANOW, &settings) != 0)
+                throw std::runtime_error("Failed to set terminal settings.");
+
+            fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) | O_NONBLOCK);
+        }
+
+        /// @brief Maximum time to wait for space in the terminal buffer in milliseconds
+        static constexpr int WRITE_TIMEOUT = 100;
+
+        /// @brief Path of the terminal
+        std::string devicePath;
+
+        /// @brief Open terminal
+        int fileDescriptor = -1;
+
+        /// @brief Usage counters
+        SerialDriverStats stats;
+    };
+}
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <span>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "vexbridge/serial/drivers/serialDriver.hpp"
+#include "vexbridge/serial/recording/recordingFormat.h"
+#include "vexbridge/serial/serialization/framingType.h"
+#include "vexbridge/utils/bufferReader.hpp"
+
+using namespace vexbridge::serial;
+
+/**
+ * A frame read from a recording.
+ */
+struct RecordedFrame
+{
+    /// @brief Time the frame was written, in milliseconds since the robot program started
+    uint32_t timestamp = 0;
+
+    /// @brief The frame, exactly as it was written to the serial port. Valid until the next read.
+    std::span<const uint8_t> bytes;
+};
+
+/**
+ * Reads a recording written by `FrameRecorder`.
+ * Maps the file into memory, so seeking only reads the block headers it searches.
+ * Blocks that were torn by a power loss are skipped, along with the frames that cross them.
+ * \note Host only. Uses POSIX calls that do not exist on the V5.
+ */
+class RecordingReader
+{
+public:
+    /**
+     * Opens a recording.
+     * @param path The path of the recording.
+     * @throws std::runtime_error if the file cannot be opened or is not a recording.
+     */
+    RecordingReader(const std::string &path)
+    {
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+            throw std::runtime_error("Failed to open " + path + ".");
+
+        // Only whole blocks are written, so a partial block at the end was torn
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) == 0)
+            blockCount = fileStat.st_size / RecordingFormat::BLOCK_SIZE;
+        if (blockCount > 0)
+        {
+            void *mapping = mmap(nullptr, blockCount * RecordingFormat::BLOCK_SIZE, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            if (mapping != MAP_FAILED)
+                bytes = (const uint8_t *)mapping;
+        }
+        close(fileDescriptor);
+
+        if (!bytes || !isValidBlock(0))
+        {
+            unmap();
+            throw std::runtime_error(path + " is not a recording.");
+        }
+        framingType = (FramingType)bytes[5];
+        seekBlock(0);
+    }
+
+    ~RecordingReader()
+    {
+        unmap();
+    }
+
+    // Disable copy and assignment
+    RecordingReader(const RecordingReader &) = delete;
+    RecordingReader &operator=(const RecordingReader &) = delete;
+
+    /**
+     * Gets how the recorded frames are delimited.
+     * @return The framing type of the recording.
+     */
+    FramingType getFramingType() const
+    {
+        return framingType;
+    }
+
+    /**
+     * Gets the checksum of the recorded frames.
+     * @return The checksum type of the recording.
+     */
+    ChecksumType getChecksumType() const
+    {
+        return RecordingFormat::CHECKSUM_TYPE;
+    }
+
+    /**
+     * Gets the number of whole blocks in the recording.
+     * @return The number of blocks.
+     */
+    size_t getBlockCount() const
+    {
+        return blockCount;
+    }
+
+    /**
+     * Gets the time of the first frame.
+     * @return The time in milliseconds since the robot program started.
+     */
+    uint32_t getStartTime() const
+    {
+        return getBlockTimestamp(0);
+    }
+
+    /**
+     * Moves to the first frame written at or after a time.
+     * Finds the block with a binary search of the block headers, then reads forward within it.
+     * @param timestamp The time in milliseconds since the robot program started.
+     */
+    void seek(uint32_t timestamp)
+    {
+        // Find the last block that starts a record at or before the time
+        size_t low = 0;
+        size_t high = blockCount;
+        while (high - low > 1)
+        {
+            // Torn blocks and blocks that only continue a record are skipped
+            size_t middle = low + (high - low) / 2;
+            size_t recordStart = findRecordStart(middle, high);
+            if (recordStart >= high || getBlockTimestamp(recordStart) > timestamp)
+                high = middle;
+            else
+                low = recordStart;
+        }
+        seekBlock(low);
+
+        // Skip the frames before the time
+        size_t savedBlock;
+        size_t savedOffset;
+        RecordedFrame frame;
+        do
+        {
+            savedBlock = blockIndex;
+            savedOffset = offset;
+        } while (next(frame) && frame.timestamp < timestamp);
+        blockIndex = savedBlock;
+        offset = savedOffset;
+    }
+
+    /**
+     * Reads the next frame.
+     * @param frame Set to the next frame.
+     * @return False once the end of the recording is reached.
+     */
+    bool next(RecordedFrame &frame)
+    {
+        while (blockIndex < blockCount)
+        {
+            // Move to the next block at padding or the end of the block
+            if (!isValidBlock(blockIndex) || offset + RecordingFormat::RECORD_HEADER_SIZE > RecordingFormat::BLOCK_SIZE)
+            {
+                seekBlock(blockIndex + 1);
+                continue;
+            }
+            BufferReader reader(std::span<const uint8_t>(getBlock(blockIndex) + offset, RecordingFormat::RECORD_HEADER_SIZE));
+            uint32_t timestamp = reader.readUInt32BE();
+            uint16_t length = reader.readUInt16BE();
+            if (length == 0)
+            {
+                seekBlock(blockIndex + 1);
+                continue;
+            }
+            offset += RecordingFormat::RECORD_HEADER_SIZE;
+
+            // Point into the file if the frame is in one block
+            frame.timestamp = timestamp;
+            if (offset + length <= RecordingFormat::BLOCK_SIZE)
+            {
+                frame.bytes = std::span<const uint8_t>(getBlock(blockIndex) + offset, length);
+                offset += length;
+                return true;
+            }
+
+            // Otherwise, join its parts
+            // Frames that cross a torn block are skipped
+            if (joinFrame(length))
+            {
+                frame.bytes = std::span<const uint8_t>(frameBuffer);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    /**
+     * Gets the start of a block.
+     * @param index The index of the block.
+     * @return The first byte of the block.
+     */
+    const uint8_t *getBlock(size_t index) const
+    {
+        return bytes + index * RecordingFormat::BLOCK_SIZE;
+    }
+
+    /**
+     * Checks if a block has a valid header.
+     * @param index The index of the block.
+     * @return True if the block was written whole.
+     */
+    bool isValidBlock(size_t index) const
+    {
+        BufferReader reader(std::span<const uint8_t>(getBlock(index), RecordingFormat::BLOCK_HEADER_SIZE));
+        return reader.readUInt32BE() == RecordingFormat::MAGIC && reader.readUInt8() == RecordingFormat::VERSION;
+    }
+
+    /**
+     * Gets the offset of the first record that starts in a block.
+     * @param index The index of the block.
+     * @return The offset or `NO_RECORD_START`.
+     */
+    uint16_t getFirstRecordOffset(size_t index) const
+    {
+        const uint8_t *block = getBlock(index);
+        return (uint16_t)(block[6] << 8) | block[7];
+    }
+
+    /**
+     * Gets the time of the first record that starts in a block.
+     * @param index The index of the block.
+     * @return The time in milliseconds since the robot program started.
+     */
+    uint32_t getBlockTimestamp(size_t index) const
+    {
+        BufferReader reader(std::span<const uint8_t>(getBlock(index) + 8, 4));
+        return reader.readUInt32BE();
+    }
+
+    /**
+     * Finds the first valid block that starts a record.
+     * @param index The index of the block to start searching from.
+     * @param end The index of the block to stop searching at.
+     * @return The index of the block or `end` if there is none.
+     */
+    size_t findRecordStart(size_t index, size_t end) const
+    {
+        while (index < end && (!isValidBlock(index) || getFirstRecordOffset(index) == RecordingFormat::NO_RECORD_START))
+            index++;
+        return index;
+    }
+
+    /**
+     * Moves to the first record that starts in or after a block.
+     * @param index The index of the block.
+     */
+    void seekBlock(size_t index)
+    {
+        blockIndex = findRecordStart(index, blockCount);
+        offset = blockIndex < blockCount ? getFirstRecordOffset(blockIndex) : 0;
+    }
+
+    /**
+     * Copies a frame that continues into the following blocks into `frameBuffer`.
+     * @param length The length of the frame.
+     * @return True if the frame was copied, false if it crosses a torn block or the end of the file.
+     */
+    bool joinFrame(size_t length)
+    {
+        frameBuffer.clear();
+        while (true)
+        {
+            size_t partLength = std::min(length - frameBuffer.size(), RecordingFormat::BLOCK_SIZE - offset);
+            const uint8_t *part = getBlock(blockIndex) + offset;
+            frameBuffer.insert(frameBuffer.end(), part, part + partLength);
+            offset += partLength;
+            if (frameBuffer.size() == length)
+                return true;
+
+            // Continue after the header of the next block
+            if (blockIndex + 1 >= blockCount || !isValidBlock(blockIndex + 1))
+            {
+                seekBlock(blockIndex + 1);
+                return false;
+            }
+            blockIndex++;
+            offset = RecordingFormat::BLOCK_HEADER_SIZE;
+        }
+    }
+
+    /**
+     * Unmaps the file.
+     */
+    void unmap()
+    {
+        if (bytes)
+            munmap((void *)bytes, blockCount * RecordingFormat::BLOCK_SIZE);
+        bytes = nullptr;
+    }
+
+    /// @brief The mapped file
+    const uint8_t *bytes = nullptr;
+
+    /// @brief Number of whole blocks in the file
+    size_t blockCount = 0;
+
+    /// @brief How the recorded frames are delimited
+    FramingType framingType = FramingType::BYTE_STUFFING;
+
+    /// @brief Index of the block being read
+    size_t blockIndex = 0;
+
+    /// @brief Offset of the next record header in the block being read
+    size_t offset = 0;
+
+    /// @brief Frame joined from several blocks
+    Buffer frameBuffer;
+};
+
+/**
+ * Writes the frames of a recording to a serial driver, spaced as they were recorded.
+ * Connect the other side of the driver to a passive `HostPeer`, or to the dashboard through a pseudo-terminal.
+ * Runs in the caller's thread, so `update` must be called repeatedly.
+ */
+class RecordingReplayer
+{
+public:
+    /**
+     * Creates a new replayer. Starts from the reader's current frame.
+     * @param reader The recording to replay.
+     * @param serialDriver The driver to write the frames to.
+     * @param speed How many times faster than real time to replay, or 0 to replay as fast as the driver takes frames.
+     */
+    RecordingReplayer(RecordingReader &reader, std::shared_ptr<SerialDriver> serialDriver, double speed = 1)
+        : reader(reader),
+          serialDriver(serialDriver),
+          speed(speed)
+    {
+        isPending = reader.next(pendingFrame);
+    }
+
+    /**
+     * Writes every frame that is due.
+     * Frames wait while the driver has no room for them, so none are dropped.
+     * @return False once every frame has been written.
+     */
+    bool update()
+    {
+        auto now = SteadyClock::now();
+        if (!isStarted)
+        {
+            startTime = now;
+            recordingStartTime = pendingFrame.timestamp;
+            isStarted = true;
+        }
+        double elapsed = std::chrono::duration<double, std::milli>(now - startTime).count();
+
+        while (isPending)
+        {
+            // Wait until the frame is due
+            double frameTime = pendingFrame.timestamp - recordingStartTime;
+            if (speed > 0 && frameTime / speed > elapsed)
+                return true;
+
+            // Wait until the driver has room for the frame
+            if (serialDriver->getWriteFree() < (int32_t)pendingFrame.bytes.size())
+                return true;
+
+            serialDriver->write(pendingFrame.bytes);
+            framesWritten++;
+            isPending = reader.next(pendingFrame);
+        }
+        return false;
+    }
+
+    /// @brief Number of frames written
+    uint32_t framesWritten = 0;
+
+private:
+    using SteadyClock = std::chrono::steady_clock;
+
+    /// @brief The recording being replayed
+    RecordingReader &reader;
+
+    /// @brief The driver frames are written to
+    std::shared_ptr<SerialDriver> serialDriver;
+
+    /// @brief How many times faster than real time to replay, or 0 for no limit
+    double speed;
+
+    /// @brief Next frame to write
+    RecordedFrame pendingFrame;
+
+    /// @brief True if `pendingFrame` holds a frame
+    bool isPending = false;
+
+    /// @brief True once the first update has started the clock
+    bool isStarted = false;
+
+    /// @brief Time of the first update
+    SteadyClock::time_point startTime;
+
+    /// @brief Time the first replayed frame was recorded
+    uint32_t recordingStartTime = 0;
+};
@@ -0,0 +1,500 @@
+/**
+ * Host-side benchmark of the VEXBridge protocol stack.
+ * Runs the robot's `SerialPacketWriter` and `SerialPacketReader` against a `HostPeer` over a loopback pair
+ * or a pseudo-terminal, and reports delivered packets and bytes per second, ACK round-trip percentiles,
+ * and retransmits for several packet mixes and injected byte-error rates.
+ *
+ * Over a loopback pair, everything runs in one thread, so round-trip times measure the protocol stack rather than scheduling.
+ * Over a pseudo-terminal, the host peer runs in its own thread, since the terminal buffer is smaller than
+ * a window of path updates and a blocked write would otherwise wait for itself.
+ * At most `MAX_IN_FLIGHT` packets are unacknowledged at a time. Packets the writer gives up on after its last
+ * retransmit are reported as lost.
+ *
+ * Also measures how long a reconnecting host takes to fetch every label and value with `FETCH_VALUES`.
+ *
+ * Build and run from the `bench` directory:
+ *   make protocolBench && ./build/protocolBench [--pty]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "host/hostPeer.hpp"
+#include "host/ptySerialDriver.hpp"
+#include "vexbridge/serial/drivers/loopbackSerialDriver.hpp"
+#include "vexbridge/serial/serialization/serialPacketWriter.hpp"
+#include "vexbridge/serial/serialization/serialPacketReader.hpp"
+#include "vexbridge/table/labelTable.hpp"
+#include "vexbridge/table/valueTable.hpp"
+
+using namespace vexbridge::serial;
+using Clock = std::chrono::steady_clock;
+
+/// @brief Maximum number of unacknowledged packets. Half of the writer's send window.
+constexpr size_t MAX_IN_FLIGHT = 32;
+
+/// @brief Number of packets sent per scenario
+constexpr uint32_t PACKETS_PER_SCENARIO = 20'000;
+
+/// @brief Maximum duration of a scenario
+constexpr auto MAX_SCENARIO_DURATION = std::chrono::seconds(3);
+
+/// @brief Time after the last send that an unacknowledged packet is assumed to be given up on by the writer
+constexpr auto GIVE_UP_DELAY = std::chrono::milliseconds(250);
+
+/**
+ * Serial driver that watches the frames the robot side sends and receives.
+ * Records when each sequence number is first sent, resends, and the round-trip time to its ACK.
+ */
+class TapSerialDriver : public SerialDriver
+{
+public:
+    TapSerialDriver(std::shared_ptr<SerialDriver> serialDriver)
+        : serialDriver(serialDriver)
+    {
+    }
+
+    bool write(Buffer &buffer) override
+    {
+        return write(std::span<const uint8_t>(buffer));
+    }
+
+    bool write(std::span<const uint8_t> bytes) override
+    {
+        // Each write is one frame
+        Clock::time_point now = Clock::now();
+        outgoingScanner.write(bytes);
+        std::span<const uint8_t> frame;
+        while (outgoingScanner.nextFrame(frame))
+        {
+            // Best-effort frames are never acknowledged
+            if (frame.size() < 4 || (frame[1] & SerialPacketFlag::NO_ACK))
+                continue;
+            uint16_t seq = (frame[2] << 8) | frame[3];
+            auto it = inFlight.find(seq);
+            if (it != inFlight.end())
+            {
+                retransmitCount++;
+                it->second.lastSend = now;
+                it->second.isResent = true;
+            }
+            else
+            {
+                inFlight[seq] = {now, now, false};
+            }
+        }
+        return serialDriver->write(bytes);
+    }
+
+    int32_t getWriteFree() override
+    {
+        return serialDriver->getWriteFree();
+    }
+
+    using SerialDriver::read;
+
+    int32_t read(std::span<uint8_t> output) override
+    {
+        int32_t bytesRead = serialDriver->read(output);
+        if (bytesRead <= 0)
+            return bytesRead;
+
+        // Find the ACKs in the received bytes
+        Clock::time_point now = Clock::now();
+        incomingScanner.write(output.first(bytesRead));
+        std::span<const uint8_t> frame;
+        while (incomingScanner.nextFrame(frame))
+        {
+            if (!isValid(frame))
+                continue;
+            if (frame[0] == (uint8_t)SerialPacketTypeID::RESET)
+                isResetReceived = true;
+            if (frame[0] != (uint8_t)SerialPacketTypeID::GENERIC_ACK)
+                continue;
+
+            uint16_t seq = (frame[2] << 8) | frame[3];
+            auto it = inFlight.find(seq);
+            if (it == inFlight.end())
+                continue;
+
+            // Resent packets are included, measured from the first send
+            roundTripTimes.push_back(std::chrono::duration<double, std::micro>(now - it->second.firstSend).count());
+            ackCount++;
+            inFlight.erase(it);
+        }
+        return bytesRead;
+    }
+
+    SerialDriverStats getStats() const override
+    {
+        return serialDriver->getStats();
+    }
+
+    /**
+     * Forgets packets that were not acknowledged long after they were last sent.
+     * @return The number of packets forgotten.
+     */
+    uint32_t expireGivenUp()
+    {
+        Clock::time_point now = Clock::now();
+        uint32_t expiredCount = 0;
+        for (auto it = inFlight.begin(); it != inFlight.end();)
+        {
+            if (now - it->second.lastSend > GIVE_UP_DELAY)
+            {
+                it = inFlight.erase(it);
+                expiredCount++;
+            }
+            else
+            {
+                it++;
+            }
+        }
+        givenUpCount += expiredCount;
+        return expiredCount;
+    }
+
+    /**
+     * Checks a received frame against every checksum the robot side may have agreed on.
+     * @param frame The unstuffed frame.
+     * @return True if the frame decodes.
+     */
+    static bool isValid(std::span<const uint8_t> frame)
+    {
+        for (ChecksumType checksumType : {ChecksumType::CRC32, ChecksumType::CRC16, ChecksumType::SUM8})
+        {
+            try
+            {
+                SerialPacketDecoder::decodeFrame(frame, checksumType);
+                return true;
+            }
+            catch (std::exception &e)
+            {
+            }
+        }
+        return false;
+    }
+
+    struct InFlightPacket
+    {
+        Clock::time_point firstSend;
+        Clock::time_point lastSend;
+        bool isResent;
+    };
+
+    std::unordered_map<uint16_t, InFlightPacket> inFlight;
+    std::vector<double> roundTripTimes;
+    uint32_t ackCount = 0;
+    uint32_t retransmitCount = 0;
+    uint32_t givenUpCount = 0;
+    bool isResetReceived = false;
+
+private:
+    SerialFrameScanner<65536> outgoingScanner;
+    SerialFrameScanner<65536> incomingScanner;
+    std::shared_ptr<SerialDriver> serialDriver;
+};
+
+/**
+ * Makes the packet to send for a given index.
+ */
+using PacketMix = std::function<std::shared_ptr<SerialPacket>(uint32_t index)>;
+
+/// @brief Number of distinct values each mix updates
+constexpr uint16_t VALUE_COUNT = 100;
+
+template <typename T>
+std::shared_ptr<SerialPacket> makeUpdate(SerialPacketTypeID type, uint16_t valueID, T value)
+{
+    auto packet = makePacket<UpdateValuePacket<T>>();
+    packet->type = type;
+    packet->valueID = valueID;
+    packet->newValue = value;
+    return packet;
+}
+
+/// @brief Float updates only, the most common packet on a robot
+std::shared_ptr<SerialPacket> makeFloatMix(uint32_t index)
+{
+    return makeUpdate<float>(SerialPacketTypeID::UPDATE_FLOAT, index % VALUE_COUNT, index * 0.25f);
+}
+
+/// @brief Every scalar type in turn
+std::shared_ptr<SerialPacket> makeScalarMix(uint32_t index)
+{
+    uint16_t valueID = index % VALUE_COUNT;
+    switch (index % 5)
+    {
+    case 0:
+        return makeUpdate<bool>(SerialPacketTypeID::UPDATE_BOOL, valueID, index % 2);
+    case 1:
+        return makeUpdate<int>(SerialPacketTypeID::UPDATE_INT, valueID, index);
+    case 2:
+        return makeUpdate<float>(SerialPacketTypeID::UPDATE_FLOAT, valueID, index * 0.25f);
+    case 3:
+        return makeUpdate<double>(SerialPacketTypeID::UPDATE_DOUBLE, valueID, index * 0.25);
+    default:
+        return makeUpdate<std::string>(SerialPacketTypeID::UPDATE_STRING, valueID, "state " + std::to_string(index));
+    }
+}
+
+/// @brief 300 point paths, like `VBPath::sync`
+std::shared_ptr<SerialPacket> makePathMix(uint32_t index)
+{
+    std::vector<float> path(300);
+    for (size_t i = 0; i < path.size(); i++)
+        path[i] = index + i * 0.01f;
+    return makeUpdate<std::vector<float>>(SerialPacketTypeID::UPDATE_FLOAT_ARRAY, index % VALUE_COUNT, path);
+}
+
+/**
+ * Results of a single scenario.
+ */
+struct ScenarioResult
+{
+    double packetsPerSecond = 0;
+    double bytesPerSecond = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    uint32_t retransmits = 0;
+    uint32_t givenUp = 0;
+    uint32_t corruptFrames = 0;
+};
+
+/**
+ * Gets a percentile of a sorted list.
+ * @param sorted The sorted list.
+ * @param percentile The percentile from 0 to 1.
+ * @return The value at the percentile or 0 if the list is empty.
+ */
+double getPercentile(const std::vector<double> &sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+    return sorted[std::min(sorted.size() - 1, (size_t)(percentile * sorted.size()))];
+}
+
+/**
+ * Sends a packet mix from the robot side to the host peer and measures delivery.
+ * @param robotDriver The driver of the robot side.
+ * @param hostDriver The driver of the host side.
+ * @param mix The packets to send.
+ * @param isHostThreaded True to run the host peer in its own thread rather than between robot updates.
+ * @return The measurements.
+ */
+ScenarioResult runScenario(std::shared_ptr<SerialDriver> robotDriver, std::shared_ptr<SerialDriver> hostDriver, PacketMix mix, bool isHostThreaded)
+{
+    auto tap = std::make_shared<TapSerialDriver>(robotDriver);
+    auto writer = std::make_shared<SerialPacketWriter>(tap);
+    auto reader = std::make_shared<SerialPacketReader>(tap);
+    writer->setSerialReader(reader);
+    reader->setSerialWriter(writer);
+    HostPeer host(hostDriver);
+
+    // Run the host peer in its own thread if requested
+    std::atomic<bool> isRunning = true;
+    std::thread hostThread;
+    if (isHostThreaded)
+        hostThread = std::thread([&]
+                                 { while (isRunning) { host.update(); std::this_thread::yield(); } });
+
+    auto tick = [&]
+    {
+        if (!isHostThreaded)
+            host.update();
+        reader->readPacketsFromSerial();
+        writer->resendMissingPackets();
+        tap->expireGivenUp();
+    };
+
+    // Agree on a checksum and assign labels, as `SerialSocket` and `VEXBridge::set` would
+    auto resetPacket = makePacket<ResetPacket>();
+    resetPacket->type = SerialPacketTypeID::RESET;
+    resetPacket->supportedChecksums = ResetPacketHandler::SUPPORTED_CHECKSUMS;
+    writer->sendPacket(resetPacket);
+    while (!tap->isResetReceived)
+        tick();
+    tick();
+    for (uint16_t valueID = 0; valueID < VALUE_COUNT; valueID++)
+    {
+        auto assignLabelPacket = makePacket<AssignLabelPacket>();
+        assignLabelPacket->type = SerialPacketTypeID::ASSIGN_LABEL;
+        assignLabelPacket->valueID = valueID;
+        assignLabelPacket->label = "bench/value" + std::to_string(valueID);
+        writer->sendPacket(assignLabelPacket);
+        while (tap->inFlight.size() >= MAX_IN_FLIGHT)
+            tick();
+    }
+    while (!tap->inFlight.empty())
+        tick();
+
+    // Prebuild the packets, so the measurement does not include building them
+    std::vector<std::shared_ptr<SerialPacket>> packets(PACKETS_PER_SCENARIO);
+    for (uint32_t i = 0; i < PACKETS_PER_SCENARIO; i++)
+        packets[i] = mix(i);
+
+    // Send every packet, keeping at most `MAX_IN_FLIGHT` unacknowledged
+    tap->roundTripTimes.clear();
+    tap->ackCount = 0;
+    tap->retransmitCount = 0;
+    tap->givenUpCount = 0;
+    SerialDriverStats startStats = robotDriver->getStats();
+    uint32_t startCorrupt = host.corruptFrameCount;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + MAX_SCENARIO_DURATION;
+    uint32_t sentCount = 0;
+    while ((sentCount < PACKETS_PER_SCENARIO || !tap->inFlight.empty()) && Clock::now() < deadline)
+    {
+        while (sentCount < PACKETS_PER_SCENARIO && tap->inFlight.size() < MAX_IN_FLIGHT)
+            writer->sendPacket(packets[sentCount++]);
+        tick();
+    }
+    double duration = std::chrono::duration<double>(Clock::now() - start).count();
+    isRunning = false;
+    if (hostThread.joinable())
+        hostThread.join();
+
+    // Summarize
+    ScenarioResult result;
+    std::sort(tap->roundTripTimes.begin(), tap->roundTripTimes.end());
+    result.packetsPerSecond = tap->ackCount / duration;
+    result.bytesPerSecond = (robotDriver->getStats().bytesWritten - startStats.bytesWritten) / duration;
+    result.p50 = getPercentile(tap->roundTripTimes, 0.5);
+    result.p90 = getPercentile(tap->roundTripTimes, 0.9);
+    result.p99 = getPercentile(tap->roundTripTimes, 0.99);
+    result.max = tap->roundTripTimes.empty() ? 0 : tap->roundTripTimes.back();
+    result.retransmits = tap->retransmitCount;
+    result.givenUp = tap->givenUpCount + tap->inFlight.size();
+    result.corruptFrames = host.corruptFrameCount - startCorrupt;
+    return result;
+}
+
+/**
+ * Fills the label and value tables and measures how long the host peer takes to fetch all of them.
+ * @param robotDriver The driver of the robot side.
+ * @param hostDriver The driver of the host side.
+ * @param labelCount The number of labels the robot side has. Each has a float value.
+ * @param isHostThreaded True to run the host peer in its own thread rather than between robot updates.
+ * @return The time until every value arrived in milliseconds, or a negative number if it timed out.
+ */
+double runResync(std::shared_ptr<SerialDriver> robotDriver, std::shared_ptr<SerialDriver> hostDriver, uint16_t labelCount, bool isHostThreaded)
+{
+    auto writer = std::make_shared<SerialPacketWriter>(robotDriver);
+    auto reader = std::make_shared<SerialPacketReader>(robotDriver);
+    writer->setSerialReader(reader);
+    reader->setSerialWriter(writer);
+    HostPeer host(hostDriver);
+
+    // Labels are only added, so earlier runs share the first labels
+    for (uint16_t i = 0; i < labelCount; i++)
+    {
+        bool isCreated = false;
+        uint16_t valueID = LabelTable::getOrCreate("bench/resync/value" + std::to_string(i), isCreated);
+        ValueTable::set(valueID, i * 0.25f);
+    }
+    uint32_t expectedCount = LabelTable::getAll().size();
+
+    // Run the host peer in its own thread if requested
+    std::atomic<bool> isRunning = true;
+    std::thread hostThread;
+    if (isHostThreaded)
+        hostThread = std::thread([&]
+                                 { while (isRunning) { host.update(); std::this_thread::yield(); } });
+
+    // Fetch every value and wait for all of them
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + MAX_SCENARIO_DURATION;
+    host.fetchValues();
+    while (host.valueUpdateCount < expectedCount && Clock::now() < deadline)
+    {
+        if (!isHostThreaded)
+            host.update();
+        reader->readPacketsFromSerial();
+        writer->resendMissingPackets();
+    }
+    Clock::time_point end = Clock::now();
+    isRunning = false;
+    if (hostThread.joinable())
+        hostThread.join();
+
+    if (host.valueUpdateCount < expectedCount)
+        return -1;
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    bool isPty = argc > 1 && strcmp(argv[1], "--pty") == 0;
+
+    struct NamedMix
+    {
+        const char *name;
+        PacketMix mix;
+    };
+    std::vector<NamedMix> mixes = {
+        {"float", makeFloatMix},
+        {"scalar", makeScalarMix},
+        {"path", makePathMix},
+    };
+    std::vector<double> errorRates = {0, 1e-5, 1e-4, 1e-3};
+    if (isPty)
+        errorRates = {0};
+
+    printf("%s, %u packets per scenario, %zu in flight\n", isPty ? "pty" : "loopback", PACKETS_PER_SCENARIO, MAX_IN_FLIGHT);
+    printf("%-8s %8s %12s %12s %9s %9s %9s %9s %8s %8s %8s\n",
+           "mix", "errors", "packets/s", "bytes/s", "p50 us", "p90 us", "p99 us", "max us", "resent", "lost", "corrupt");
+
+    // Connects a robot side to a host side
+    std::shared_ptr<SerialDriver> robotDriver;
+    std::shared_ptr<SerialDriver> hostDriver;
+    auto connect = [&](double errorRate)
+    {
+        if (isPty)
+        {
+            auto ptyDriver = std::make_shared<PtySerialDriver>();
+            hostDriver = std::make_shared<PtySerialDriver>(ptyDriver->getDevicePath());
+            robotDriver = ptyDriver;
+        }
+        else
+        {
+            // Corrupt both directions, so ACKs are lost too
+            auto [loopbackRobot, loopbackHost] = LoopbackSerialDriver::makePair();
+            loopbackRobot->setErrorRate(errorRate, 1);
+            loopbackHost->setErrorRate(errorRate, 2);
+            robotDriver = loopbackRobot;
+            hostDriver = loopbackHost;
+        }
+    };
+
+    for (NamedMix &mix : mixes)
+    {
+        for (double errorRate : errorRates)
+        {
+            connect(errorRate);
+
+            ScenarioResult result = runScenario(robotDriver, hostDriver, mix.mix, isPty);
+            printf("%-8s %8.0e %12.0f %12.0f %9.1f %9.1f %9.1f %9.1f %8u %8u %8u\n",
+                   mix.name, errorRate, result.packetsPerSecond, result.bytesPerSecond,
+                   result.p50, result.p90, result.p99, result.max,
+                   result.retransmits, result.givenUp, result.corruptFrames);
+            fflush(stdout);
+        }
+    }
+
+    printf("\n%-8s %12s\n", "labels", "resync ms");
+    for (uint16_t labelCount : {10, 100, 1000})
+    {
+        connect(0);
+        double duration = runResync(robotDriver, hostDriver, labelCount, isPty);
+        printf("%-8u %12.2f\n", labelCount, duration);
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * Host-side benchmark of `RadioSerialDriver` over a `SimulatedRadioLink` pair.
+ * The robot side streams best-effort float telemetry to a `HostPeer`, as a robot would over VEXlink,
+ * and reports the updates delivered per second and what they cost on the air.
+ * Compares the driver to writing each frame as its own link packet, as the driver did before,
+ * for several MTUs, with and without compression, and with lost link packets.
+ *
+ * Each scenario runs in real time, since the simulated link models bandwidth with the clock.
+ *
+ * Build and run from the `bench` directory:
+ *   make radioBench && ./build/radioBench
+ */
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "host/hostPeer.hpp"
+#include "vexbridge/serial/drivers/radioSerialDriver.hpp"
+#include "vexbridge/serial/drivers/simulatedRadioLink.hpp"
+#include "vexbridge/serial/serialization/serialPacketWriter.hpp"
+#include "vexbridge/serial/serialization/serialPacketReader.hpp"
+
+using namespace vexbridge::serial;
+using Clock = std::chrono::steady_clock;
+
+/// @brief Duration of each scenario
+constexpr auto SCENARIO_DURATION = std::chrono::seconds(1);
+
+/// @brief Time between bursts of telemetry, like a 100 Hz control loop
+constexpr auto BURST_INTERVAL = std::chrono::milliseconds(10);
+
+/// @brief Number of values updated in each burst
+constexpr uint16_t VALUE_COUNT = 20;
+
+/**
+ * The previous radio driver, kept for comparison.
+ * Writes each frame as its own link packet and reads the link as a plain byte stream.
+ */
+class FramePerPacketDriver : public SerialDriver
+{
+public:
+    FramePerPacketDriver(std::shared_ptr<RadioLink> link)
+        : link(link)
+    {
+    }
+
+    bool write(Buffer &buffer) override
+    {
+        return write(std::span<const uint8_t>(buffer));
+    }
+
+    bool write(std::span<const uint8_t> bytes) override
+    {
+        return link->transmit(bytes);
+    }
+
+    using SerialDriver::read;
+
+    int32_t read(std::span<uint8_t> output) override
+    {
+        return link->receive(output);
+    }
+
+    int32_t getWriteFree() override
+    {
+        return link->getTransmitFree();
+    }
+
+private:
+    std::shared_ptr<RadioLink> link;
+};
+
+/**
+ * How a scenario sends frames over the link.
+ */
+struct Transport
+{
+    const char *name;
+
+    /// @brief True to use `RadioSerialDriver`, false to use `FramePerPacketDriver`
+    bool isPacked;
+
+    /// @brief Options of `RadioSerialDriver`
+    RadioOptions options;
+};
+
+/**
+ * Results of a single scenario.
+ */
+struct ScenarioResult
+{
+    double updatesPerSecond = 0;
+    double linkBytesPerSecond = 0;
+    double linkPacketsPerSecond = 0;
+    double linkBytesPerUpdate = 0;
+    uint32_t packetsLost = 0;
+};
+
+/**
+ * Creates the driver of one side of the link.
+ * @param link The link of the side.
+ * @param transport How frames are sent.
+ * @return The driver.
+ */
+std::shared_ptr<SerialDriver> makeDriver(std::shared_ptr<RadioLink> link, const Transport &transport)
+{
+    if (transport.isPacked)
+        return std::make_shared<RadioSerialDriver>(link, transport.options);
+    return std::make_shared<FramePerPacketDriver>(link);
+}
+
+/**
+ * Streams telemetry from the robot side to the host peer and measures delivery.
+ * @param transport How frames are sent.
+ * @param linkOptions How the simulated link behaves.
+ * @return The measurements.
+ */
+ScenarioResult runScenario(const Transport &transport, const SimulatedRadioOptions &linkOptions)
+{
+    auto [robotLink, hostLink] = SimulatedRadioLink::makePair(linkOptions);
+    auto robotDriver = makeDriver(robotLink, transport);
+    auto writer = std::make_shared<SerialPacketWriter>(robotDriver);
+    auto reader = std::make_shared<SerialPacketReader>(robotDriver);
+    writer->setSerialReader(reader);
+    reader->setSerialWriter(writer);
+    HostPeer host(makeDriver(hostLink, transport));
+
+    auto tick = [&]
+    {
+        host.update();
+        reader->readPacketsFromSerial();
+        writer->resendMissingPackets();
+        writer->writeLatestPackets();
+    };
+
+    // Agree on a checksum, as `SerialSocket` would
+    auto resetPacket = makePacket<ResetPacket>();
+    resetPacket->type = SerialPacketTypeID::RESET;
+    resetPacket->supportedChecksums = ResetPacketHandler::SUPPORTED_CHECKSUMS;
+    writer->sendPacket(resetPacket);
+    Clock::time_point handshakeEnd = Clock::now() + std::chrono::milliseconds(200);
+    while (Clock::now() < handshakeEnd)
+        tick();
+
+    // Stream bursts of telemetry
+    SimulatedRadioStats startStats = robotLink->getStats();
+    uint32_t startUpdates = host.valueUpdateCount;
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + SCENARIO_DURATION;
+    Clock::time_point nextBurst = start;
+    uint32_t burstCount = 0;
+    while (Clock::now() < end)
+    {
+        if (Clock::now() >= nextBurst)
+        {
+            for (uint16_t valueID = 0; valueID < VALUE_COUNT; valueID++)
+            {
+                auto packet = makePacket<UpdateValuePacket<float>>();
+                packet->type = SerialPacketTypeID::UPDATE_FLOAT;
+                packet->valueID = valueID;
+                packet->newValue = burstCount * 0.25f + valueID;
+                writer->sendLatest(valueID, packet);
+            }
+            burstCount++;
+            nextBurst += BURST_INTERVAL;
+        }
+        tick();
+    }
+    double duration = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Summarize
+    SimulatedRadioStats stats = robotLink->getStats();
+    uint32_t updateCount = host.valueUpdateCount - startUpdates;
+    ScenarioResult result;
+    result.updatesPerSecond = updateCount / duration;
+    result.linkBytesPerSecond = (stats.bytesSent - startStats.bytesSent) / duration;
+    result.linkPacketsPerSecond = (stats.packetsSent - startStats.packetsSent) / duration;
+    result.linkBytesPerUpdate = updateCount == 0 ? 0 : (double)(stats.bytesSent - startStats.bytesSent) / updateCount;
+    result.packetsLost = stats.packetsLost - startStats.packetsLost;
+    return result;
+}
+
+int main()
+{
+    std::vector<Transport> transports = {
+        {"frame/packet", false, {}},
+        {"mtu 64", true, {64, false}},
+        {"mtu 128", true, {128, false}},
+        {"mtu 128 lz", true, {128, true}},
+    };
+    std::vector<double> lossRates = {0, 0.05};
+
+    SimulatedRadioOptions linkOptions;
+    printf("simulated link: %u bytes/s, %u ms latency, %zu byte transmit buffer\n",
+           linkOptions.bandwidth, linkOptions.latency, linkOptions.transmitBufferSize);
+    printf("offered: %u float updates every %lld ms\n", VALUE_COUNT, (long long)BURST_INTERVAL.count());
+    printf("%-14s %6s %10s %12s %12s %12s %8s\n",
+           "transport", "loss", "updates/s", "link B/s", "packets/s", "B/update", "lost");
+
+    for (Transport &transport : transports)
+    {
+        for (double lossRate : lossRates)
+        {
+            linkOptions.lossRate = lossRate;
+            ScenarioResult result = runScenario(transport, linkOptions);
+            printf("%-14s %6.2f %10.0f %12.0f %12.0f %12.2f %8u\n",
+                   transport.name, lossRate, result.updatesPerSecond, result.linkBytesPerSecond,
+                   result.linkPacketsPerSecond, result.linkBytesPerUpdate, result.packetsLost);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
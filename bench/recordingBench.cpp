@@ -0,0 +1,193 @@
+/**
+ * Host-side benchmark of SD card recording.
+ * Runs the robot's `SerialSocket` with a `FrameRecorder` and no host attached, as in a match,
+ * and reports how long recording adds to each write and how many frames were dropped.
+ * Then replays the recording into a passive `HostPeer` as fast as it takes frames, checks that every value
+ * arrived, and times seeking to the middle of the recording.
+ *
+ * The recording is written to a temporary directory rather than an SD card, so file writes are faster than on the V5.
+ *
+ * Build and run from the `bench` directory:
+ *   make recordingBench && ./build/recordingBench
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+#include <unistd.h>
+#include "host/hostPeer.hpp"
+#include "host/recordingReader.hpp"
+#include "vexbridge/serial/drivers/loopbackSerialDriver.hpp"
+#include "vexbridge/serial/recording/frameRecorder.hpp"
+#include "vexbridge/serial/serialSocket.hpp"
+#include "vexbridge/serial/serialWriter.hpp"
+
+using namespace vexbridge::serial;
+using Clock = std::chrono::steady_clock;
+
+/// @brief Number of values updated every control loop
+constexpr uint16_t VALUE_COUNT = 50;
+
+/// @brief Time between control loops in milliseconds
+constexpr uint32_t LOOP_INTERVAL = 10;
+
+/// @brief Duration of the recorded run in milliseconds
+constexpr uint32_t RUN_DURATION = 3000;
+
+/// @brief Number of frames written directly to the recorder when measuring its overhead
+constexpr uint32_t OVERHEAD_FRAME_COUNT = 20'000;
+
+/**
+ * Serial driver of a port with no host attached. Accepts every write and never has anything to read.
+ * Reports no free space, like the V5's USB port when no dashboard drains it.
+ */
+class DisconnectedSerialDriver : public SerialDriver
+{
+public:
+    bool write(Buffer &) override
+    {
+        return true;
+    }
+
+    bool write(std::span<const uint8_t>) override
+    {
+        return true;
+    }
+
+    using SerialDriver::read;
+
+    int32_t read(std::span<uint8_t>) override
+    {
+        return 0;
+    }
+
+    int32_t getWriteFree() override
+    {
+        return 0;
+    }
+};
+
+/**
+ * Gets a percentile of a sorted list.
+ * @param sorted The sorted list.
+ * @param percentile The percentile from 0 to 1.
+ * @return The value at the percentile or 0 if the list is empty.
+ */
+double getPercentile(const std::vector<double> &sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+    return sorted[std::min(sorted.size() - 1, (size_t)(percentile * sorted.size()))];
+}
+
+/**
+ * Measures how long `FrameRecorder::record` takes for a typical value update frame.
+ * @param directory The directory to record to.
+ */
+void measureOverhead(const std::string &directory)
+{
+    // Daemon tasks run until the program ends, so the recorder is never freed
+    FrameRecorder &recorder = *new FrameRecorder(directory);
+    std::vector<uint8_t> frame(24, 0x5A);
+    std::vector<double> durations;
+    durations.reserve(OVERHEAD_FRAME_COUNT);
+
+    // Pace the frames at a busy link's rate, so the recorder's task can keep up as it would on the V5
+    auto startTime = Clock::now();
+    for (uint32_t i = 0; i < OVERHEAD_FRAME_COUNT; i++)
+    {
+        auto writeTime = Clock::now();
+        recorder.record(frame);
+        durations.push_back(std::chrono::duration<double, std::micro>(Clock::now() - writeTime).count());
+        if (i % 100 == 99)
+            pros::delay(1);
+    }
+    double duration = std::chrono::duration<double>(Clock::now() - startTime).count();
+    std::sort(durations.begin(), durations.end());
+
+    printf("%-10s %12s %9s %9s %9s %9s\n", "frames", "frames/s", "p50 us", "p99 us", "max us", "dropped");
+    printf("%-10u %12.0f %9.2f %9.2f %9.2f %9u\n", OVERHEAD_FRAME_COUNT, OVERHEAD_FRAME_COUNT / duration,
+           getPercentile(durations, 0.5), getPercentile(durations, 0.99), durations.back(), recorder.getDroppedCount());
+}
+
+/**
+ * Records a run of the protocol stack with no host attached.
+ * @param directory The directory to record to.
+ * @return The path of the recording.
+ */
+std::string recordRun(const std::string &directory)
+{
+    // Daemon tasks run until the program ends, so the socket is never freed
+    auto recorder = std::make_shared<FrameRecorder>(directory);
+    new SerialSocket(std::make_shared<DisconnectedSerialDriver>(), FramingType::BYTE_STUFFING, recorder);
+
+    // Update every value each control loop, like a robot publishing its state
+    // Odd values are best-effort, which are recorded even though the port never has room for them
+    for (uint16_t valueID = 0; valueID < VALUE_COUNT; valueID++)
+    {
+        SerialWriter::assignLabel(valueID, "bench/value" + std::to_string(valueID));
+        SerialWriter::setQoS(valueID, valueID % 2 == 0 ? QoS::RELIABLE : QoS::BEST_EFFORT);
+    }
+    uint32_t startTime = pros::millis();
+    for (uint32_t loop = 0; pros::millis() - startTime < RUN_DURATION; loop++)
+    {
+        for (uint16_t valueID = 0; valueID < VALUE_COUNT; valueID++)
+            SerialWriter::updateDouble(valueID, loop + valueID / 1000.0);
+        pros::delay(LOOP_INTERVAL);
+    }
+
+    // Wait for the last block to be written
+    pros::delay(1500);
+    printf("\nrecorded %u bytes to %s, %u frames dropped\n", recorder->getBytesRecorded(), recorder->getPath().c_str(), recorder->getDroppedCount());
+    return recorder->getPath();
+}
+
+/**
+ * Replays a recording into a passive host peer as fast as it takes frames.
+ * @param path The path of the recording.
+ */
+void replayRun(const std::string &path)
+{
+    RecordingReader reader(path);
+    auto [replayDriver, hostDriver] = LoopbackSerialDriver::makePair();
+    HostPeer host(hostDriver, reader.getFramingType());
+    host.setPassive(true);
+    host.setChecksumType(reader.getChecksumType());
+
+    // Replay as fast as the host peer reads
+    RecordingReplayer replayer(reader, replayDriver, 0);
+    auto startTime = Clock::now();
+    while (replayer.update())
+        host.update();
+    host.update();
+    double duration = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+    uint16_t lastValueID = VALUE_COUNT - 1;
+    printf("\n%-10s %12s %9s %9s %12s\n", "frames", "frames/s", "labels", "updates", "last value");
+    printf("%-10u %12.0f %9zu %9u %12.3f\n", replayer.framesWritten, replayer.framesWritten / duration,
+           host.getLabelCount(), host.valueUpdateCount.load(), host.getNumber(lastValueID));
+
+    // Seek to the middle of the run
+    uint32_t middleTime = reader.getStartTime() + RUN_DURATION / 2;
+    auto seekTime = Clock::now();
+    reader.seek(middleTime);
+    double seekDuration = std::chrono::duration<double, std::micro>(Clock::now() - seekTime).count();
+    RecordedFrame frame;
+    bool isFound = reader.next(frame);
+    printf("\nseek to %u ms in %zu blocks: %.1f us, found frame at %u ms\n", middleTime, reader.getBlockCount(), seekDuration, isFound ? frame.timestamp : 0);
+}
+
+int main()
+{
+    char directoryTemplate[] = "/tmp/recordingBenchXXXXXX";
+    std::string directory = mkdtemp(directoryTemplate);
+
+    measureOverhead(directory);
+    std::string path = recordRun(directory);
+    replayRun(path);
+
+    // Remove the recordings
+    std::string command = "rm -rf " + directory;
+    return system(command.c_str());
+}
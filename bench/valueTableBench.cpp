@@ -0,0 +1,155 @@
+/**
+ * Host-side benchmark comparing `ValueTable` to the `std::map<uint16_t, std::any>` table it replaced.
+ * Runs the same calls `VEXBridge::getByID` and `VEXBridge::setByID` make, on a table the size of a typical robot:
+ * a few hundred scalars plus a synced path.
+ * Writes do not read the clock unless capture times are enabled, which the stamped row measures.
+ *
+ * Build and run from the repository root:
+ *   g++ -O2 -std=gnu++20 -Iinclude -Ibench bench/valueTableBench.cpp bench/host/prosShim.cpp -o valueTableBench -lpthread && ./valueTableBench
+ */
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <map>
+#include <any>
+#include <vector>
+#include "vexbridge/table/valueTable.hpp"
+
+using namespace vexbridge::table;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The previous value table, kept for comparison.
+ */
+struct MapValueTable
+{
+    template <typename T>
+    static void set(const uint16_t id, const T value)
+    {
+        idToPath[id] = value;
+    }
+
+    static bool contains(const uint16_t id)
+    {
+        return idToPath.find(id) != idToPath.end();
+    }
+
+    template <typename T>
+    static bool isType(const uint16_t id)
+    {
+        if (!contains(id))
+            return false;
+        return idToPath.at(id).type() == typeid(T);
+    }
+
+    template <typename T>
+    static T get(const uint16_t id)
+    {
+        return std::any_cast<T>(idToPath.at(id));
+    }
+
+    /// @brief `VEXBridge::getByID` before the dense table
+    template <typename T>
+    static T getByID(const uint16_t id, const T defaultValue)
+    {
+        if (!isType<T>(id))
+            throw std::runtime_error("Type mismatch");
+        if (!contains(id))
+            return defaultValue;
+        return get<T>(id);
+    }
+
+    /// @brief `VEXBridge::setByID` before the dense table, without sending
+    template <typename T>
+    static bool setByID(const uint16_t id, const T value)
+    {
+        if (contains(id) && get<T>(id) == value)
+            return false;
+        set(id, value);
+        return true;
+    }
+
+    static inline std::map<uint16_t, std::any> idToPath;
+};
+
+/// @brief Prevents the compiler from removing unused reads
+volatile double sink = 0;
+
+/**
+ * Measures the time per call of a function.
+ * @param iterations The number of calls.
+ * @param function The function to call with the iteration index.
+ * @return The time per call in nanoseconds.
+ */
+template <typename F>
+double measure(size_t iterations, F function)
+{
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++)
+        function(i);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+}
+
+int main()
+{
+    constexpr uint16_t VALUE_COUNT = 300;
+    constexpr uint16_t ID_OFFSET = 100;
+    constexpr uint16_t PATH_ID = ID_OFFSET + VALUE_COUNT;
+    constexpr size_t ITERATIONS = 4'000'000;
+    constexpr size_t PATH_ITERATIONS = 100'000;
+
+    // Fill both tables
+    std::vector<float> path(300);
+    for (uint16_t i = 0; i < VALUE_COUNT; i++)
+    {
+        ValueTable::set<float>(ID_OFFSET + i, i);
+        MapValueTable::set<float>(ID_OFFSET + i, i);
+    }
+    ValueTable::set(PATH_ID, path);
+    MapValueTable::set(PATH_ID, path);
+
+    printf("%-22s %12s %12s\n", "ns per call", "map + any", "dense");
+
+    // Scalar reads
+    double mapGet = measure(ITERATIONS, [](size_t i)
+                            { sink = sink + MapValueTable::getByID<float>(ID_OFFSET + i % VALUE_COUNT, 0); });
+    double denseGet = measure(ITERATIONS, [](size_t i)
+                              { sink = sink + ValueTable::get<float>(ID_OFFSET + i % VALUE_COUNT, 0); });
+    printf("%-22s %12.1f %12.1f\n", "get float", mapGet, denseGet);
+
+    // Scalar writes that change the value
+    double mapSet = measure(ITERATIONS, [](size_t i)
+                            { sink = sink + MapValueTable::setByID<float>(ID_OFFSET + i % VALUE_COUNT, i); });
+    double denseSet = measure(ITERATIONS, [](size_t i)
+                              { sink = sink + ValueTable::set<float>(ID_OFFSET + i % VALUE_COUNT, i); });
+    printf("%-22s %12.1f %12.1f\n", "set float (changed)", mapSet, denseSet);
+
+    // Scalar writes of the same value, skipped by `setByID`
+    double mapSetSame = measure(ITERATIONS, [](size_t i)
+                                { sink = sink + MapValueTable::setByID<float>(ID_OFFSET + i % VALUE_COUNT, 1); });
+    double denseSetSame = measure(ITERATIONS, [](size_t i)
+                                  { sink = sink + ValueTable::set<float>(ID_OFFSET + i % VALUE_COUNT, 1); });
+    printf("%-22s %12.1f %12.1f\n", "set float (unchanged)", mapSetSame, denseSetSame);
+
+    // Scalar writes that also read the clock, as with `VEXBridge::enableTimestamps`
+    ValueTable::setCaptureTimed(true);
+    double denseSetStamped = measure(ITERATIONS, [](size_t i)
+                                     { sink = sink + ValueTable::set<float>(ID_OFFSET + i % VALUE_COUNT, i); });
+    ValueTable::setCaptureTimed(false);
+    printf("%-22s %12s %12.1f\n", "set float (stamped)", "-", denseSetStamped);
+
+    // Path writes
+    double mapSetPath = measure(PATH_ITERATIONS, [&](size_t i)
+                                { path[i % path.size()] = i; sink = sink + MapValueTable::setByID(PATH_ID, path); });
+    double denseSetPath = measure(PATH_ITERATIONS, [&](size_t i)
+                                  { path[i % path.size()] = i; sink = sink + ValueTable::set(PATH_ID, path); });
+    printf("%-22s %12.1f %12.1f\n", "set 300 float path", mapSetPath, denseSetPath);
+
+    // Path reads
+    double mapGetPath = measure(PATH_ITERATIONS, [](size_t i)
+                                { sink = sink + MapValueTable::getByID<std::vector<float>>(PATH_ID, {})[i % 300]; });
+    double denseGetPath = measure(PATH_ITERATIONS, [](size_t i)
+                                  { sink = sink + ValueTable::get<std::vector<float>>(PATH_ID, {})[i % 300]; });
+    printf("%-22s %12.1f %12.1f\n", "get 300 float path", mapGetPath, denseGetPath);
+    return 0;
+}
@@ -62,7 +62,7 @@ namespace devils
         void moveAutomatic(double targetSpeed = 1.0)
         {
             // DEBUG
-            VEXBridge::set("position", conveyorChain.getPosition());
+            positionLabel.set(conveyorChain.getPosition());
 
             // Current State
             RingType currentRing = getCurrentRing();
@@ -395,5 +395,8 @@ namespace devils
         SmartMotorGroup &conveyorMotors;
         OpticalSensor *sensor = nullptr;
         ChainLoop conveyorChain;
+
+        // Debug
+        VBLabel positionLabel = VBLabel("position");
     };
 }
\ No newline at end of file
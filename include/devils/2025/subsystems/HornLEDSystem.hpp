@@ -19,6 +19,7 @@ namespace devils
             : leftLED(leftLED),
               rightLED(rightLED)
         {
+            start();
         }
 
         /**
@@ -144,7 +144,7 @@ namespace devils
 
             // Create a new path
             SplinePath path = SplinePath::makeArc(fromPose, toPose, strength, isReversed);
-            VBPath::sync("AutoBuilderPath", path);
+            autoBuilderPath.sync(path);
 
             // Flip final velocity if the path is reversed
             if (isReversed)
@@ -311,5 +311,8 @@ namespace devils
         // Input references
         ChassisBase &chassis;
         OdomSource &odom;
+
+        /// @brief Syncs each generated path to VEXBridge
+        VBPath autoBuilderPath = VBPath("AutoBuilderPath");
     };
 }
\ No newline at end of file
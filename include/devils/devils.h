@@ -24,7 +24,7 @@
 #include "hardware/chainLoop.hpp"
 #include "hardware/symmetricControl.hpp"
 #include "hardware/led.hpp"
-// #include "hardware/devilCV.hpp"
+#include "hardware/devilCV.hpp"
 
 // Odom
 #include "odom/odomSource.hpp"
@@ -89,5 +89,6 @@
 
 // VEXBridge
 #include "../vexbridge/vexbridge.h"
+#include "vexbridge/vbPoseRecord.hpp"
 #include "vexbridge/vbOdom.hpp"
 #include "vexbridge/vbPath.hpp"
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
-#include "vexbridge/vexBridge.h"
+#include "vexbridge/vexbridge.h"
+#include "vexbridge/table/visionFrameTable.hpp"
 #include "structs/camera.h"
 
 namespace devils
@@ -7,6 +8,7 @@ namespace devils
     /**
      * Represents an offboard Raspberry Pi running OpenCV.
      * Data is sent over the network using VEX Bridge.
+     * Each camera frame arrives as a single vision frame packet, so every target comes from the same frame.
      */
     class DevilCV : public ICamera
     {
@@ -24,28 +26,77 @@ namespace devils
 
         bool hasTargets() override
         {
-            return hasTarget->get();
+            return !getFrame().targets.empty();
         }
 
         ICamera::VisionObject getClosestTarget() override
         {
-            return ICamera::VisionObject{targetX->get(), targetY->get()};
+            ICamera::VisionFrame frame = getFrame();
+            const ICamera::VisionObject *target = frame.getLargestTarget();
+            return target ? *target : ICamera::VisionObject{0, 0};
+        }
+
+        ICamera::VisionFrame getFrame() override
+        {
+            // Copy the latest frame whole
+            vexbridge::table::VisionFrame tableFrame;
+            ICamera::VisionFrame frame;
+            if (!VisionFrameTable::get(frameID, tableFrame))
+                return frame;
+
+            frame.frameNumber = tableFrame.frameNumber;
+            frame.captureTime = tableFrame.captureTime;
+            frame.isCaptureTimeMeasured = true;
+            frame.targets.reserve(tableFrame.targets.size());
+            for (const vexbridge::table::VisionTarget &target : tableFrame.targets)
+                frame.targets.push_back(ICamera::VisionObject{
+                    target.x,
+                    target.y,
+                    target.width,
+                    target.height,
+                    target.confidence,
+                    target.classID});
+            return frame;
+        }
+
+        /**
+         * Waits for the coprocessor to send a new frame.
+         * Wakes as soon as the serial daemon receives the frame, rather than a control period later.
+         * Uses the notifications of the calling task, so another notification of the task also ends the wait.
+         * @param timeout The maximum time to wait in milliseconds.
+         * @return True if a frame arrived, false if the wait timed out.
+         */
+        bool waitForFrame(uint32_t timeout)
+        {
+            uint32_t handle = VEXBridge::notifyOnChangeByID(frameID, pros::Task::current());
+            bool isReceived = pros::Task::notify_take(true, timeout) > 0;
+            VEXBridge::unsubscribe(handle);
+            return isReceived;
+        }
+
+        /**
+         * Calls a function each time the coprocessor sends a frame.
+         * The function runs on the serial daemon, so it should be short, such as notifying a task.
+         * @param callback The function to call.
+         * @return A handle to pass to `VEXBridge::unsubscribe`.
+         */
+        uint32_t subscribe(ValueSubscriptions::Callback callback)
+        {
+            return VEXBridge::subscribeByID(frameID, std::move(callback));
         }
 
         /**
          * Sets the camera name for the VEX Bridge.
+         * The coprocessor sends the frames of the camera to `vision/<name>/frame`.
          * @param name The name of the camera
          */
         void setCameraName(std::string name)
         {
-            targetX = std::make_unique<VBValue<float>>("vision/color/" + name + "/center_x", 0.0f);
-            targetY = std::make_unique<VBValue<float>>("vision/color/" + name + "/center_y", 0.0f);
-            hasTarget = std::make_unique<VBValue<bool>>("vision/color/" + name + "/has_target", false);
+            frameID = VEXBridge::getOrAssignID("vision/" + name + "/frame");
         }
 
     private:
-        std::unique_ptr<VBValue<float>> targetX = std::make_unique<VBValue<float>>(nullptr);
-        std::unique_ptr<VBValue<float>> targetY = std::make_unique<VBValue<float>>(nullptr);
-        std::unique_ptr<VBValue<bool>> hasTarget = std::make_unique<VBValue<bool>>(nullptr);
+        /// @brief The ID that frames of the camera are sent to
+        uint16_t frameID = 0;
     };
-}
\ No newline at end of file
+}
@@ -75,7 +75,39 @@ namespace devils
                 (double)object.y_middle_coord / VISION_HEIGHT_PX};
         }
 
+        ICamera::VisionFrame getFrame() override
+        {
+            // Read every object in a single call, so they all come from the same frame
+            pros::vision_object_s_t objects[MAX_OBJECT_COUNT];
+            int32_t objectCount = sensor.read_by_size(0, MAX_OBJECT_COUNT, objects);
+
+            // The sensor does not number its frames, so each read is a new frame
+            ICamera::VisionFrame frame;
+            frame.captureTime = pros::millis();
+            frame.frameNumber = frame.captureTime;
+            if (objectCount == PROS_ERR)
+                return frame;
+
+            // Objects that were not found are marked with an error signature
+            for (int32_t i = 0; i < objectCount; i++)
+            {
+                if (objects[i].signature == VISION_OBJECT_ERR_SIG)
+                    break;
+                frame.targets.push_back(ICamera::VisionObject{
+                    (double)objects[i].x_middle_coord / VISION_WIDTH_PX,
+                    (double)objects[i].y_middle_coord / VISION_HEIGHT_PX,
+                    (double)objects[i].width / VISION_WIDTH_PX,
+                    (double)objects[i].height / VISION_HEIGHT_PX,
+                    1,
+                    (uint8_t)objects[i].signature});
+            }
+            return frame;
+        }
+
     private:
+        /// @brief Maximum number of objects read from a frame
+        static constexpr uint32_t MAX_OBJECT_COUNT = 8;
+
         pros::Vision sensor;
     };
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "pros/rtos.hpp"
 
 namespace devils
 {
@@ -17,6 +20,51 @@ namespace devils
 
             /// @brief The y position of the object measured in the camera's frame. Represented as a percentage of the camera's height from -1 to 1.
             double y;
+
+            /// @brief The width of the object as a percentage of the camera's width from 0 to 1. 0 if unknown.
+            double width = 0;
+
+            /// @brief The height of the object as a percentage of the camera's height from 0 to 1. 0 if unknown.
+            double height = 0;
+
+            /// @brief The confidence of the detection from 0 to 1.
+            double confidence = 1;
+
+            /// @brief The class of the object, defined by the vision pipeline.
+            uint8_t classID = 0;
+        };
+
+        /// @brief Represents every object detected in a single camera frame.
+        struct VisionFrame
+        {
+            /// @brief The number of the frame. Changes each time a new frame is captured.
+            uint32_t frameNumber = 0;
+
+            /// @brief The time the frame was captured in milliseconds since the program started.
+            /// Only an estimate unless `isCaptureTimeMeasured` is true.
+            uint32_t captureTime = 0;
+
+            /// @brief True if the camera measured when the frame was captured, false if `captureTime` is when it was read.
+            bool isCaptureTimeMeasured = false;
+
+            /// @brief The objects detected in the frame.
+            std::vector<VisionObject> targets;
+
+            /**
+             * Gets the largest object in the frame, which is assumed to be the closest.
+             * Objects of unknown size count as equal, so the first is returned.
+             * @return The largest object or nullptr if the frame has no objects.
+             */
+            const VisionObject *getLargestTarget() const
+            {
+                if (targets.empty())
+                    return nullptr;
+                return &*std::max_element(
+                    targets.begin(),
+                    targets.end(),
+                    [](const VisionObject &a, const VisionObject &b)
+                    { return a.width * a.height < b.width * b.height; });
+            }
         };
 
         /**
@@ -30,5 +78,21 @@ namespace devils
          * @return True if the camera has detected any targets, false otherwise.
          */
         virtual bool hasTargets() = 0;
+
+        /**
+         * Gets every object detected in the latest frame.
+         * All objects come from the same frame, unlike separate calls to `hasTargets` and `getClosestTarget`.
+         * Defaults to a frame holding the closest target, captured now.
+         * @return The latest frame.
+         */
+        virtual VisionFrame getFrame()
+        {
+            VisionFrame frame;
+            frame.captureTime = pros::millis();
+            frame.frameNumber = frame.captureTime;
+            if (hasTargets())
+                frame.targets.push_back(getClosestTarget());
+            return frame;
+        }
     };
-}
\ No newline at end of file
+}
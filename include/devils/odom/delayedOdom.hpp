@@ -3,7 +3,7 @@
 #include "odomSource.hpp"
 #include "../utils/runnable.hpp"
 #include "pros/rtos.hpp"
-#include <queue>
+#include <deque>
 #include <algorithm>
 
 namespace devils
@@ -11,6 +11,7 @@ namespace devils
     /**
      * Delays the output pose of an odometry source by a specified amount of time.
      * Used for latency compensation in vision-based odometry.
+     * Keeps a timestamped history, so the pose at a measured capture time can be looked up with `getPoseAt`.
      */
     class DelayedOdom : public OdomSource, public Runnable
     {
@@ -19,12 +20,15 @@ namespace devils
          * Constructs a new delayed odometry source.
          * @param baseOdom The base odometry source to use
          * @param delay The delay in milliseconds
+         * @param history The duration of history to keep for `getPoseAt` in milliseconds. At least `delay`.
          */
         DelayedOdom(
             OdomSource &baseOdom,
-            double delay)
+            double delay,
+            double history = 0)
             : baseOdom(baseOdom),
-              maxQueueSize(delay / INTERVAL_DELAY),
+              delay(delay),
+              maxQueueSize(std::max(delay, history) / INTERVAL_DELAY),
               Runnable(INTERVAL_DELAY)
         {
             // Ensure the queue size is at least 1
@@ -39,39 +43,64 @@ namespace devils
         void onUpdate() override
         {
             // Get the current pose from the base odometry source
-            auto pose = baseOdom.getPose();
-            auto velocity = baseOdom.getVelocity();
+            OdomSample sample;
+            sample.time = pros::millis();
+            sample.pose = baseOdom.getPose();
+            sample.velocity = baseOdom.getVelocity();
 
             // Push the pose to the queue
-            poseQueue.push(pose);
-            velocityQueue.push(velocity);
+            mutex.take();
+            samples.push_back(sample);
 
             // Check if the queue is too large
-            while (poseQueue.size() > maxQueueSize)
-                poseQueue.pop();
-
-            while (velocityQueue.size() > maxQueueSize)
-                velocityQueue.pop();
+            while (samples.size() > maxQueueSize)
+                samples.pop_front();
+            mutex.give();
         }
 
         Pose getPose() override
         {
+            return getPoseAt(pros::millis() - delay);
+        }
+
+        /**
+         * Gets the pose of the base odometry source at a past time.
+         * Use with a measured capture time, such as `ICamera::VisionFrame::captureTime`, instead of a fixed delay.
+         * @param time The time in milliseconds since the program started
+         * @return The latest pose at or before the time, or the oldest pose kept if the time is older than the history
+         */
+        Pose getPoseAt(uint32_t time)
+        {
+            mutex.take();
+
             // Check if the queue is empty
-            if (poseQueue.empty())
+            if (samples.empty())
+            {
+                mutex.give();
                 return baseOdom.getPose();
+            }
 
-            // Get the pose from the front of the queue
-            return poseQueue.front();
+            Pose pose = findSample(time).pose;
+            mutex.give();
+            return pose;
         }
 
         PoseVelocity getVelocity() override
         {
+            uint32_t time = pros::millis() - delay;
+            mutex.take();
+
             // Check if the queue is empty
-            if (velocityQueue.empty())
+            if (samples.empty())
+            {
+                mutex.give();
                 return baseOdom.getVelocity();
+            }
 
-            // Get the velocity from the front of the queue
-            return velocityQueue.front();
+            // Use the same sample as `getPose`, so the pose and velocity agree
+            PoseVelocity velocity = findSample(time).velocity;
+            mutex.give();
+            return velocity;
         }
 
         void setPose(Pose pose) override
@@ -86,10 +115,36 @@ namespace devils
         /// @brief Maximum number of poses to store in the queue
         static constexpr size_t MAX_QUEUE_SIZE = 100;
 
-        std::queue<Pose> poseQueue;
-        std::queue<PoseVelocity> velocityQueue;
+        /// @brief A pose of the base odometry source and the time it was read
+        struct OdomSample
+        {
+            uint32_t time = 0;
+            Pose pose;
+            PoseVelocity velocity;
+        };
+
+        /**
+         * Finds the sample kept for a past time.
+         * Must be called with `mutex` taken and at least one sample kept.
+         * @param time The time in milliseconds since the program started
+         * @return The latest sample at or before the time, or the oldest sample kept if the time is older than the history
+         */
+        const OdomSample &findSample(uint32_t time) const
+        {
+            // Search from the newest sample
+            auto sample = std::find_if(
+                samples.rbegin(),
+                samples.rend(),
+                [time](const OdomSample &sample)
+                { return (int32_t)(time - sample.time) >= 0; });
+            return sample == samples.rend() ? samples.front() : *sample;
+        }
+
+        std::deque<OdomSample> samples;
+        pros::Mutex mutex;
 
         OdomSource &baseOdom;
+        double delay;
         size_t maxQueueSize;
     };
 }
\ No newline at end of file
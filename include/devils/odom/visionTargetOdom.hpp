@@ -1,6 +1,7 @@
 #pragma once
 
 #include "odomSource.hpp"
+#include "delayedOdom.hpp"
 #include "../hardware/structs/camera.h"
 #include "../geometry/units.hpp"
 #include <stdexcept>
@@ -11,6 +12,7 @@ namespace devils
     /**
      * Offsets the odometry of the robot based on the vision target.
      * Corrects for slight deviations in the robot's position by using the vision target as a reference.
+     * Frames from cameras that measure when they were captured are matched to the pose of the robot at that time.
      */
     class VisionTargetOdom : public OdomSource
     {
@@ -20,6 +22,7 @@ namespace devils
          * @param baseOdom The base odometry source to use
          * @param camera The camera to use
          * @param cameraFOV The camera's field of view in degrees
+         * @param latency The delay in milliseconds of cameras that do not measure when their frames were captured.
          * @param expectedPose The expected pose of the vision target.
          */
         VisionTargetOdom(
@@ -29,24 +32,40 @@ namespace devils
             double latency = 0.0,
             Pose expectedPose = Pose(0, 0, 0))
             : baseOdom(baseOdom),
-              delayedOdom(baseOdom, latency),
+              delayedOdom(baseOdom, latency, MAX_FRAME_AGE),
               camera(camera),
               expectedPose(expectedPose),
-              cameraFOV(Units::degToRad(cameraFOV))
+              cameraFOV(Units::degToRad(cameraFOV)),
+              latency(latency)
         {
             if (!camera)
                 throw std::invalid_argument("Camera cannot be null");
+
+            // Record the history of the base odometry, so frames are matched to the pose they were captured at
+            delayedOdom.runAsync();
         }
 
         /**
          * Converts a vision target in the camera's view to an absolute pose.
+         * Assumes the target was detected the constructor's latency ago.
          * @param target The vision target to convert
          * @return The estimated pose of the target
          */
         Pose visionTargetToPose(const ICamera::VisionObject &target)
+        {
+            return visionTargetToPose(target, pros::millis() - latency);
+        }
+
+        /**
+         * Converts a vision target in the camera's view to an absolute pose.
+         * @param target The vision target to convert
+         * @param captureTime The time the target's frame was captured in milliseconds since the program started
+         * @return The estimated pose of the target
+         */
+        Pose visionTargetToPose(const ICamera::VisionObject &target, uint32_t captureTime)
         {
             // Get pose of the robot at the time of the target's detection (delayed odometry)
-            Pose robotPose = delayedOdom.getPose();
+            Pose robotPose = delayedOdom.getPoseAt(captureTime);
 
             // Calculate the angle of the target in degrees
             double targetAngle = 0.5 * cameraFOV * target.x + robotPose.rotation;
@@ -69,13 +88,18 @@ namespace devils
             // Get the current pose of the robot
             Pose robotPose = baseOdom.getPose();
 
-            // Fallback to base odometry if no targets are found
-            if (!camera->hasTargets())
+            // Read the whole frame at once, so the target is never mixed from two frames
+            auto frame = camera->getFrame();
+            const ICamera::VisionObject *visionTarget = frame.getLargestTarget();
+
+            // Fallback to base odometry if no targets are found or the frame is too old
+            if (!visionTarget || pros::millis() - frame.captureTime > MAX_FRAME_AGE)
                 return robotPose + lastOffset;
 
-            // Get the pose of the closest target
-            auto visionTarget = camera->getClosestTarget();
-            auto targetPose = visionTargetToPose(visionTarget);
+            // Get the pose of the closest target at the time its frame was captured
+            // Cameras that do not measure the capture time are assumed to lag by the fixed latency
+            uint32_t captureTime = frame.isCaptureTimeMeasured ? frame.captureTime : pros::millis() - latency;
+            auto targetPose = visionTargetToPose(*visionTarget, captureTime);
 
             // Check if the target is too far away
             if (targetPose.distanceTo(expectedPose) > MAX_DISTANCE)
@@ -116,10 +140,14 @@ namespace devils
         /// @brief A vision target's *assumed* distance to the camera in inches
         static constexpr double TARGET_DISTANCE_TO_CAMERA = 8.0;
 
+        /// @brief The maximum time since a frame was captured for its targets to be used, in milliseconds
+        static constexpr uint32_t MAX_FRAME_AGE = 500;
+
         OdomSource &baseOdom;
         DelayedOdom delayedOdom;
         std::shared_ptr<ICamera> camera = nullptr;
         double cameraFOV; // radians
+        double latency;   // milliseconds
 
         /// @brief The last offset applied to the robot's pose
         /// @details This is used to correct the robot's pose when no targets are found
@@ -11,6 +11,9 @@ namespace devils
 {
     /**
      * Syncs odometry data to VEXBridge.
+     * The pose and speed are sent best-effort, since only the latest pose matters.
+     * Sensor noise below the deadbands is not sent, and the latest pose is resent periodically
+     * so a dropped update does not leave a stale pose.
      */
     class VBOdom : private Runnable
     {
@@ -23,12 +26,12 @@ namespace devils
         VBOdom(std::string name, OdomSource &odometry)
             : odometry(odometry),
               group("_poses/" + name),
-              xValue(group.addValue("x", 0.0f)),
-              yValue(group.addValue("y", 0.0f)),
-              rotation(group.addValue("rotation", 0.0f)),
+              xValue(group.addValue("x", 0.0f, QoS::BEST_EFFORT, POSITION_OPTIONS)),
+              yValue(group.addValue("y", 0.0f, QoS::BEST_EFFORT, POSITION_OPTIONS)),
+              rotation(group.addValue("rotation", 0.0f, QoS::BEST_EFFORT, ROTATION_OPTIONS)),
               width(group.addValue("width", 15.0f)),
               length(group.addValue("length", 15.0f)),
-              speed(group.addValue("speed", 0.0f))
+              speed(group.addValue("speed", 0.0f, QoS::BEST_EFFORT, SPEED_OPTIONS))
         {
             this->runAsync();
         }
@@ -55,6 +58,15 @@ namespace devils
         }
 
     private:
+        /// @brief Skips position changes under 0.05 inches
+        static constexpr PublishOptions POSITION_OPTIONS = {.absoluteDeadband = 0.05, .refreshInterval = 500};
+
+        /// @brief Skips rotation changes under 0.1 degrees
+        static constexpr PublishOptions ROTATION_OPTIONS = {.absoluteDeadband = 0.1, .refreshInterval = 500};
+
+        /// @brief Skips speed changes under 0.1 inches per second or 2%, whichever is larger
+        static constexpr PublishOptions SPEED_OPTIONS = {.absoluteDeadband = 0.1, .relativeDeadband = 0.02, .refreshInterval = 500};
+
         VBGroup group;
         VBValue<float> xValue;
         VBValue<float> yValue;
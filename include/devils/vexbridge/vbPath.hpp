@@ -2,6 +2,7 @@
 #include "../path/path.hpp"
 #include "vexbridge/vbValue.hpp"
 #include "vexbridge/vbGroup.hpp"
+#include "vexbridge/vbLabel.hpp"
 
 using namespace vexbridge;
 
@@ -13,12 +14,32 @@ namespace devils
     class VBPath
     {
     public:
+        /**
+         * Creates a new path syncer.
+         * The labels are looked up once, so syncing the same path repeatedly does not build or hash them again.
+         * @param name The name of the path.
+         */
+        VBPath(const std::string &name)
+            : xLabel("_paths/" + name + "/x"),
+              yLabel("_paths/" + name + "/y")
+        {
+        }
+
         /**
          * Updates the path data on VEXBridge.
          * @param name The name of the path.
          * @param path The path to sync.
          */
-        static void sync(std::string name, Path &path)
+        static void sync(const std::string &name, Path &path)
+        {
+            VBPath(name).sync(path);
+        }
+
+        /**
+         * Updates the path data on VEXBridge.
+         * @param path The path to sync.
+         */
+        void sync(Path &path) const
         {
             // Create vectors for x and y values
             std::vector<float> xValues;
@@ -37,11 +58,14 @@ namespace devils
             }
 
             // Sync the path data
-            VEXBridge::set("_paths/" + name + "/x", xValues);
-            VEXBridge::set("_paths/" + name + "/y", yValues);
+            xLabel.set(xValues);
+            yLabel.set(yValues);
         }
 
     private:
         static constexpr double DELTA_INDEX = 0.01;
+
+        VBLabel xLabel;
+        VBLabel yLabel;
     };
 }
\ No newline at end of file
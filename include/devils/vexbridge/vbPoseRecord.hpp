@@ -0,0 +1,18 @@
+#pragma once
+#include "../geometry/pose.hpp"
+#include "../geometry/poseVelocity.hpp"
+#include "vexbridge/vbRecord.hpp"
+
+/**
+ * Sends a `Pose` or `PoseVelocity` as a single `x:f64,y:f64,rotation:f64` record,
+ * so `VBValue<Pose>` never shows the host a pose with fields from different updates.
+ * `Pose::x` and `Pose::y` are references, so the fields of `Vector2` are listed instead.
+ */
+template <>
+struct vexbridge::RecordTraits<devils::Pose>
+{
+    static constexpr auto FIELDS = std::make_tuple(
+        RecordField("x", &devils::Vector2::x),
+        RecordField("y", &devils::Vector2::y),
+        RecordField("rotation", &devils::Pose::rotation));
+};
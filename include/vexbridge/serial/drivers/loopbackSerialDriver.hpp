@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include "pros/rtos.hpp"
+#include "serialDriver.hpp"
+#include "../../utils/ringBuffer.hpp"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * One direction of a `LoopbackSerialDriver` pair.
+     * Bytes that do not fit are dropped, like a serial port whose receive buffer overflows.
+     */
+    struct LoopbackChannel
+    {
+        /// @brief Maximum number of bytes waiting to be read
+        static constexpr size_t CAPACITY = 65536;
+
+        /// @brief Bytes written but not yet read
+        RingBuffer<CAPACITY> bytes;
+
+        /// @brief Synchronizes the writer and reader
+        pros::Mutex mutex;
+
+        /// @brief Number of written bytes dropped because the channel was full
+        std::atomic<uint32_t> overruns = 0;
+    };
+
+    /**
+     * Serial driver connected to another driver in the same program.
+     * Used to run the protocol stack against a host peer without hardware.
+     * Can corrupt written bytes at a fixed rate to exercise checksums and retransmits.
+     */
+    class LoopbackSerialDriver : public SerialDriver
+    {
+    public:
+        /**
+         * Creates a driver that reads from one channel and writes to another.
+         * @param readChannel The channel to read from.
+         * @param writeChannel The channel to write to.
+         */
+        LoopbackSerialDriver(std::shared_ptr<LoopbackChannel> readChannel, std::shared_ptr<LoopbackChannel> writeChannel)
+            : readChannel(readChannel),
+              writeChannel(writeChannel)
+        {
+        }
+
+        /**
+         * Creates two drivers connected to each other.
+         * Bytes written to one are read from the other.
+         * @return The connected drivers.
+         */
+        static std::pair<std::shared_ptr<LoopbackSerialDriver>, std::shared_ptr<LoopbackSerialDriver>> makePair()
+        {
+            auto channelA = std::make_shared<LoopbackChannel>();
+            auto channelB = std::make_shared<LoopbackChannel>();
+            return {std::make_shared<LoopbackSerialDriver>(channelA, channelB),
+                    std::make_shared<LoopbackSerialDriver>(channelB, channelA)};
+        }
+
+        /**
+         * Corrupts bytes written by this driver.
+         * Each corrupted byte has one random bit flipped.
+         * @param errorRate The probability that each byte is corrupted, from 0 to 1.
+         * @param seed The seed of the random number generator, so runs can be repeated.
+         */
+        void setErrorRate(double errorRate, uint32_t seed = 1)
+        {
+            this->errorRate = errorRate;
+            random.seed(seed);
+            errorGap = NO_ERROR;
+        }
+
+        bool write(Buffer &buffer) override
+        {
+            return write(std::span<const uint8_t>(buffer));
+        }
+
+        bool write(std::span<const uint8_t> bytes) override
+        {
+            writeChannel->mutex.take();
+
+            // Copy the bytes, flipping a random bit in the corrupted ones
+            size_t bytesWritten = 0;
+            while (bytesWritten < bytes.size())
+            {
+                // Copy up to the next corrupted byte
+                size_t cleanLength = std::min(nextErrorOffset(), bytes.size() - bytesWritten);
+                size_t copied = writeChannel->bytes.write(bytes.subspan(bytesWritten, cleanLength));
+                bytesWritten += copied;
+                if (copied < cleanLength || bytesWritten == bytes.size())
+                {
+                    if (errorRate > 0)
+                        errorGap -= copied;
+                    break;
+                }
+
+                // Copy the corrupted byte
+                uint8_t corruptedByte = bytes[bytesWritten] ^ (1 << (random() % 8));
+                if (writeChannel->bytes.write(std::span<const uint8_t>(&corruptedByte, 1)) == 0)
+                    break;
+                bytesWritten++;
+                errorGap = NO_ERROR;
+            }
+            writeChannel->mutex.give();
+
+            // Update counters
+            writeChannel->overruns.fetch_add(bytes.size() - bytesWritten, std::memory_order_relaxed);
+            this->bytesWritten.fetch_add(bytesWritten, std::memory_order_relaxed);
+            sdkCalls.fetch_add(1, std::memory_order_relaxed);
+            return bytesWritten == bytes.size();
+        }
+
+        using SerialDriver::read;
+
+        int32_t read(std::span<uint8_t> output) override
+        {
+            readChannel->mutex.take();
+
+            // Copy out as many bytes as fit
+            size_t bytesRead = 0;
+            while (bytesRead < output.size() && !readChannel->bytes.empty())
+            {
+                std::span<const uint8_t> region = readChannel->bytes.getReadSpan(0);
+                size_t length = std::min(region.size(), output.size() - bytesRead);
+                memcpy(output.data() + bytesRead, region.data(), length);
+                readChannel->bytes.discard(length);
+                bytesRead += length;
+            }
+
+            readChannel->mutex.give();
+
+            // Update counters
+            this->bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+            sdkCalls.fetch_add(1, std::memory_order_relaxed);
+            return bytesRead;
+        }
+
+        int32_t getWriteFree() override
+        {
+            writeChannel->mutex.take();
+            int32_t writeFree = writeChannel->bytes.getFree();
+            writeChannel->mutex.give();
+            return writeFree;
+        }
+
+        SerialDriverStats getStats() const override
+        {
+            SerialDriverStats stats;
+            stats.bytesRead = bytesRead.load(std::memory_order_relaxed);
+            stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+            stats.sdkCalls = sdkCalls.load(std::memory_order_relaxed);
+            stats.overruns = readChannel->overruns.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        /**
+         * Gets the number of bytes before the next corrupted byte.
+         * Skips directly to each corrupted byte rather than rolling once per byte.
+         * @return The number of clean bytes before the next corrupted byte.
+         */
+        size_t nextErrorOffset()
+        {
+            if (errorRate <= 0)
+                return NO_ERROR;
+            if (errorGap == NO_ERROR)
+                errorGap = std::geometric_distribution<size_t>(errorRate)(random);
+            return errorGap;
+        }
+
+        /// @brief Value of `errorGap` when the next corrupted byte has not been chosen
+        static constexpr size_t NO_ERROR = (size_t)-1;
+
+        /// @brief Number of clean bytes left before the next corrupted byte
+        size_t errorGap = NO_ERROR;
+
+        /// @brief Probability that each written byte is corrupted
+        double errorRate = 0;
+
+        /// @brief Chooses which bytes and bits are corrupted
+        std::minstd_rand random;
+
+        // Counters
+        // Written by the writing and reading tasks, so they are atomic
+        std::atomic<uint32_t> bytesRead = 0;
+        std::atomic<uint32_t> bytesWritten = 0;
+        std::atomic<uint32_t> sdkCalls = 0;
+
+        std::shared_ptr<LoopbackChannel> readChannel;
+        std::shared_ptr<LoopbackChannel> writeChannel;
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <span>
+#include <algorithm>
+#include "pros/link.hpp"
+#include "pros/error.h"
+
+namespace vexbridge::serial
+{
+    /**
+     * Raw packet link between two radios, as used by `RadioSerialDriver`.
+     * Each transmit sends one link packet, which may be lost whole. Received bytes are read as a stream.
+     */
+    struct RadioLink
+    {
+        virtual ~RadioLink() = default;
+
+        /**
+         * Sends one link packet.
+         * @param packet The bytes of the packet.
+         * @return True if the packet was queued, false if the transmit buffer is full or the link is down.
+         */
+        virtual bool transmit(std::span<const uint8_t> packet) = 0;
+
+        /**
+         * Gets the size of the largest packet `transmit` would queue now.
+         * @return The free space in the transmit buffer in bytes, or 0 if the link is down.
+         */
+        virtual size_t getTransmitFree() = 0;
+
+        /**
+         * Gets the size of the transmit buffer.
+         * `getTransmitFree` returns this once every queued packet was sent.
+         * @return The size of the transmit buffer in bytes.
+         */
+        virtual size_t getTransmitCapacity() = 0;
+
+        /**
+         * Reads received bytes.
+         * @param output The bytes to read into. Bytes that do not fit remain for the next read.
+         * @return The number of bytes read or -1 if the link is down.
+         */
+        virtual int32_t receive(std::span<uint8_t> output) = 0;
+    };
+
+    /**
+     * VEXlink connection of a V5 radio, using the raw transmit and receive calls of `pros::Link`.
+     */
+    class ProsRadioLink : public RadioLink
+    {
+    public:
+        /**
+         * Opens a link on a radio.
+         * Both radios must use the same link name, and one must be the transmitter.
+         * The transmitter has twice the bandwidth of the receiver.
+         * @param port The port of the radio.
+         * @param isTransmitter True if the radio is the transmitter, false if it is the receiver.
+         */
+        ProsRadioLink(uint8_t port, bool isTransmitter)
+            : link(port, LINK_NAME, isTransmitter ? pros::E_LINK_TX : pros::E_LINK_RX)
+        {
+        }
+
+        bool transmit(std::span<const uint8_t> packet) override
+        {
+            uint32_t bytesWritten = link.transmit_raw((void *)packet.data(), packet.size());
+            return bytesWritten != PROS_ERR && bytesWritten == packet.size();
+        }
+
+        size_t getTransmitFree() override
+        {
+            uint32_t transmitFree = link.raw_transmittable_size();
+            return transmitFree == PROS_ERR ? 0 : transmitFree;
+        }
+
+        size_t getTransmitCapacity() override
+        {
+            return LINK_BUFFER_SIZE;
+        }
+
+        int32_t receive(std::span<uint8_t> output) override
+        {
+            // Check if there is data to read
+            uint32_t receivableSize = link.raw_receivable_size();
+            if (receivableSize == PROS_ERR)
+                return -1;
+
+            // Read as much data as fits
+            // The rest remains in the receive buffer for the next read
+            uint32_t readSize = std::min((size_t)receivableSize, output.size());
+            if (readSize == 0)
+                return 0;
+            uint32_t bytesRead = link.receive_raw(output.data(), readSize);
+            if (bytesRead == PROS_ERR)
+                return -1;
+            return bytesRead;
+        }
+
+    private:
+        const std::string LINK_NAME = "vexbridge";
+
+        pros::Link link;
+    };
+}
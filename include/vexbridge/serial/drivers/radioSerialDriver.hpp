@@ -1,18 +1,46 @@
 #pragma once
 
-#include "pros/link.hpp"
-#include "pros/error.h"
 #include "serialDriver.hpp"
+#include "radioLink.hpp"
 #include <cmath>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include "pros/rtos.hpp"
 #include "../../utils/buffer.h"
+#include "../../utils/ringBuffer.hpp"
+#include "../../utils/crc.hpp"
+#include "../../utils/lz.hpp"
 
 using namespace vexbridge::utils;
 
 namespace vexbridge::serial
 {
+    /**
+     * How a `RadioSerialDriver` packs frames into link packets.
+     * Both sides of a link must use the same MTU.
+     */
+    struct RadioOptions
+    {
+        /// @brief Size of the largest link packet in bytes, including the link header and CRC.
+        /// Smaller packets lose less when one is dropped, larger packets spend less on headers.
+        size_t mtu = 128;
+
+        /// @brief True to compress the frames in each link packet if it makes them smaller.
+        /// The receiver decompresses either way, so only the sender needs it.
+        bool isCompressed = false;
+    };
+
     /**
      * Interface for reading and writing data to another robot via a VEX V5 radio.
-     * \note Completely untested and may not work as intended.
+     * VEXlink has a small transmit buffer and little bandwidth, so written frames are not sent as they are.
+     * Frames are queued as a byte stream and cut into link packets of at most the MTU as the radio has room,
+     * so large frames span several packets. Like Nagle's algorithm, a packet that is not full waits until the radio
+     * has sent everything before it, so small frames written while the radio is busy share a packet.
+     * This delays a frame by at most the time to send the packets already queued on the radio.
+     * Each link packet starts with a sync byte and ends with a CRC-16, so the receiver finds the next packet
+     * after a lost or corrupt one. The frames inside are reassembled by the frame scanner, whose checksums and
+     * retransmits recover the frames that were lost with the packet.
      */
     class RadioSerialDriver : public SerialDriver
     {
@@ -21,54 +49,329 @@ namespace vexbridge::serial
          * Creates a new radio serial driver.
          * @param port The port of the radio to use.
          * @param isTransmitter True if the radio is a transmitter, false if it is a receiver.
+         * @param options How frames are packed into link packets.
          */
-        RadioSerialDriver(uint8_t port, bool isTransmitter)
-            : serial(port, LINK_NAME, isTransmitter ? pros::E_LINK_TX : pros::E_LINK_RX)
+        RadioSerialDriver(uint8_t port, bool isTransmitter, const RadioOptions &options = {})
+            : RadioSerialDriver(std::make_shared<ProsRadioLink>(port, isTransmitter), options)
         {
         }
 
-        bool write(Buffer &buffer)
+        /**
+         * Creates a new serial driver over any radio link, such as a `SimulatedRadioLink`.
+         * @param link The link to send and receive link packets on.
+         * @param options How frames are packed into link packets.
+         * @throws std::runtime_error if the link is nullptr or the MTU is too small.
+         */
+        RadioSerialDriver(std::shared_ptr<RadioLink> link, const RadioOptions &options = {})
+            : link(link),
+              options(options)
         {
-            // Write the packet to the serial port
-            uint32_t writeRes = serial.transmit_raw(buffer.data(), buffer.size());
-            if (writeRes == PROS_ERR)
-                return false;
-
-            // Check if the entire packet was written
-            if (writeRes != buffer.size())
-                return false;
+            if (!link)
+                throw std::runtime_error("Radio link cannot be nullptr.");
+            if (options.mtu <= OVERHEAD || options.mtu - OVERHEAD > UINT16_MAX)
+                throw std::runtime_error("Radio MTU must fit the link header and a payload.");
+        }
 
-            // Return success
-            return true;
+        bool write(Buffer &buffer) override
+        {
+            return write(std::span<const uint8_t>(buffer));
         }
 
-        int32_t read(Buffer &buffer) override
+        bool write(std::span<const uint8_t> bytes) override
         {
-            // Check if there is data to read
-            uint32_t readBufferSize = serial.raw_receivable_size();
-            if (readBufferSize == PROS_ERR)
-                return -1;
+            writeMutex.take();
 
-            // Allocate buffer space
-            buffer.resize(readBufferSize);
+            // Drop frames that do not fit rather than writing part of a frame
+            bool isQueued = bytes.size() <= PENDING_CAPACITY - pending.size();
+            if (isQueued)
+                pending.insert(pending.end(), bytes.begin(), bytes.end());
+            else
+                overruns.fetch_add(bytes.size(), std::memory_order_relaxed);
 
-            // Read data from the serial port
-            uint32_t bytesRead = serial.receive_raw(buffer.data(), readBufferSize);
-            if (bytesRead == PROS_ERR)
-                return -1;
+            // Send as much as the radio has room for
+            sendPending();
+
+            writeMutex.give();
+
+            // Update counters
+            if (isQueued)
+                bytesWritten.fetch_add(bytes.size(), std::memory_order_relaxed);
+            return isQueued;
+        }
+
+        using SerialDriver::read;
+
+        int32_t read(std::span<uint8_t> output) override
+        {
+            // Send frames that waited for room on the radio
+            writeMutex.take();
+            sendPending();
+            writeMutex.give();
 
-            // Flush the serial port
-            uint32_t flushRes = serial.clear_receive_buf();
-            if (flushRes == PROS_ERR)
+            // Receive every available byte, then unpack every whole link packet
+            if (!receivePackets())
                 return -1;
 
-            // Return the number of bytes read
+            // Copy out as many bytes as fit, in up to two regions if they wrap around the ring
+            size_t bytesRead = std::min(output.size(), received.size());
+            for (size_t offset = 0; offset < bytesRead;)
+            {
+                std::span<const uint8_t> region = received.getReadSpan(offset);
+                size_t length = std::min(region.size(), bytesRead - offset);
+                std::copy_n(region.begin(), length, output.begin() + offset);
+                offset += length;
+            }
+            received.discard(bytesRead);
+
+            // Update counters
+            this->bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
             return bytesRead;
         }
 
+        /**
+         * Gets the room for frames that can be dropped, such as best-effort updates.
+         * Only about one full packet of bytes is let wait, so a newer update replaces an old one
+         * rather than queueing behind it. `write` still accepts up to `PENDING_CAPACITY` bytes.
+         * @return The number of bytes that can be written without waiting behind a full packet.
+         */
+        int32_t getWriteFree() override
+        {
+            writeMutex.take();
+            sendPending();
+            size_t fullSize = getFullSize();
+            int32_t writeFree = pending.empty() ? PENDING_CAPACITY : fullSize - std::min(pending.size(), fullSize);
+            writeMutex.give();
+            return writeFree;
+        }
+
+        SerialDriverStats getStats() const override
+        {
+            SerialDriverStats stats;
+            stats.bytesRead = bytesRead.load(std::memory_order_relaxed);
+            stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+            stats.sdkCalls = sdkCalls.load(std::memory_order_relaxed);
+            stats.overruns = overruns.load(std::memory_order_relaxed);
+            return stats;
+        }
+
     private:
-        const std::string LINK_NAME = "vexbridge";
+        /// @brief First byte of every link packet
+        static constexpr uint8_t SYNC = 0x5A;
+
+        /// @brief Size of the sync byte, flags, and payload size
+        static constexpr size_t HEADER_SIZE = 4;
+
+        /// @brief Size of the CRC-16 after the payload
+        static constexpr size_t CRC_SIZE = 2;
+
+        /// @brief Bytes of each link packet that are not payload
+        static constexpr size_t OVERHEAD = HEADER_SIZE + CRC_SIZE;
+
+        /// @brief Flag of a link packet whose payload is compressed with `Lz`
+        static constexpr uint8_t FLAG_COMPRESSED = 1 << 0;
+
+        /// @brief Most bytes of frames compressed into a single payload, as a multiple of the largest payload
+        static constexpr size_t MAX_COMPRESSION_RATIO = 4;
+
+        /// @brief Maximum number of written bytes waiting for room on the radio
+        static constexpr size_t PENDING_CAPACITY = 2048;
+
+        /// @brief Maximum number of unpacked bytes waiting to be read. Twice what the reader takes in an update.
+        static constexpr size_t RECEIVED_CAPACITY = 4096;
+
+        /**
+         * Gets the number of waiting bytes that fill a link packet.
+         * Compressed packets hold up to `MAX_COMPRESSION_RATIO` times as many bytes.
+         * @return The number of bytes.
+         */
+        size_t getFullSize() const
+        {
+            return (options.mtu - OVERHEAD) * (options.isCompressed ? MAX_COMPRESSION_RATIO : 1);
+        }
+
+        /**
+         * Sends waiting bytes as link packets until the radio is full or every byte is sent.
+         * Must be called with `writeMutex` taken.
+         */
+        void sendPending()
+        {
+            while (!pending.empty())
+            {
+                // Hold back a packet that is not full while the radio is still sending, so more frames can join it
+                size_t transmitFree = link->getTransmitFree();
+                sdkCalls.fetch_add(1, std::memory_order_relaxed);
+                bool isFull = pending.size() >= getFullSize();
+                if (!isFull && transmitFree < link->getTransmitCapacity())
+                    return;
+
+                // Wait for room for the whole packet rather than sending a small one into the space left
+                size_t packetSize = isFull ? options.mtu : std::min(options.mtu, pending.size() + OVERHEAD);
+                if (transmitFree < packetSize)
+                    return;
+                size_t payloadCapacity = packetSize - OVERHEAD;
+
+                // Fill the payload
+                packet.resize(packetSize);
+                uint8_t flags = 0;
+                size_t consumedSize = 0;
+                size_t payloadSize = 0;
+                if (options.isCompressed)
+                    payloadSize = compressPending(payloadCapacity, consumedSize);
+                if (payloadSize > 0)
+                {
+                    flags |= FLAG_COMPRESSED;
+                }
+                else
+                {
+                    payloadSize = consumedSize = std::min(pending.size(), payloadCapacity);
+                    std::copy_n(pending.begin(), payloadSize, packet.begin() + HEADER_SIZE);
+                }
+
+                // Header and CRC
+                packet[0] = SYNC;
+                packet[1] = flags;
+                packet[2] = payloadSize >> 8;
+                packet[3] = payloadSize & 0xFF;
+                uint16_t crc = Crc::calc16(std::span<const uint8_t>(packet.data() + 1, HEADER_SIZE - 1 + payloadSize));
+                packet[HEADER_SIZE + payloadSize] = crc >> 8;
+                packet[HEADER_SIZE + payloadSize + 1] = crc & 0xFF;
+
+                // Keep the bytes for the next try if the radio refuses the packet
+                sdkCalls.fetch_add(1, std::memory_order_relaxed);
+                if (!link->transmit(std::span<const uint8_t>(packet.data(), payloadSize + OVERHEAD)))
+                    return;
+                pending.erase(pending.begin(), pending.begin() + consumedSize);
+            }
+        }
+
+        /**
+         * Compresses as many waiting bytes as fit in a payload once compressed.
+         * Starts with up to `MAX_COMPRESSION_RATIO` payloads of bytes and halves them until they fit.
+         * Must be called with `writeMutex` taken.
+         * @param payloadCapacity The size of the payload.
+         * @param consumedSize Set to the number of waiting bytes compressed.
+         * @return The size of the compressed payload, or 0 if compressing does not make the payload hold more.
+         */
+        size_t compressPending(size_t payloadCapacity, size_t &consumedSize)
+        {
+            std::span<uint8_t> payload(packet.data() + HEADER_SIZE, payloadCapacity);
+            size_t inputSize = std::min(pending.size(), payloadCapacity * MAX_COMPRESSION_RATIO);
+            while (true)
+            {
+                size_t compressedSize = Lz::compress(std::span<const uint8_t>(pending.data(), inputSize), payload);
+                if (compressedSize != Lz::INVALID && compressedSize < inputSize)
+                {
+                    consumedSize = inputSize;
+                    return compressedSize;
+                }
+
+                // Sent uncompressed once it fits either way
+                if (inputSize <= payloadCapacity)
+                    return 0;
+                inputSize = std::max(inputSize / 2, payloadCapacity);
+            }
+        }
+
+        /**
+         * Reads every available byte from the radio and unpacks every whole link packet into `received`.
+         * Bytes before a sync byte, and link packets that fail their CRC, are skipped.
+         * Unpacked bytes that do not fit in `received` are dropped and counted as overruns.
+         * @return False if the radio could not be read.
+         */
+        bool receivePackets()
+        {
+            // Read everything the radio has
+            while (true)
+            {
+                size_t offset = incoming.size();
+                incoming.resize(offset + READ_BLOCK_SIZE);
+                int32_t bytesRead = link->receive(std::span<uint8_t>(incoming.data() + offset, READ_BLOCK_SIZE));
+                incoming.resize(offset + std::max(bytesRead, (int32_t)0));
+                sdkCalls.fetch_add(1, std::memory_order_relaxed);
+                if (bytesRead < 0)
+                    return false;
+                if (bytesRead < (int32_t)READ_BLOCK_SIZE)
+                    break;
+            }
+
+            // Unpack whole link packets
+            size_t maxPayloadSize = options.mtu - OVERHEAD;
+            size_t i = 0;
+            while (true)
+            {
+                // Find the next sync byte
+                while (i < incoming.size() && incoming[i] != SYNC)
+                    i++;
+                if (incoming.size() - i < HEADER_SIZE)
+                    break;
+
+                // A payload larger than the MTU means this sync byte was part of another packet
+                uint8_t flags = incoming[i + 1];
+                size_t payloadSize = (incoming[i + 2] << 8) | incoming[i + 3];
+                if (payloadSize > maxPayloadSize || (flags & ~FLAG_COMPRESSED) != 0)
+                {
+                    i++;
+                    continue;
+                }
+
+                // Wait for the rest of the packet
+                if (incoming.size() - i < payloadSize + OVERHEAD)
+                    break;
+
+                // Skip to the next sync byte if the packet is corrupt
+                std::span<const uint8_t> checkedBytes(incoming.data() + i + 1, HEADER_SIZE - 1 + payloadSize);
+                uint16_t crc = (incoming[i + HEADER_SIZE + payloadSize] << 8) | incoming[i + HEADER_SIZE + payloadSize + 1];
+                if (Crc::calc16(checkedBytes) != crc)
+                {
+                    i++;
+                    continue;
+                }
+
+                // Unpack the payload
+                std::span<const uint8_t> payload(incoming.data() + i + HEADER_SIZE, payloadSize);
+                if (flags & FLAG_COMPRESSED)
+                {
+                    // Corrupt payloads are dropped, and the frames inside are resent
+                    decompressed.resize(maxPayloadSize * MAX_COMPRESSION_RATIO);
+                    size_t decompressedSize = Lz::decompress(payload, std::span<uint8_t>(decompressed));
+                    payload = std::span<const uint8_t>(decompressed.data(), decompressedSize == Lz::INVALID ? 0 : decompressedSize);
+                }
+                size_t writtenSize = received.write(payload);
+                overruns.fetch_add(payload.size() - writtenSize, std::memory_order_relaxed);
+                i += payloadSize + OVERHEAD;
+            }
+            incoming.erase(incoming.begin(), incoming.begin() + i);
+            return true;
+        }
+
+        /// @brief Link to send and receive link packets on
+        std::shared_ptr<RadioLink> link;
+
+        /// @brief How frames are packed into link packets
+        RadioOptions options;
+
+        /// @brief Written bytes waiting for room on the radio. Guarded by `writeMutex`.
+        Buffer pending;
+
+        /// @brief Link packet being sent. Keeps its capacity between packets. Guarded by `writeMutex`.
+        Buffer packet;
+
+        /// @brief Bytes read from the radio that do not form a whole link packet yet
+        Buffer incoming;
+
+        /// @brief Decompressed payload being unpacked. Keeps its capacity between packets.
+        Buffer decompressed;
+
+        /// @brief Unpacked bytes waiting to be read
+        RingBuffer<RECEIVED_CAPACITY> received;
+
+        /// @brief Synchronizes writers and the reader sending waiting bytes
+        pros::Mutex writeMutex;
 
-        pros::Link serial;
+        // Counters
+        std::atomic<uint32_t> bytesRead = 0;
+        std::atomic<uint32_t> bytesWritten = 0;
+        std::atomic<uint32_t> sdkCalls = 0;
+        std::atomic<uint32_t> overruns = 0;
     };
-}
\ No newline at end of file
+}
@@ -1,12 +1,42 @@
 #pragma once
 
 #include <cstdint>
+#include <climits>
+#include <span>
+#include <algorithm>
 #include "../../utils/buffer.h"
 
 using namespace vexbridge::utils;
 
 namespace vexbridge::serial
 {
+    /**
+     * Usage counters of a serial driver.
+     */
+    struct SerialDriverStats
+    {
+        /// @brief Number of bytes read from the serial port
+        uint32_t bytesRead = 0;
+
+        /// @brief Number of bytes written to the serial port
+        uint32_t bytesWritten = 0;
+
+        /// @brief Number of calls made to the SDK or PROS to read and write
+        uint32_t sdkCalls = 0;
+
+        /// @brief Number of received bytes dropped because the reader could not keep up
+        uint32_t overruns = 0;
+
+        /// @brief Number of received bytes discarded because they did not form a frame, such as line noise
+        uint32_t discarded = 0;
+
+        /// @brief Number of best-effort updates replaced by a newer update before they were written
+        uint32_t superseded = 0;
+
+        /// @brief Number of best-effort packets dropped because the socket's write queue was full
+        uint32_t queueOverflows = 0;
+    };
+
     /**
      * Represents an interface for reading and writing data to a serial port.
      */
@@ -20,10 +50,75 @@ namespace vexbridge::serial
         virtual bool write(Buffer &buffer) = 0;
 
         /**
-         * Reads data from the serial port.
-         * @param buffer Data is written to this buffer from the serial port.
+         * Writes data to the serial port without requiring a `Buffer`.
+         * Copies into a `Buffer` by default. Drivers that can write from any memory should override this.
+         * @param bytes Data is read from these bytes into the serial port.
+         * @return True if the write was successful, false otherwise.
+         */
+        virtual bool write(std::span<const uint8_t> bytes)
+        {
+            Buffer buffer(bytes.begin(), bytes.end());
+            return write(buffer);
+        }
+
+        /**
+         * Reads data from the serial port directly into caller-owned memory.
+         * Reads at most `output.size()` bytes. Bytes that do not fit remain in the serial port for the next read.
+         * @param output Data is written to these bytes from the serial port.
          * @return The number of bytes read or -1 if an error occurred.
          */
-        virtual int32_t read(Buffer &buffer) = 0;
+        virtual int32_t read(std::span<uint8_t> output) = 0;
+
+        /**
+         * Reads all available data from the serial port.
+         * Appends to `buffer` in blocks using `read(std::span<uint8_t>)`.
+         * @param buffer Data is appended to this buffer from the serial port.
+         * @return The size of the buffer or -1 if an error occurred.
+         */
+        virtual int32_t read(Buffer &buffer)
+        {
+            while (true)
+            {
+                // Read into the space after the existing data
+                size_t offset = buffer.size();
+                buffer.resize(offset + READ_BLOCK_SIZE);
+                int32_t bytesRead = read(std::span<uint8_t>(buffer.data() + offset, READ_BLOCK_SIZE));
+                buffer.resize(offset + std::max(bytesRead, (int32_t)0));
+
+                // Stop once the serial port is drained
+                if (bytesRead < 0)
+                    return -1;
+                if (bytesRead < (int32_t)READ_BLOCK_SIZE)
+                    return buffer.size();
+            }
+        }
+
+        /**
+         * Gets the number of bytes that can be written without blocking or being dropped.
+         * Best-effort packets are held back while a frame does not fit.
+         * Drivers that cannot tell return `UNLIMITED`.
+         * @return The number of free bytes in the transmit buffer.
+         */
+        virtual int32_t getWriteFree()
+        {
+            return UNLIMITED;
+        }
+
+        /**
+         * Gets the usage counters of the driver.
+         * Drivers that do not count usage return all zeros.
+         * @return The usage counters.
+         */
+        virtual SerialDriverStats getStats() const
+        {
+            return {};
+        }
+
+        /// @brief Returned by `getWriteFree` if the driver cannot tell how much space is free
+        static constexpr int32_t UNLIMITED = INT32_MAX;
+
+    protected:
+        /// @brief Number of bytes `read(Buffer &)` requests at a time
+        static constexpr size_t READ_BLOCK_SIZE = 256;
     };
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include "pros/rtos.hpp"
+#include "radioLink.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * How a `SimulatedRadioLink` pair behaves.
+     */
+    struct SimulatedRadioOptions
+    {
+        /// @brief Bytes sent over the air per second in each direction
+        uint32_t bandwidth = 4000;
+
+        /// @brief Time from when a packet leaves the air until it can be read, in milliseconds
+        uint32_t latency = 5;
+
+        /// @brief Probability that each packet is lost, from 0 to 1
+        double lossRate = 0;
+
+        /// @brief Size of each transmit buffer in bytes, like `LINK_BUFFER_SIZE`
+        size_t transmitBufferSize = 512;
+
+        /// @brief Seed of the loss model, so runs can be repeated
+        uint32_t seed = 1;
+    };
+
+    /**
+     * Usage counters of one direction of a `SimulatedRadioLink` pair.
+     */
+    struct SimulatedRadioStats
+    {
+        /// @brief Number of packets transmitted, including lost packets
+        uint32_t packetsSent = 0;
+
+        /// @brief Number of bytes transmitted, including lost packets
+        uint32_t bytesSent = 0;
+
+        /// @brief Number of packets lost
+        uint32_t packetsLost = 0;
+
+        /// @brief Number of packets refused because the transmit buffer was full
+        uint32_t packetsRefused = 0;
+    };
+
+    /**
+     * One direction of a `SimulatedRadioLink` pair.
+     */
+    struct SimulatedRadioChannel
+    {
+        /**
+         * A packet on its way to the receiver.
+         */
+        struct InFlightPacket
+        {
+            /// @brief Bytes of the packet
+            std::vector<uint8_t> bytes;
+
+            /// @brief Time the packet is done being sent and leaves the transmit buffer, in microseconds
+            uint64_t sentTime;
+
+            /// @brief Time the packet can be read, in microseconds
+            uint64_t arrivalTime;
+
+            /// @brief True if the packet never arrives
+            bool isLost;
+        };
+
+        /// @brief Packets transmitted but not yet read, in the order they were sent
+        std::deque<InFlightPacket> packets;
+
+        /// @brief Bytes of arrived packets that were not read yet
+        std::deque<uint8_t> received;
+
+        /// @brief Time the last queued packet is done being sent, in microseconds
+        uint64_t busyUntil = 0;
+
+        /// @brief Decides which packets are lost
+        std::minstd_rand random;
+
+        /// @brief Usage counters
+        SimulatedRadioStats stats;
+
+        /// @brief Synchronizes the transmitter and receiver
+        pros::Mutex mutex;
+    };
+
+    /**
+     * Radio link connected to another link in the same program.
+     * Stands in for VEXlink so `RadioSerialDriver` can be run and benchmarked without radios.
+     * Each direction sends one packet at a time at a fixed bandwidth, holds queued packets in a bounded transmit buffer,
+     * delays arrival by a fixed latency, and loses whole packets at random.
+     */
+    class SimulatedRadioLink : public RadioLink
+    {
+    public:
+        /**
+         * Creates a link that transmits on one channel and receives from another.
+         * @param receiveChannel The channel to receive from.
+         * @param transmitChannel The channel to transmit on.
+         * @param options How the channels behave.
+         */
+        SimulatedRadioLink(std::shared_ptr<SimulatedRadioChannel> receiveChannel,
+                           std::shared_ptr<SimulatedRadioChannel> transmitChannel,
+                           const SimulatedRadioOptions &options)
+            : receiveChannel(receiveChannel),
+              transmitChannel(transmitChannel),
+              options(options)
+        {
+        }
+
+        /**
+         * Creates two links connected to each other.
+         * Packets transmitted by one are received by the other.
+         * @param options How both directions behave.
+         * @return The connected links.
+         */
+        static std::pair<std::shared_ptr<SimulatedRadioLink>, std::shared_ptr<SimulatedRadioLink>> makePair(const SimulatedRadioOptions &options = {})
+        {
+            auto channelA = std::make_shared<SimulatedRadioChannel>();
+            auto channelB = std::make_shared<SimulatedRadioChannel>();
+            channelA->random.seed(options.seed);
+            channelB->random.seed(options.seed + 1);
+            return {std::make_shared<SimulatedRadioLink>(channelA, channelB, options),
+                    std::make_shared<SimulatedRadioLink>(channelB, channelA, options)};
+        }
+
+        bool transmit(std::span<const uint8_t> packet) override
+        {
+            uint64_t now = pros::micros();
+            transmitChannel->mutex.take();
+
+            // Refuse packets that do not fit in the transmit buffer
+            bool isQueued = packet.size() <= getTransmitFree(*transmitChannel, now);
+            if (isQueued)
+            {
+                // Packets are sent one at a time, after any packet still being sent
+                uint64_t airTime = (uint64_t)packet.size() * 1000000 / options.bandwidth;
+                uint64_t sentTime = std::max(now, transmitChannel->busyUntil) + airTime;
+                bool isLost = std::uniform_real_distribution<double>(0, 1)(transmitChannel->random) < options.lossRate;
+                transmitChannel->packets.push_back({std::vector<uint8_t>(packet.begin(), packet.end()),
+                                                    sentTime,
+                                                    sentTime + (uint64_t)options.latency * 1000,
+                                                    isLost});
+                transmitChannel->busyUntil = sentTime;
+
+                transmitChannel->stats.packetsSent++;
+                transmitChannel->stats.bytesSent += packet.size();
+                transmitChannel->stats.packetsLost += isLost;
+            }
+            else
+            {
+                transmitChannel->stats.packetsRefused++;
+            }
+
+            transmitChannel->mutex.give();
+            return isQueued;
+        }
+
+        size_t getTransmitFree() override
+        {
+            uint64_t now = pros::micros();
+            transmitChannel->mutex.take();
+            size_t transmitFree = getTransmitFree(*transmitChannel, now);
+            transmitChannel->mutex.give();
+            return transmitFree;
+        }
+
+        size_t getTransmitCapacity() override
+        {
+            return options.transmitBufferSize;
+        }
+
+        int32_t receive(std::span<uint8_t> output) override
+        {
+            uint64_t now = pros::micros();
+            receiveChannel->mutex.take();
+
+            // Deliver every packet that has arrived
+            auto &packets = receiveChannel->packets;
+            while (!packets.empty() && packets.front().arrivalTime <= now)
+            {
+                if (!packets.front().isLost)
+                    receiveChannel->received.insert(receiveChannel->received.end(),
+                                                    packets.front().bytes.begin(),
+                                                    packets.front().bytes.end());
+                packets.pop_front();
+            }
+
+            // Copy out as many bytes as fit
+            size_t bytesRead = std::min(output.size(), receiveChannel->received.size());
+            std::copy_n(receiveChannel->received.begin(), bytesRead, output.begin());
+            receiveChannel->received.erase(receiveChannel->received.begin(), receiveChannel->received.begin() + bytesRead);
+
+            receiveChannel->mutex.give();
+            return bytesRead;
+        }
+
+        /**
+         * Gets the usage counters of the direction this link transmits on.
+         * @return The usage counters.
+         */
+        SimulatedRadioStats getStats()
+        {
+            transmitChannel->mutex.take();
+            SimulatedRadioStats stats = transmitChannel->stats;
+            transmitChannel->mutex.give();
+            return stats;
+        }
+
+    private:
+        /**
+         * Gets the free space in the transmit buffer of a channel.
+         * Packets leave the transmit buffer once they are done being sent.
+         * Must be called with the channel's mutex taken.
+         * @param channel The channel to check.
+         * @param now The current time in microseconds.
+         * @return The free space in bytes.
+         */
+        size_t getTransmitFree(const SimulatedRadioChannel &channel, uint64_t now) const
+        {
+            size_t bufferedSize = 0;
+            for (auto it = channel.packets.rbegin(); it != channel.packets.rend() && it->sentTime > now; it++)
+                bufferedSize += it->bytes.size();
+            return options.transmitBufferSize - std::min(bufferedSize, options.transmitBufferSize);
+        }
+
+        std::shared_ptr<SimulatedRadioChannel> receiveChannel;
+        std::shared_ptr<SimulatedRadioChannel> transmitChannel;
+        SimulatedRadioOptions options;
+    };
+}
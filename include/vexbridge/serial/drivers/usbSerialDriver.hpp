@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include "pros/serial.hpp"
 #include "pros/error.h"
 #include "serialDriver.hpp"
@@ -25,6 +26,13 @@ extern "C"
      * @return The character read or -1 if no character is available.
      */
     int32_t vexSerialReadChar(uint32_t channel);
+
+    /**
+     * Gets the free space in the transmit buffer of the serial port.
+     * @param channel The channel to check. Use 1 for stdout.
+     * @return The number of bytes that can be written.
+     */
+    int32_t vexSerialWriteFree(uint32_t channel);
 }
 
 namespace vexbridge::serial
@@ -39,46 +47,82 @@ namespace vexbridge::serial
         {
         }
 
-        bool write(Buffer &buffer)
+        bool write(Buffer &buffer) override
+        {
+            return write(std::span<const uint8_t>(buffer));
+        }
+
+        bool write(std::span<const uint8_t> bytes) override
         {
             // Grab the mutex
-            mutex.take(0);
+            // Waits, since giving a mutex that was never taken would release another task's lock
+            mutex.take();
 
             // Write packet to USB
-            int32_t writeRes = vexSerialWriteBuffer(1, buffer.data(), buffer.size());
-            if (writeRes < 0)
-                return false;
+            int32_t writeRes = vexSerialWriteBuffer(1, (uint8_t *)bytes.data(), bytes.size());
 
             // Release the mutex
             mutex.give();
-            return true;
+
+            // Update counters
+            sdkCalls.fetch_add(1, std::memory_order_relaxed);
+            if (writeRes > 0)
+                bytesWritten.fetch_add(writeRes, std::memory_order_relaxed);
+            return writeRes >= 0;
         }
 
-        int32_t read(Buffer &buffer) override
+        using SerialDriver::read;
+
+        int32_t read(std::span<uint8_t> output) override
         {
             // Grab the mutex
-            mutex.take(0);
+            mutex.take();
 
-            // Iterate over all available characters
-            while (true)
+            // Read characters directly into the output until it is full or the SDK runs out
+            // The SDK only reads one character per call, so the output size also bounds the number of calls
+            size_t bytesRead = 0;
+            uint32_t calls = 0;
+            while (bytesRead < output.size())
             {
-                // Read a single character from the serial port
                 int32_t charRead = vexSerialReadChar(1);
+                calls++;
                 if (charRead < 0)
                     break;
-
-                // Add the character to the buffer
-                buffer.push_back((uint8_t)charRead);
+                output[bytesRead++] = (uint8_t)charRead;
             }
 
             // Release the mutex
             mutex.give();
 
+            // Update counters
+            sdkCalls.fetch_add(calls, std::memory_order_relaxed);
+            this->bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+
             // Return the number of bytes read
-            return buffer.size();
+            return bytesRead;
+        }
+
+        int32_t getWriteFree() override
+        {
+            sdkCalls.fetch_add(1, std::memory_order_relaxed);
+            return vexSerialWriteFree(1);
+        }
+
+        SerialDriverStats getStats() const override
+        {
+            SerialDriverStats stats;
+            stats.bytesRead = bytesRead.load(std::memory_order_relaxed);
+            stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+            stats.sdkCalls = sdkCalls.load(std::memory_order_relaxed);
+            return stats;
         }
 
     private:
         pros::Mutex mutex;
+
+        // Counters
+        std::atomic<uint32_t> bytesRead = 0;
+        std::atomic<uint32_t> bytesWritten = 0;
+        std::atomic<uint32_t> sdkCalls = 0;
     };
 }
\ No newline at end of file
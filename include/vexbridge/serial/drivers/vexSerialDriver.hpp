@@ -4,6 +4,7 @@
 #include "pros/error.h"
 #include "serialDriver.hpp"
 #include <cmath>
+#include <algorithm>
 #include "../../utils/buffer.h"
 
 using namespace vexbridge::utils;
@@ -44,26 +45,24 @@ namespace vexbridge::serial
             return true;
         }
 
-        int32_t read(Buffer &buffer) override
+        using SerialDriver::read;
+
+        int32_t read(std::span<uint8_t> output) override
         {
             // Check if there is data to read
             int32_t readBufferSize = serial.get_read_avail();
             if (readBufferSize == PROS_ERR)
                 return -1;
 
-            // Allocate buffer space
-            buffer.resize(readBufferSize);
-
-            // Read data from the serial port
-            int32_t bytesRead = serial.read(buffer.data(), readBufferSize);
+            // Read as much data as fits
+            // The rest remains in the receive buffer for the next read
+            int32_t readSize = std::min((size_t)readBufferSize, output.size());
+            if (readSize == 0)
+                return 0;
+            int32_t bytesRead = serial.read(output.data(), readSize);
             if (bytesRead == PROS_ERR)
                 return -1;
 
-            // Flush the serial port
-            int32_t flushRes = serial.flush();
-            if (flushRes == PROS_ERR)
-                return -1;
-
             // Return the number of bytes read
             return bytesRead;
         }
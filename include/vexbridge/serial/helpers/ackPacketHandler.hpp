@@ -4,6 +4,7 @@
 #include <deque>
 #include <memory>
 #include "../packetTypes/genericAckPacket.hpp"
+#include "../packetTypes/selectiveAckPacket.hpp"
 #include "../serialization/serialPacketWriter.hpp"
 
 namespace vexbridge::serial
@@ -11,8 +12,8 @@ namespace vexbridge::serial
     struct AckPacketHandler
     {
         /**
-         * Checks if a packet is an `GenericAckPacket`.
-         * If it is, it will inform the `SerialPacketWriter` to remove the packet from the sent packets list.
+         * Checks if a packet is an `GenericAckPacket` or `SelectiveAckPacket`.
+         * If it is, it will inform the `SerialPacketWriter` to remove the acknowledged packets from the send window.
          * @param newPacket The packet to handle.
          * @param serialWriter The serial writer to use for writing packets.
          */
@@ -29,6 +30,10 @@ namespace vexbridge::serial
             // Check if the packet is a `GenericAckPacket`
             if (auto ackPacket = dynamic_cast<GenericAckPacket *>(newPacket))
                 serialWriter->ackPacket(ackPacket->id);
+
+            // Check if the packet is a `SelectiveAckPacket`
+            else if (auto selectiveAckPacket = dynamic_cast<SelectiveAckPacket *>(newPacket))
+                serialWriter->ackPackets(selectiveAckPacket->cumulativeSeq, selectiveAckPacket->receivedBitmap);
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../../table/labelTable.hpp"
+#include "../../table/valueTable.hpp"
+#include "../packetTypes/batchPacketV2.hpp"
+#include "../packetTypes/fetchValuesPacket.hpp"
+#include "../serialization/serialPacketWriter.hpp"
+
+using namespace vexbridge::table;
+
+namespace vexbridge::serial
+{
+    /**
+     * Progress of a snapshot that is sent a few batches at a time.
+     */
+    struct SnapshotProgress
+    {
+        /// @brief Every label and its ID when the snapshot was requested
+        std::vector<std::pair<uint16_t, std::string>> labels;
+
+        /// @brief Index of the next label to send
+        size_t nextIndex = 0;
+
+        /**
+         * Checks if every label of the snapshot was sent.
+         * @return True if the snapshot is complete, false otherwise.
+         */
+        bool isComplete() const
+        {
+            return nextIndex >= labels.size();
+        }
+    };
+
+    struct FetchValuesPacketHandler
+    {
+        /**
+         * Checks if a packet is a `FetchValuesPacket` or a `ResetPacket`.
+         * If it is, a snapshot of every label and value is started, so a host that reconnected catches up
+         * instead of waiting for each value to change. A snapshot that was still being sent starts over.
+         * Must be handled after `ResetPacketHandler`, so the snapshot uses the agreed checksum.
+         * @param newPacket The packet to handle.
+         * @param serialWriter The serial writer to send the snapshot with.
+         * @param snapshot The progress of the snapshot. Reset to the current labels.
+         */
+        static void handlePacket(SerialPacket *newPacket, SerialPacketWriter *serialWriter, SnapshotProgress &snapshot)
+        {
+            // Check if the `SerialWriter` is nullptr
+            if (!serialWriter)
+                throw std::runtime_error("Cannot handle a packet with a nullptr serial writer.");
+
+            // Check if the packet requests a snapshot
+            if (newPacket->type != SerialPacketTypeID::FETCH_VALUES && newPacket->type != SerialPacketTypeID::RESET)
+                return;
+
+            // A host that resyncs may have lost the array versions it acknowledged
+            // `ResetPacketHandler` already did this for a `ResetPacket`
+            if (newPacket->type == SerialPacketTypeID::FETCH_VALUES)
+                serialWriter->resetArrayBaselines();
+
+            snapshot.labels = LabelTable::getAll();
+            snapshot.nextIndex = 0;
+            continueSnapshot(serialWriter, snapshot);
+        }
+
+        /**
+         * Sends the next labels of a snapshot and their current values as `BatchPacketV2` packets.
+         * Batches are only sent while the send window has room to spare, so the snapshot never queues
+         * reliable packets behind it and leaves slots for live updates. The rest is sent on a later call.
+         * Each label entry is followed by the value it names, so the receiver can apply both in order.
+         * @param serialWriter The serial writer to send the snapshot with.
+         * @param snapshot The progress of the snapshot. Advanced past every label that was sent.
+         */
+        static void continueSnapshot(SerialPacketWriter *serialWriter, SnapshotProgress &snapshot)
+        {
+            if (snapshot.isComplete())
+                return;
+
+            size_t freeSlotCount = serialWriter->getFreeSlotCount();
+            while (!snapshot.isComplete() && freeSlotCount > RESERVED_SLOTS)
+            {
+                // Fill a batch up to the split size
+                auto batchPacket = makePacket<BatchPacketV2>();
+                while (!snapshot.isComplete() && batchPacket->entries.size() < MAX_BATCH_BYTES)
+                {
+                    auto &[valueID, label] = snapshot.labels[snapshot.nextIndex++];
+                    const std::string *schema = ValueTable::getSchema(valueID);
+                    batchPacket->addLabel(valueID, label, schema ? *schema : "");
+                    addValue(*batchPacket, valueID);
+                }
+                writeBatch(serialWriter, std::move(batchPacket));
+                freeSlotCount--;
+            }
+
+            // Release the copied labels once they are all sent
+            if (snapshot.isComplete())
+                snapshot.labels = {};
+        }
+
+    private:
+        /// @brief Size of the serialized entries at which a batch is split
+        static constexpr size_t MAX_BATCH_BYTES = 1024;
+
+        /// @brief Number of send window slots the snapshot leaves free for live updates
+        static constexpr size_t RESERVED_SLOTS = 16;
+
+        /**
+         * Sends a batch of the snapshot.
+         * @param serialWriter The serial writer to send the batch with.
+         * @param batchPacket The batch to send.
+         */
+        static void writeBatch(SerialPacketWriter *serialWriter, std::shared_ptr<BatchPacketV2> batchPacket)
+        {
+            batchPacket->type = SerialPacketTypeID::BATCH_PACKET_V2;
+            serialWriter->sendPacket(std::move(batchPacket));
+        }
+
+        /**
+         * Appends the current value of an ID to a batch.
+         * IDs that were never set are skipped, as are values that changed type since their type was read.
+         * The label entry still reaches the receiver, and the value follows with its next update.
+         * @param batchPacket The batch to append to.
+         * @param valueID The ID of the value.
+         */
+        static void addValue(BatchPacketV2 &batchPacket, uint16_t valueID)
+        {
+            switch (ValueTable::getType(valueID))
+            {
+            case ValueType::BOOL:
+                return addValueOf<bool>(batchPacket, valueID);
+            case ValueType::INT:
+                return addValueOf<int>(batchPacket, valueID);
+            case ValueType::FLOAT:
+                return addValueOf<float>(batchPacket, valueID);
+            case ValueType::DOUBLE:
+                return addValueOf<double>(batchPacket, valueID);
+            case ValueType::STRING:
+                return addValueOf<std::string>(batchPacket, valueID);
+            case ValueType::RECORD:
+                return addValueOf<Buffer>(batchPacket, valueID);
+            case ValueType::BOOL_ARRAY:
+                return addValueOf<std::vector<bool>>(batchPacket, valueID);
+            case ValueType::INT_ARRAY:
+                return addValueOf<std::vector<int>>(batchPacket, valueID);
+            case ValueType::FLOAT_ARRAY:
+                return addValueOf<std::vector<float>>(batchPacket, valueID);
+            case ValueType::DOUBLE_ARRAY:
+                return addValueOf<std::vector<double>>(batchPacket, valueID);
+            default:
+                return;
+            }
+        }
+
+        /**
+         * Appends the current value of an ID to a batch if it is still of a type.
+         * @param batchPacket The batch to append to.
+         * @param valueID The ID of the value.
+         */
+        template <typename T>
+        static void addValueOf(BatchPacketV2 &batchPacket, uint16_t valueID)
+        {
+            T value{};
+            if (ValueTable::tryGet(valueID, value))
+                batchPacket.addValue(valueID, value);
+        }
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include "pros/rtos.hpp"
+#include "../packetTypes/pingPacket.hpp"
+#include "../serialization/serialPacketWriter.hpp"
+#include "../../utils/clockSync.hpp"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    struct PingPacketHandler
+    {
+        /**
+         * Checks if a packet is a `PingPacket`.
+         * If it is a request, it will reply with the times it was received and sent.
+         * If it is a reply, it will add the exchange to the clock estimate.
+         * @param newPacket The packet to handle.
+         * @param serialWriter The serial writer to reply with.
+         * @param clockSync The clock estimate of the link.
+         * @param receiveTime The time the packet was received in microseconds.
+         */
+        static void handlePacket(SerialPacket *newPacket, SerialPacketWriter *serialWriter, ClockSync &clockSync, uint64_t receiveTime)
+        {
+            auto pingPacket = dynamic_cast<PingPacket *>(newPacket);
+            if (!pingPacket)
+                return;
+
+            // Add the exchange to the estimate
+            if (pingPacket->isReply)
+            {
+                clockSync.addSample(pingPacket->originTime, pingPacket->receiveTime, pingPacket->transmitTime, receiveTime);
+                return;
+            }
+
+            // Check if the `SerialWriter` is nullptr
+            if (!serialWriter)
+                throw std::runtime_error("Cannot handle a packet with a nullptr serial writer.");
+
+            // Reply to the request
+            // The transmit time is taken last, so time spent handling the request is not counted as link delay
+            auto replyPacket = makePacket<PingPacket>();
+            replyPacket->type = SerialPacketTypeID::PING;
+            replyPacket->flags = SerialPacketFlag::NO_ACK;
+            replyPacket->isReply = true;
+            replyPacket->originTime = pingPacket->originTime;
+            replyPacket->receiveTime = receiveTime;
+            replyPacket->transmitTime = pros::micros();
+            serialWriter->sendPacket(replyPacket);
+        }
+
+        /**
+         * Sends a request to measure the clock offset and round-trip time of a link.
+         * The reply is handled by `handlePacket`.
+         * @param serialWriter The serial writer to send the request with.
+         */
+        static void sendRequest(SerialPacketWriter *serialWriter)
+        {
+            auto requestPacket = makePacket<PingPacket>();
+            requestPacket->type = SerialPacketTypeID::PING;
+            requestPacket->flags = SerialPacketFlag::NO_ACK;
+            requestPacket->originTime = pros::micros();
+            serialWriter->sendPacket(requestPacket);
+        }
+    };
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include "pros/rtos.hpp"
+#include "../../table/valueTable.hpp"
+#include "../packetTypes/updateQuantizedArrayPacket.hpp"
+
+using namespace vexbridge::table;
+
+namespace vexbridge::serial
+{
+    struct QuantizedArrayPacketHandler
+    {
+        /**
+         * Checks if a packet is an `UpdateQuantizedArrayPacket`.
+         * If it is, it will apply it to the last received version and update the value table.
+         * Deltas against a version that was not received are dropped until the next keyframe.
+         * @param newPacket The packet to handle.
+         * @param captureTime The time the array was captured in microseconds.
+         */
+        static void handlePacket(SerialPacket *newPacket, uint64_t captureTime)
+        {
+            auto arrayPacket = dynamic_cast<UpdateQuantizedArrayPacket *>(newPacket);
+            if (!arrayPacket)
+                return;
+
+            mutex.take();
+
+            // Check the delta applies to the version we have
+            ArrayState &state = arrayStates[arrayPacket->valueID];
+            bool isApplicable = arrayPacket->isKeyframe() ||
+                                (state.hasVersion &&
+                                 state.version == arrayPacket->baseVersion &&
+                                 state.scale == arrayPacket->scale);
+            if (isApplicable)
+            {
+                // Apply the changed ranges
+                state.values.resize(arrayPacket->length);
+                for (const QuantizedArrayRange &range : arrayPacket->ranges)
+                    std::copy(range.values.begin(), range.values.end(), state.values.begin() + range.start);
+
+                state.version = arrayPacket->version;
+                state.scale = arrayPacket->scale;
+                state.hasVersion = true;
+
+                // Update the value table with the original array type
+                if (arrayPacket->arrayType == SerialPacketTypeID::UPDATE_DOUBLE_ARRAY)
+                    ValueTable::set(arrayPacket->valueID, dequantize<double>(state), captureTime);
+                else
+                    ValueTable::set(arrayPacket->valueID, dequantize<float>(state), captureTime);
+            }
+
+            mutex.give();
+        }
+
+    private:
+        /**
+         * Last received version of an array.
+         */
+        struct ArrayState
+        {
+            std::vector<int16_t> values;
+            float scale = 1;
+            uint16_t version = 0;
+            bool hasVersion = false;
+        };
+
+        /**
+         * Converts a quantized array back to its original type.
+         * @param state The quantized array.
+         * @return The array values.
+         */
+        template <typename T>
+        static std::vector<T> dequantize(const ArrayState &state)
+        {
+            std::vector<T> values;
+            values.reserve(state.values.size());
+            for (int16_t value : state.values)
+                values.push_back((T)value * state.scale);
+            return values;
+        }
+
+        /// @brief Last received version of each array, indexed by value ID
+        static inline std::unordered_map<uint16_t, ArrayState> arrayStates;
+
+        /// @brief Mutex for synchronizing access to the array states
+        static inline pros::Mutex mutex;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include "../packetTypes/resetPacket.hpp"
+#include "../serialization/serialPacketWriter.hpp"
+#include "../../utils/checksum.hpp"
+
+namespace vexbridge::serial
+{
+    struct ResetPacketHandler
+    {
+        /// @brief Checksums this side can check, sent in our `ResetPacket`
+        static constexpr uint8_t SUPPORTED_CHECKSUMS = (1 << (uint8_t)ChecksumType::SUM8) |
+                                                       (1 << (uint8_t)ChecksumType::CRC16) |
+                                                       (1 << (uint8_t)ChecksumType::CRC32);
+
+        /**
+         * Checks if a packet is a `ResetPacket`.
+         * A `ResetPacket` that is not a reply is answered with our own, so the peer learns our checksums too.
+         * Both directions then switch to the strongest checksum supported by both sides,
+         * and arrays are sent as keyframes again, since the receiver starts over without them.
+         * @param newPacket The packet to handle.
+         * @param serialWriter The serial writer to use for writing packets.
+         * @param checksumType The checksum used by the reader. Set to the agreed checksum.
+         */
+        static void handlePacket(SerialPacket *newPacket, SerialPacketWriter *serialWriter, ChecksumType &checksumType)
+        {
+            // Check if the `SerialWriter` is nullptr
+            if (!serialWriter)
+                throw std::runtime_error("Cannot handle a packet with a nullptr serial writer.");
+
+            // Check if the packet is a `ResetPacket`
+            auto resetPacket = dynamic_cast<ResetPacket *>(newPacket);
+            if (!resetPacket)
+                return;
+
+            // Reply with our own checksums
+            // The peer sends its `ResetPacket` again if the reply is lost
+            // `ResetPacket`s are always checked with `ChecksumType::SUM8`, so the switch below does not affect the reply
+            if (!resetPacket->isReply)
+                sendReply(serialWriter);
+
+            // Pick the strongest shared checksum
+            checksumType = getSharedChecksum(resetPacket->supportedChecksums);
+            serialWriter->setChecksumType(checksumType);
+            serialWriter->resetArrayBaselines();
+        }
+
+        /**
+         * Picks the strongest checksum supported by both sides.
+         * @param peerChecksums The checksums advertised in the peer's `ResetPacket`.
+         * @return The agreed checksum. `ChecksumType::SUM8` if nothing stronger is shared.
+         */
+        static ChecksumType getSharedChecksum(uint8_t peerChecksums)
+        {
+            uint8_t sharedChecksums = peerChecksums & SUPPORTED_CHECKSUMS;
+            if (sharedChecksums & (1 << (uint8_t)ChecksumType::CRC32))
+                return ChecksumType::CRC32;
+            if (sharedChecksums & (1 << (uint8_t)ChecksumType::CRC16))
+                return ChecksumType::CRC16;
+            return ChecksumType::SUM8;
+        }
+
+    private:
+        /**
+         * Answers the peer's `ResetPacket` with our own.
+         * @param serialWriter The serial writer to send the reply with.
+         */
+        static void sendReply(SerialPacketWriter *serialWriter)
+        {
+            auto replyPacket = makePacket<ResetPacket>();
+            replyPacket->type = SerialPacketTypeID::RESET;
+            replyPacket->flags = SerialPacketFlag::NO_ACK;
+            replyPacket->isReply = true;
+            replyPacket->supportedChecksums = SUPPORTED_CHECKSUMS;
+            serialWriter->sendPacket(replyPacket);
+        }
+    };
+}
\ No newline at end of file
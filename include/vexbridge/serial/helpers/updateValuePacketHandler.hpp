@@ -10,10 +10,12 @@
 #include "../packetTypes/updateFloatPacket.hpp"
 #include "../packetTypes/updateDoublePacket.hpp"
 #include "../packetTypes/updateStringPacket.hpp"
+#include "../packetTypes/updateRecordPacket.hpp"
 #include "../packetTypes/updateBoolArrayPacket.hpp"
 #include "../packetTypes/updateIntArrayPacket.hpp"
 #include "../packetTypes/updateFloatArrayPacket.hpp"
 #include "../packetTypes/updateDoubleArrayPacket.hpp"
+#include "../serialization/allPacketTypes.hpp"
 
 using namespace vexbridge::table;
 
@@ -25,31 +27,95 @@ namespace vexbridge::serial
          * Checks if a packet is an `UpdateValuePacket`.
          * If it is, it will update its value in the value table.
          * @param newPacket The new packet to update.
+         * @param captureTime The time the value was captured in microseconds. Batched values share the time of their batch.
          */
-        static void handlePacket(SerialPacket *newPacket)
+        static void handlePacket(SerialPacket *newPacket, uint64_t captureTime)
         {
-            tryUpdateValue<UpdateBoolPacket, bool>(newPacket);
-            tryUpdateValue<UpdateIntPacket, int>(newPacket);
-            tryUpdateValue<UpdateFloatPacket, float>(newPacket);
-            tryUpdateValue<UpdateDoublePacket, double>(newPacket);
-            tryUpdateValue<UpdateStringPacket, std::string>(newPacket);
-            tryUpdateValue<UpdateBoolArrayPacket, std::vector<bool>>(newPacket);
-            tryUpdateValue<UpdateIntArrayPacket, std::vector<int>>(newPacket);
-            tryUpdateValue<UpdateFloatArrayPacket, std::vector<float>>(newPacket);
-            tryUpdateValue<UpdateDoubleArrayPacket, std::vector<double>>(newPacket);
+            // Unpack batches into their sub-packets
+            if (auto batchPacket = dynamic_cast<BatchPacket *>(newPacket))
+            {
+                for (auto &subPacket : batchPacket->subPackets)
+                    handlePacket(subPacket.get(), captureTime);
+                return;
+            }
+
+            // Apply mixed batches directly from their serialized entries
+            if (auto batchPacket = dynamic_cast<BatchPacketV2 *>(newPacket))
+            {
+                batchPacket->forEachEntry([captureTime](SerialPacketTypeID type, uint16_t valueID, BufferReader &reader)
+                                          { applyBatchEntry(type, valueID, reader, captureTime); });
+                return;
+            }
+
+            tryUpdateValue<UpdateBoolPacket, bool>(newPacket, captureTime);
+            tryUpdateValue<UpdateIntPacket, int>(newPacket, captureTime);
+            tryUpdateValue<UpdateFloatPacket, float>(newPacket, captureTime);
+            tryUpdateValue<UpdateDoublePacket, double>(newPacket, captureTime);
+            tryUpdateValue<UpdateStringPacket, std::string>(newPacket, captureTime);
+            tryUpdateValue<UpdateRecordPacket, Buffer>(newPacket, captureTime);
+            tryUpdateValue<UpdateBoolArrayPacket, std::vector<bool>>(newPacket, captureTime);
+            tryUpdateValue<UpdateIntArrayPacket, std::vector<int>>(newPacket, captureTime);
+            tryUpdateValue<UpdateFloatArrayPacket, std::vector<float>>(newPacket, captureTime);
+            tryUpdateValue<UpdateDoubleArrayPacket, std::vector<double>>(newPacket, captureTime);
         }
 
     private:
+        /**
+         * Updates the value of a single `BatchPacketV2` entry in the value table.
+         * Entries of unknown types are skipped.
+         * @param type The update packet type ID of the entry.
+         * @param valueID The ID of the value.
+         * @param reader The reader positioned at the value.
+         * @param captureTime The time the value was captured in microseconds.
+         */
+        static void applyBatchEntry(SerialPacketTypeID type, uint16_t valueID, BufferReader &reader, uint64_t captureTime)
+        {
+            switch (type)
+            {
+            case SerialPacketTypeID::UPDATE_BOOL:
+                return applyBatchValue<bool>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_INT:
+                return applyBatchValue<int>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_FLOAT:
+                return applyBatchValue<float>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_DOUBLE:
+                return applyBatchValue<double>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_STRING:
+                return applyBatchValue<std::string>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_RECORD:
+                return applyBatchValue<Buffer>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_BOOL_ARRAY:
+                return applyBatchValue<std::vector<bool>>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_INT_ARRAY:
+                return applyBatchValue<std::vector<int>>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_FLOAT_ARRAY:
+                return applyBatchValue<std::vector<float>>(valueID, reader, captureTime);
+            case SerialPacketTypeID::UPDATE_DOUBLE_ARRAY:
+                return applyBatchValue<std::vector<double>>(valueID, reader, captureTime);
+            default:
+                return;
+            }
+        }
+
+        template <typename T>
+        static void applyBatchValue(uint16_t valueID, BufferReader &reader, uint64_t captureTime)
+        {
+            T value;
+            BatchPacketV2::readValue(reader, value);
+            ValueTable::set(valueID, value, captureTime);
+        }
+
         /**
          * Tries to update the value of a packet depending on its type.
          * This is necessary since C++ does not support dynamic casting of templated types.
          * @param serialPacket The packet to update the value of.
+         * @param captureTime The time the value was captured in microseconds.
          */
         template <typename T, typename U>
-        static void tryUpdateValue(SerialPacket *serialPacket)
+        static void tryUpdateValue(SerialPacket *serialPacket, uint64_t captureTime)
         {
             if (auto updatePacket = dynamic_cast<UpdateValuePacket<U> *>(serialPacket))
-                ValueTable::set(updatePacket->valueID, updatePacket->newValue);
+                ValueTable::set(updatePacket->valueID, updatePacket->newValue, captureTime);
         }
     };
 }
\ No newline at end of file
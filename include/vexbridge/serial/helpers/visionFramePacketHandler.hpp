@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include "../../table/visionFrameTable.hpp"
+#include "../packetTypes/visionFramePacket.hpp"
+
+using namespace vexbridge::table;
+
+namespace vexbridge::serial
+{
+    struct VisionFramePacketHandler
+    {
+        /**
+         * Checks if a packet is a `VisionFramePacket`.
+         * If it is, it will replace the frame of its ID in the vision frame table.
+         * The capture time is moved to this clock by subtracting the frame age from the time the packet was stamped.
+         * Frames older than this clock are dropped.
+         * @param newPacket The packet to handle.
+         * @param stampTime The time the packet was stamped by the sender, or received if it has no timestamp, in microseconds.
+         */
+        static void handlePacket(SerialPacket *newPacket, uint64_t stampTime)
+        {
+            auto framePacket = dynamic_cast<VisionFramePacket *>(newPacket);
+            if (!framePacket)
+                return;
+
+            // Drop frames captured before this clock started, since their capture time would wrap around
+            uint64_t stampMillis = stampTime / 1000;
+            if (framePacket->frameAge > stampMillis)
+                return;
+
+            // Move the targets out of the packet, since it is discarded after handling
+            VisionFrame frame;
+            frame.frameNumber = framePacket->frameNumber;
+            frame.sourceCaptureTime = framePacket->captureTime;
+            frame.captureTime = stampMillis - framePacket->frameAge;
+            frame.targets.swap(framePacket->targets);
+
+            VisionFrameTable::set(framePacket->valueID, frame);
+        }
+    };
+}
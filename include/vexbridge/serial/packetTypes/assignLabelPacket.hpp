@@ -16,6 +16,10 @@ namespace vexbridge::serial
     {
         uint16_t valueID;
         std::string label;
+
+        /// @brief Schema of the record, from `RecordCodec::getSchema`, or empty if the value is not a record.
+        /// Only written when set, so receivers that do not know records ignore it.
+        std::string schema;
     };
 
     struct AssignLabelPacketType : public SerialPacketType
@@ -35,28 +39,21 @@ namespace vexbridge::serial
             BufferReader reader(packet.payload);
             newPacket->valueID = reader.readUInt16BE();
             newPacket->label = reader.readString8();
+            if (reader.hasData())
+                newPacket->schema = reader.readString16();
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
             // Cast packet to update value packet
             const AssignLabelPacket &updateLabelPacket = dynamic_cast<const AssignLabelPacket &>(packet);
 
-            // Allocate buffer for payload
-            Buffer payload;
-            BufferWriter writer(payload);
-
             // Write value
             writer.writeUInt16BE(updateLabelPacket.valueID);
             writer.writeString8(updateLabelPacket.label);
-
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            newPacket->payload = payload;
-            return newPacket;
+            if (!updateLabelPacket.schema.empty())
+                writer.writeString16(updateLabelPacket.schema);
         }
     };
 }
\ No newline at end of file
@@ -2,15 +2,19 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
+#include <memory>
 #include "common/serialPacket.h"
 #include "common/serialPacketType.h"
 #include "common/encodedSerialPacket.h"
 #include "../../utils/bufferWriter.hpp"
 #include "../../utils/bufferReader.hpp"
-#include "../serialization/serialPacketDecoder.hpp"
 
 using namespace vexbridge::utils;
 
+// `BatchPacketType` requires `AllPacketTypes` to be declared.
+// Include "serialization/allPacketTypes.hpp" rather than this file directly.
+
 namespace vexbridge::serial
 {
     struct BatchPacket : public SerialPacket
@@ -52,8 +56,8 @@ namespace vexbridge::serial
                 // Read the length of the sub packet
                 uint16_t subPacketLength = reader.readUInt8();
 
-                // Read the sub packet payload
-                tempPacket.payload = reader.readBytes(subPacketLength);
+                // View the sub packet payload in place
+                tempPacket.payload = reader.readSpan(subPacketLength);
 
                 // Split the payload into buffer for the sub packet
                 auto subPacket = packetType->deserialize(tempPacket);
@@ -63,15 +67,11 @@ namespace vexbridge::serial
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
             // Cast packet to batch packet
             const BatchPacket &batchPacket = dynamic_cast<const BatchPacket &>(packet);
 
-            // Allocate buffer for payload
-            Buffer payload;
-            BufferWriter writer(payload);
-
             // Write value
             writer.writeUInt8((uint8_t)batchPacket.subType);
 
@@ -83,22 +83,16 @@ namespace vexbridge::serial
             // Serialize sub packets
             for (const auto &subPacket : batchPacket.subPackets)
             {
-                // Serialize the sub packet
-                auto encodedSubPacket = packetType->serialize(*subPacket.get());
+                // Reserve the length of the sub packet
+                size_t lengthOffset = writer.getOffset();
+                writer.writeUInt8(0);
 
-                // Write the length of the sub packet
-                writer.writeUInt8(encodedSubPacket->payload.size());
+                // Serialize the sub packet payload in place
+                packetType->serializePayload(*subPacket.get(), writer);
 
-                // Write the sub packet payload
-                writer.writeBytes(encodedSubPacket->payload, encodedSubPacket->payload.size());
+                // Write the length of the sub packet
+                writer.setUInt8(lengthOffset, writer.getOffset() - lengthOffset - 1);
             }
-
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            newPacket->payload = payload;
-            return newPacket;
         }
     };
 }
\ No newline at end of file
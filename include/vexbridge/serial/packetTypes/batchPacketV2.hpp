@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/serialPacket.h"
+#include "common/serialPacketType.h"
+#include "common/encodedSerialPacket.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/bufferReader.hpp"
+#include "updateBoolPacket.hpp"
+#include "updateIntPacket.hpp"
+#include "updateFloatPacket.hpp"
+#include "updateDoublePacket.hpp"
+#include "updateStringPacket.hpp"
+#include "updateRecordPacket.hpp"
+#include "updateBoolArrayPacket.hpp"
+#include "updateIntArrayPacket.hpp"
+#include "updateFloatArrayPacket.hpp"
+#include "updateDoubleArrayPacket.hpp"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * Maps a value type to the packet type that serializes it.
+     */
+    template <typename T>
+    struct UpdatePacketTypeOf;
+
+    template <>
+    struct UpdatePacketTypeOf<bool>
+    {
+        using Type = UpdateBoolPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_BOOL;
+    };
+    template <>
+    struct UpdatePacketTypeOf<int>
+    {
+        using Type = UpdateIntPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_INT;
+    };
+    template <>
+    struct UpdatePacketTypeOf<float>
+    {
+        using Type = UpdateFloatPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_FLOAT;
+    };
+    template <>
+    struct UpdatePacketTypeOf<double>
+    {
+        using Type = UpdateDoublePacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_DOUBLE;
+    };
+    template <>
+    struct UpdatePacketTypeOf<std::string>
+    {
+        using Type = UpdateStringPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_STRING;
+    };
+    template <>
+    struct UpdatePacketTypeOf<Buffer>
+    {
+        using Type = UpdateRecordPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_RECORD;
+    };
+    template <>
+    struct UpdatePacketTypeOf<std::vector<bool>>
+    {
+        using Type = UpdateBoolArrayPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_BOOL_ARRAY;
+    };
+    template <>
+    struct UpdatePacketTypeOf<std::vector<int>>
+    {
+        using Type = UpdateIntArrayPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_INT_ARRAY;
+    };
+    template <>
+    struct UpdatePacketTypeOf<std::vector<float>>
+    {
+        using Type = UpdateFloatArrayPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_FLOAT_ARRAY;
+    };
+    template <>
+    struct UpdatePacketTypeOf<std::vector<double>>
+    {
+        using Type = UpdateDoubleArrayPacketType;
+        static constexpr SerialPacketTypeID ID = SerialPacketTypeID::UPDATE_DOUBLE_ARRAY;
+    };
+
+    /**
+     * A batch of value updates of any type and size.
+     * Each entry is stored as:
+     * - The update packet type ID of the value, or `ASSIGN_LABEL` for a label (uint8_t)
+     * - The value ID (uint16_t BE)
+     * - The length of the value in bytes (varint)
+     * - The value, serialized the same as its update packet. Arrays use a varint element count.
+     *   Labels are serialized the same as a string value, followed by the record schema (String16) for records.
+     *
+     * Entries are kept serialized and read in place with `forEachEntry`.
+     */
+    struct BatchPacketV2 : public SerialPacket
+    {
+        /// @brief Serialized entries
+        Buffer entries;
+
+        /**
+         * Appends a value update to the batch.
+         * @param valueID The ID of the value.
+         * @param value The new value.
+         */
+        template <typename T>
+        void addValue(uint16_t valueID, const T &value)
+        {
+            addEntry(UpdatePacketTypeOf<T>::ID, valueID, [&](BufferWriter &writer)
+                     { writeValue(writer, value); });
+        }
+
+        /**
+         * Appends a label assignment to the batch.
+         * The label is stored the same as a string value, under the `ASSIGN_LABEL` type ID.
+         * Receivers that only read values skip it.
+         * @param valueID The ID of the value.
+         * @param label The label of the value.
+         * @param schema The schema of the record, if the value is a record.
+         * Written after the label, so receivers that only read the label ignore it.
+         */
+        void addLabel(uint16_t valueID, const std::string &label, const std::string &schema = "")
+        {
+            addEntry(SerialPacketTypeID::ASSIGN_LABEL, valueID, [&](BufferWriter &writer)
+                     {
+                         writeValue(writer, label);
+                         if (!schema.empty())
+                             writer.writeString16(schema); });
+        }
+
+        /**
+         * Appends a value update packet to the batch.
+         * @param packet The update packet. Its `type` must match its value type.
+         * @return True if the packet was added, false if it is not a value update.
+         */
+        bool addPacket(const SerialPacket &packet)
+        {
+            switch (packet.type)
+            {
+            case SerialPacketTypeID::UPDATE_BOOL:
+                return addUpdatePacket<bool>(packet);
+            case SerialPacketTypeID::UPDATE_INT:
+                return addUpdatePacket<int>(packet);
+            case SerialPacketTypeID::UPDATE_FLOAT:
+                return addUpdatePacket<float>(packet);
+            case SerialPacketTypeID::UPDATE_DOUBLE:
+                return addUpdatePacket<double>(packet);
+            case SerialPacketTypeID::UPDATE_STRING:
+                return addUpdatePacket<std::string>(packet);
+            case SerialPacketTypeID::UPDATE_RECORD:
+                return addUpdatePacket<Buffer>(packet);
+            case SerialPacketTypeID::UPDATE_BOOL_ARRAY:
+                return addUpdatePacket<std::vector<bool>>(packet);
+            case SerialPacketTypeID::UPDATE_INT_ARRAY:
+                return addUpdatePacket<std::vector<int>>(packet);
+            case SerialPacketTypeID::UPDATE_FLOAT_ARRAY:
+                return addUpdatePacket<std::vector<float>>(packet);
+            case SerialPacketTypeID::UPDATE_DOUBLE_ARRAY:
+                return addUpdatePacket<std::vector<double>>(packet);
+            default:
+                return false;
+            }
+        }
+
+        /**
+         * Calls a function for each entry in the batch.
+         * The function is given a reader over the value alone and the next entry is found using the length,
+         * so the function may skip entries it does not recognize or stop before the end of the value.
+         * @param onEntry Called with the entry type, value ID, and a `BufferReader &` over the value.
+         */
+        template <typename F>
+        void forEachEntry(F onEntry) const
+        {
+            BufferReader reader(entries);
+            while (reader.hasData())
+            {
+                auto type = (SerialPacketTypeID)reader.readUInt8();
+                uint16_t valueID = reader.readUInt16BE();
+                uint32_t valueLength = reader.readVarUInt();
+
+                BufferReader valueReader(reader.readSpan(valueLength));
+                onEntry(type, valueID, valueReader);
+            }
+        }
+
+        /**
+         * Reads a value written by `addValue`.
+         * @param reader The reader positioned at the value.
+         * @param value Set to the value read.
+         */
+        template <typename T>
+        static void readValue(BufferReader &reader, T &value)
+        {
+            static typename UpdatePacketTypeOf<T>::Type packetType;
+            value = packetType.deserializeValue(reader);
+        }
+
+        template <typename T>
+        static void readValue(BufferReader &reader, std::vector<T> &values)
+        {
+            static typename UpdatePacketTypeOf<std::vector<T>>::Type packetType;
+            uint32_t count = reader.readVarUInt();
+            values.clear();
+            values.reserve(std::min<size_t>(count, reader.getBytesAvailable()));
+            for (uint32_t i = 0; i < count && reader.hasData(); i++)
+                values.push_back(packetType.deserializeValue(reader));
+        }
+
+    private:
+        /// @brief Maximum bytes in a varint holding a uint32_t
+        static constexpr size_t MAX_VARINT_SIZE = 5;
+
+        /**
+         * Appends an entry to the batch.
+         * @param type The type ID of the entry.
+         * @param valueID The ID of the value.
+         * @param writeEntryValue Called with a `BufferWriter &` to write the value.
+         */
+        template <typename F>
+        void addEntry(SerialPacketTypeID type, uint16_t valueID, F writeEntryValue)
+        {
+            BufferWriter writer(entries);
+            writer.writeUInt8((uint8_t)type);
+            writer.writeUInt16BE(valueID);
+
+            // Leave room for the longest length, write the value, then close the gap
+            size_t lengthOffset = entries.size();
+            entries.resize(lengthOffset + MAX_VARINT_SIZE);
+            writeEntryValue(writer);
+            uint32_t valueLength = entries.size() - lengthOffset - MAX_VARINT_SIZE;
+
+            uint8_t lengthBytes[MAX_VARINT_SIZE];
+            size_t lengthSize = encodeVarUInt(valueLength, lengthBytes);
+            std::copy(lengthBytes, lengthBytes + lengthSize, entries.begin() + lengthOffset);
+            entries.erase(entries.begin() + lengthOffset + lengthSize, entries.begin() + lengthOffset + MAX_VARINT_SIZE);
+        }
+
+        template <typename T>
+        bool addUpdatePacket(const SerialPacket &packet)
+        {
+            const auto &updatePacket = static_cast<const UpdateValuePacket<T> &>(packet);
+            addValue(updatePacket.valueID, updatePacket.newValue);
+            return true;
+        }
+
+        template <typename T>
+        static void writeValue(BufferWriter &writer, const T &value)
+        {
+            static typename UpdatePacketTypeOf<T>::Type packetType;
+            packetType.serializeValue(writer, value);
+        }
+
+        template <typename T>
+        static void writeValue(BufferWriter &writer, const std::vector<T> &values)
+        {
+            static typename UpdatePacketTypeOf<std::vector<T>>::Type packetType;
+            writer.writeVarUInt(values.size());
+            for (const T &value : values)
+                packetType.serializeValue(writer, value);
+        }
+
+        /**
+         * Encodes a varint into an array.
+         * @param value The value to encode.
+         * @param bytes The output array. Must hold `MAX_VARINT_SIZE` bytes.
+         * @return The number of bytes written.
+         */
+        static size_t encodeVarUInt(uint32_t value, uint8_t *bytes)
+        {
+            size_t length = 0;
+            while (value >= 0x80)
+            {
+                bytes[length++] = (value & 0x7F) | 0x80;
+                value >>= 7;
+            }
+            bytes[length++] = value;
+            return length;
+        }
+    };
+
+    struct BatchPacketV2Type : public SerialPacketType
+    {
+        BatchPacketV2Type() : SerialPacketType(SerialPacketTypeID::BATCH_PACKET_V2)
+        {
+        }
+
+        std::unique_ptr<SerialPacket> deserialize(const EncodedSerialPacket &packet) override
+        {
+            // Make new batch packet
+            // Entries stay serialized until they are read with `forEachEntry`
+            // Copied, since the packet outlives the frame it was read from
+            auto newPacket = std::make_unique<BatchPacketV2>();
+            newPacket->type = packet.type;
+            newPacket->id = packet.id;
+            newPacket->entries.assign(packet.payload.begin(), packet.payload.end());
+            return newPacket;
+        }
+
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
+        {
+            // Entries are already serialized
+            const BatchPacketV2 &batchPacket = dynamic_cast<const BatchPacketV2 &>(packet);
+            writer.writeBytes(batchPacket.entries);
+        }
+    };
+}
@@ -2,10 +2,8 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <span>
 #include "serialPacket.h"
-#include "../../../utils/buffer.h"
-
-using namespace vexbridge::utils;
 
 namespace vexbridge::serial
 {
@@ -14,7 +12,8 @@ namespace vexbridge::serial
      */
     struct EncodedSerialPacket : SerialPacket
     {
-        /// @brief Raw buffer containing the specific packet data unique to the packet type (the payload)
-        Buffer payload;
+        /// @brief View of the specific packet data unique to the packet type (the payload).
+        /// Points into the received frame, so it is only valid while the packet is being deserialized.
+        std::span<const uint8_t> payload;
     };
 }
\ No newline at end of file
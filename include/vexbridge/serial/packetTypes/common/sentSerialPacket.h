@@ -13,6 +13,9 @@ namespace vexbridge::serial
         /// @brief The packet that was sent
         std::shared_ptr<SerialPacket> packet;
 
+        /// @brief Sequence number the packet was sent with
+        uint16_t seq = 0;
+
         /// @brief Timestamp of when the packet was sent
         uint32_t timestamp;
 
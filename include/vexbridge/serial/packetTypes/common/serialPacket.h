@@ -1,10 +1,27 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include "serialPacketTypeID.h"
+#include "../../../utils/blockPool.hpp"
+#include "../../../utils/buffer.h"
 
 namespace vexbridge::serial
 {
+    /**
+     * Bits of the flags field in the packet header.
+     */
+    enum SerialPacketFlag : uint8_t
+    {
+        /// @brief The packet is sent once and must not be acknowledged.
+        /// Its sequence number counts best-effort packets separately and is only used to detect loss.
+        NO_ACK = 1 << 0,
+
+        /// @brief The payload starts with the time the packet's data was captured on the sender's clock.
+        /// Microseconds (uint32_t BE), so it wraps every 71 minutes. See `ClockSync` to move it to the receiver's clock.
+        HAS_TIMESTAMP = 1 << 1,
+    };
+
     /**
      * Represents a packet with it's payload deserialized.
      */
@@ -13,7 +30,41 @@ namespace vexbridge::serial
         // Required for inheritance
         virtual ~SerialPacket() = default;
 
+        // Packets are allocated from the block pool, since one is allocated for every update
+        static void *operator new(size_t size)
+        {
+            return vexbridge::utils::BlockPool::allocate(size);
+        }
+
+        static void operator delete(void *packet, size_t size)
+        {
+            vexbridge::utils::BlockPool::deallocate(packet, size);
+        }
+
         SerialPacketTypeID type = SerialPacketTypeID::UNKNOWN;
-        uint8_t id = 0;
+
+        /// @brief Sequence number of the packet
+        uint16_t id = 0;
+
+        /// @brief Header flag bits. See `SerialPacketFlag`.
+        uint8_t flags = 0;
+
+        /// @brief Time the packet's data was captured on the sender's clock in microseconds. Only sent if `HAS_TIMESTAMP` is set.
+        uint32_t timestamp = 0;
+
+        /// @brief Header and payload serialized by `SerialPacketEncoder::getBody`, shared by every socket and resend
+        mutable std::shared_ptr<const vexbridge::utils::Buffer> encodedBody;
     };
+
+    /**
+     * Creates a shared packet with its reference count in the same block pool allocation.
+     * Use instead of `std::make_shared`, which allocates from the heap.
+     * @tparam T The packet type.
+     * @return The new packet.
+     */
+    template <typename T>
+    std::shared_ptr<T> makePacket()
+    {
+        return std::allocate_shared<T>(vexbridge::utils::PoolAllocator<T>());
+    }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "serialPacketTypeID.h"
 #include "serialPacket.h"
 #include "encodedSerialPacket.h"
+#include "../../../utils/bufferWriter.hpp"
 
 namespace vexbridge::serial
 {
@@ -23,6 +24,13 @@ namespace vexbridge::serial
 
         const SerialPacketTypeID typeID;
         virtual std::unique_ptr<SerialPacket> deserialize(const EncodedSerialPacket &packet) = 0;
-        virtual std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) = 0;
+
+        /**
+         * Serializes a packet's payload directly into a writer.
+         * Used by `SerialPacketEncoder` to write the payload straight into the outgoing frame.
+         * @param packet The packet to serialize.
+         * @param writer The writer to append the payload to.
+         */
+        virtual void serializePayload(const SerialPacket &packet, vexbridge::utils::BufferWriter &writer) = 0;
     };
 }
\ No newline at end of file
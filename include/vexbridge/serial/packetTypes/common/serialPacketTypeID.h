@@ -14,18 +14,24 @@ namespace vexbridge::serial
         PING = 0x05,
         GENERIC_ACK = 0x06,
         GENERIC_NACK = 0x07,
+        SELECTIVE_ACK = 0x08,
 
         UPDATE_BOOL = 0x21,
         UPDATE_INT = 0x22,
         UPDATE_FLOAT = 0x23,
         UPDATE_DOUBLE = 0x24,
         UPDATE_STRING = 0x25,
+        UPDATE_RECORD = 0x26,
 
         UPDATE_BOOL_ARRAY = 0x31,
         UPDATE_INT_ARRAY = 0x32,
         UPDATE_FLOAT_ARRAY = 0x33,
         UPDATE_DOUBLE_ARRAY = 0x34,
+        UPDATE_QUANTIZED_ARRAY = 0x35,
 
+        VISION_FRAME = 0x40,
+
+        BATCH_PACKET_V2 = 0xFE,
         BATCH_PACKET = 0xFF,
     };
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include "common/serialPacket.h"
+#include "common/serialPacketType.h"
+#include "common/encodedSerialPacket.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/bufferReader.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * Sent by the host to request every label and value.
+     * The robot replies with `BatchPacketV2` packets holding a label entry and the current value of every ID.
+     */
+    struct FetchValuesPacket : public SerialPacket
+    {
+    };
+
+    struct FetchValuesPacketType : public SerialPacketType
+    {
+        FetchValuesPacketType() : SerialPacketType(SerialPacketTypeID::FETCH_VALUES)
+        {
+        }
+
+        std::unique_ptr<SerialPacket> deserialize(const EncodedSerialPacket &packet) override
+        {
+            // Make new fetch values packet
+            auto newPacket = std::make_unique<FetchValuesPacket>();
+            newPacket->type = packet.type;
+            newPacket->id = packet.id;
+            return newPacket;
+        }
+
+        void serializePayload(const SerialPacket &, BufferWriter &) override
+        {
+            // No payload
+        }
+    };
+}
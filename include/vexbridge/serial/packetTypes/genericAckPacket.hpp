@@ -29,13 +29,9 @@ namespace vexbridge::serial
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &, BufferWriter &) override
         {
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            return newPacket;
+            // No payload
         }
     };
 }
\ No newline at end of file
@@ -34,24 +34,13 @@ namespace vexbridge::serial
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
             // Cast packet to log packet
             const LogPacket &logPacket = dynamic_cast<const LogPacket &>(packet);
 
-            // Allocate buffer for payload
-            Buffer payload;
-            BufferWriter writer(payload);
-
             // Write message
             writer.writeString16(logPacket.message);
-
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            newPacket->payload = payload;
-            return newPacket;
         }
     };
 }
\ No newline at end of file
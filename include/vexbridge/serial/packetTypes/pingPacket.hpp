@@ -9,8 +9,26 @@
 
 namespace vexbridge::serial
 {
+    /**
+     * NTP-style clock synchronization exchange. Either side may send a request.
+     * The other side replies with the request's origin time and its own receive and transmit times,
+     * and the requester adds the time the reply arrived to estimate the clock offset and round-trip time.
+     * All times are microseconds on the clock of the side that took them. Sent best-effort.
+     * An empty payload reads as a request with an origin time of 0.
+     */
     struct PingPacket : public SerialPacket
     {
+        /// @brief True if the packet replies to a request
+        bool isReply = false;
+
+        /// @brief Time the request was sent, on the requester's clock
+        uint32_t originTime = 0;
+
+        /// @brief Time the request was received, on the replier's clock. 0 in a request.
+        uint32_t receiveTime = 0;
+
+        /// @brief Time the reply was sent, on the replier's clock. 0 in a request.
+        uint32_t transmitTime = 0;
     };
 
     struct PingPacketType : public SerialPacketType
@@ -25,16 +43,26 @@ namespace vexbridge::serial
             auto newPacket = std::make_unique<PingPacket>();
             newPacket->type = packet.type;
             newPacket->id = packet.id;
+
+            // Read packet contents from payload
+            BufferReader reader(packet.payload);
+            newPacket->isReply = reader.readUInt8() != 0;
+            newPacket->originTime = reader.readUInt32BE();
+            newPacket->receiveTime = reader.readUInt32BE();
+            newPacket->transmitTime = reader.readUInt32BE();
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            return newPacket;
+            // Cast packet to ping packet
+            const PingPacket &pingPacket = dynamic_cast<const PingPacket &>(packet);
+
+            // Write packet contents to payload
+            writer.writeUInt8(pingPacket.isReply ? 1 : 0);
+            writer.writeUInt32BE(pingPacket.originTime);
+            writer.writeUInt32BE(pingPacket.receiveTime);
+            writer.writeUInt32BE(pingPacket.transmitTime);
         }
     };
-}
\ No newline at end of file
+}
@@ -6,11 +6,35 @@
 #include "common/encodedSerialPacket.h"
 #include "../../utils/bufferWriter.hpp"
 #include "../../utils/bufferReader.hpp"
+#include "../../utils/checksum.hpp"
+
+using namespace vexbridge::utils;
 
 namespace vexbridge::serial
 {
+    /**
+     * Sent when a serial socket opens.
+     * Advertises the checksums the sender can check, so both sides can switch to the strongest shared one.
+     * The receiver answers with its own `ResetPacket` flagged as a reply. Replies are never answered.
+     * Peers that send an empty payload only support `ChecksumType::SUM8`.
+     */
     struct ResetPacket : public SerialPacket
     {
+        /// @brief Bit `1 << ChecksumType` is set for each supported checksum
+        uint8_t supportedChecksums = 1 << (uint8_t)ChecksumType::SUM8;
+
+        /// @brief True if this packet answers the peer's `ResetPacket`
+        bool isReply = false;
+
+        /**
+         * Checks if the sender supports a checksum.
+         * @param type The checksum algorithm.
+         * @return True if the checksum is supported.
+         */
+        bool supportsChecksum(ChecksumType type) const
+        {
+            return supportedChecksums & (1 << (uint8_t)type);
+        }
     };
 
     struct ResetPacketType : public SerialPacketType
@@ -25,16 +49,24 @@ namespace vexbridge::serial
             auto newPacket = std::make_unique<ResetPacket>();
             newPacket->type = packet.type;
             newPacket->id = packet.id;
+
+            // Read packet contents from payload
+            BufferReader reader(packet.payload);
+            if (reader.hasData())
+                newPacket->supportedChecksums = reader.readUInt8();
+            if (reader.hasData())
+                newPacket->isReply = reader.readUInt8() != 0;
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            return newPacket;
+            // Cast packet to reset packet
+            const ResetPacket &resetPacket = dynamic_cast<const ResetPacket &>(packet);
+
+            // Write packet contents to payload
+            writer.writeUInt8(resetPacket.supportedChecksums);
+            writer.writeUInt8(resetPacket.isReply ? 1 : 0);
         }
     };
 }
\ No newline at end of file
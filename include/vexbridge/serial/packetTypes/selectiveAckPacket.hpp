@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include "common/serialPacket.h"
+#include "common/serialPacketType.h"
+#include "common/encodedSerialPacket.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/bufferReader.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * Acknowledges many packets at once.
+     * Every packet up to and including `cumulativeSeq` was received,
+     * and bit `i` of `receivedBitmap` is set if packet `cumulativeSeq + 1 + i` was received.
+     */
+    struct SelectiveAckPacket : public SerialPacket
+    {
+        uint16_t cumulativeSeq = 0;
+        uint32_t receivedBitmap = 0;
+    };
+
+    struct SelectiveAckPacketType : public SerialPacketType
+    {
+        SelectiveAckPacketType()
+            : SerialPacketType(SerialPacketTypeID::SELECTIVE_ACK)
+        {
+        }
+
+        std::unique_ptr<SerialPacket> deserialize(const EncodedSerialPacket &packet) override
+        {
+            // Make new selective ack packet
+            auto newPacket = std::make_unique<SelectiveAckPacket>();
+            newPacket->type = packet.type;
+            newPacket->id = packet.id;
+
+            // Read packet contents from payload
+            BufferReader reader(packet.payload);
+            newPacket->cumulativeSeq = reader.readUInt16BE();
+            newPacket->receivedBitmap = reader.readUInt32BE();
+            return newPacket;
+        }
+
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
+        {
+            // Cast packet to selective ack packet
+            const SelectiveAckPacket &ackPacket = dynamic_cast<const SelectiveAckPacket &>(packet);
+
+            // Write packet contents to payload
+            writer.writeUInt16BE(ackPacket.cumulativeSeq);
+            writer.writeUInt32BE(ackPacket.receivedBitmap);
+        }
+    };
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "common/serialPacket.h"
+#include "common/serialPacketType.h"
+#include "common/encodedSerialPacket.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/bufferReader.hpp"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * A run of consecutive array elements in an `UpdateQuantizedArrayPacket`.
+     */
+    struct QuantizedArrayRange
+    {
+        /// @brief Index of the first element
+        uint16_t start = 0;
+
+        /// @brief Elements as multiples of the array scale
+        std::vector<int16_t> values;
+    };
+
+    /**
+     * Updates a float or double array using 16-bit fixed-point elements.
+     * Each element is `value * scale`.
+     * A keyframe (`baseVersion == version`) holds every element in a single range.
+     * A delta only holds the ranges that changed since `baseVersion`,
+     * and is dropped by the receiver if it does not have that version.
+     */
+    struct UpdateQuantizedArrayPacket : public SerialPacket
+    {
+        uint16_t valueID = 0;
+
+        /// @brief Array type the values are stored as. Either `UPDATE_FLOAT_ARRAY` or `UPDATE_DOUBLE_ARRAY`.
+        SerialPacketTypeID arrayType = SerialPacketTypeID::UPDATE_FLOAT_ARRAY;
+
+        /// @brief Version of the array after this update
+        uint16_t version = 0;
+
+        /// @brief Version the ranges are applied to. Equal to `version` for a keyframe.
+        uint16_t baseVersion = 0;
+
+        /// @brief Value of one fixed-point step
+        float scale = 1;
+
+        /// @brief Number of elements in the array after this update
+        uint16_t length = 0;
+
+        /// @brief Changed element ranges
+        std::vector<QuantizedArrayRange> ranges;
+
+        /**
+         * Checks if the packet holds every element.
+         * @return True if the packet is a keyframe.
+         */
+        bool isKeyframe() const
+        {
+            return baseVersion == version;
+        }
+    };
+
+    struct UpdateQuantizedArrayPacketType : public SerialPacketType
+    {
+        UpdateQuantizedArrayPacketType() : SerialPacketType(SerialPacketTypeID::UPDATE_QUANTIZED_ARRAY)
+        {
+        }
+
+        std::unique_ptr<SerialPacket> deserialize(const EncodedSerialPacket &packet) override
+        {
+            // Make new quantized array packet
+            auto newPacket = std::make_unique<UpdateQuantizedArrayPacket>();
+            newPacket->type = packet.type;
+            newPacket->id = packet.id;
+
+            // Read packet contents from payload
+            BufferReader reader(packet.payload);
+            newPacket->valueID = reader.readUInt16BE();
+            newPacket->arrayType = (SerialPacketTypeID)reader.readUInt8();
+            newPacket->version = reader.readUInt16BE();
+            newPacket->baseVersion = reader.readUInt16BE();
+            newPacket->scale = reader.readFloatBE();
+            newPacket->length = reader.readUInt16BE();
+
+            // Read ranges
+            uint16_t rangeCount = reader.readUInt16BE();
+            for (uint16_t i = 0; i < rangeCount && reader.hasData(); i++)
+            {
+                QuantizedArrayRange &range = newPacket->ranges.emplace_back();
+                range.start = reader.readUInt16BE();
+                uint16_t valueCount = reader.readUInt16BE();
+                if (range.start + valueCount > newPacket->length)
+                    throw std::runtime_error("Quantized array range out of bounds");
+
+                range.values.reserve(valueCount);
+                for (uint16_t j = 0; j < valueCount; j++)
+                    range.values.push_back((int16_t)reader.readUInt16BE());
+            }
+            return newPacket;
+        }
+
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
+        {
+            // Cast packet to quantized array packet
+            const UpdateQuantizedArrayPacket &arrayPacket = dynamic_cast<const UpdateQuantizedArrayPacket &>(packet);
+
+            // Write packet contents to payload
+            writer.writeUInt16BE(arrayPacket.valueID);
+            writer.writeUInt8((uint8_t)arrayPacket.arrayType);
+            writer.writeUInt16BE(arrayPacket.version);
+            writer.writeUInt16BE(arrayPacket.baseVersion);
+            writer.writeFloatBE(arrayPacket.scale);
+            writer.writeUInt16BE(arrayPacket.length);
+
+            // Write ranges
+            writer.writeUInt16BE(arrayPacket.ranges.size());
+            for (const QuantizedArrayRange &range : arrayPacket.ranges)
+            {
+                writer.writeUInt16BE(range.start);
+                writer.writeUInt16BE(range.values.size());
+                for (int16_t value : range.values)
+                    writer.writeUInt16BE((uint16_t)value);
+            }
+        }
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "common/serialPacket.h"
+#include "common/serialPacketType.h"
+#include "common/encodedSerialPacket.h"
+#include "../../utils/buffer.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/bufferReader.hpp"
+#include "updateValuePacket.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * Updates a struct value in a single packet, so its fields are never seen torn.
+     * The record is packed by `RecordCodec` and prefixed by its length (varint).
+     * Its schema is sent once, with the label of the value.
+     */
+    typedef vexbridge::serial::UpdateValuePacket<Buffer> UpdateRecordPacket;
+
+    struct UpdateRecordPacketType : public UpdateValuePacketType<Buffer>
+    {
+        UpdateRecordPacketType() : UpdateValuePacketType(SerialPacketTypeID::UPDATE_RECORD)
+        {
+        }
+
+        Buffer deserializeValue(BufferReader &reader) override
+        {
+            uint32_t length = reader.readVarUInt();
+            return reader.readBytes(std::min<size_t>(length, reader.getBytesAvailable()));
+        }
+
+        void serializeValue(BufferWriter &writer, Buffer value) override
+        {
+            writer.writeVarUInt(value.size());
+            writer.writeBytes(value);
+        }
+    };
+}
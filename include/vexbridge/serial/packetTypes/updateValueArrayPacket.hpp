@@ -7,6 +7,7 @@
 #include "common/encodedSerialPacket.h"
 #include "../../utils/bufferWriter.hpp"
 #include "../../utils/bufferReader.hpp"
+#include "updateValuePacket.hpp"
 #include <vector>
 
 using namespace vexbridge::utils;
@@ -42,27 +43,16 @@ namespace vexbridge::serial
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
             // Cast packet to update value packet
             const UpdateValueArrayPacket<T> &updateValueArrayPacket = dynamic_cast<const UpdateValueArrayPacket<T> &>(packet);
 
-            // Allocate buffer for payload
-            Buffer payload;
-            BufferWriter writer(payload);
-
             // Write value
             writer.writeUInt16BE(updateValueArrayPacket.valueID);
             writer.writeUInt16BE(updateValueArrayPacket.newValue.size());
             for (const T &value : updateValueArrayPacket.newValue)
                 serializeValue(writer, value);
-
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            newPacket->payload = payload;
-            return newPacket;
         }
     };
 }
\ No newline at end of file
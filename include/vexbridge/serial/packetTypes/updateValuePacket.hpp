@@ -43,25 +43,14 @@ namespace vexbridge::serial
             return newPacket;
         }
 
-        std::unique_ptr<EncodedSerialPacket> serialize(const SerialPacket &packet) override
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
         {
             // Cast packet to update value packet
             const UpdateValuePacket<T> &updateValuePacket = dynamic_cast<const UpdateValuePacket<T> &>(packet);
 
-            // Allocate buffer for payload
-            Buffer payload;
-            BufferWriter writer(payload);
-
             // Write value
             writer.writeUInt16BE(updateValuePacket.valueID);
             serializeValue(writer, updateValuePacket.newValue);
-
-            // Make new encoded packet
-            auto newPacket = std::make_unique<EncodedSerialPacket>();
-            newPacket->type = packet.type;
-            newPacket->id = packet.id;
-            newPacket->payload = payload;
-            return newPacket;
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "common/serialPacket.h"
+#include "common/serialPacketType.h"
+#include "common/encodedSerialPacket.h"
+#include "../../table/visionFrame.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/bufferReader.hpp"
+
+using namespace vexbridge::utils;
+using namespace vexbridge::table;
+
+namespace vexbridge::serial
+{
+    /**
+     * Updates every target of a camera frame in a single packet, so targets from different frames are never mixed.
+     * Sent by a vision coprocessor, usually through the host.
+     * Positions are sent as 16-bit fixed-point, sizes as 16-bit fractions, and the confidence as an 8-bit fraction,
+     * so each target takes 10 bytes.
+     */
+    struct VisionFramePacket : public SerialPacket
+    {
+        uint16_t valueID = 0;
+
+        /// @brief Number of the frame, counted by the sender
+        uint32_t frameNumber = 0;
+
+        /// @brief Time the frame was captured on the sender's clock in milliseconds
+        uint32_t captureTime = 0;
+
+        /// @brief Time from capture until the packet's timestamp, or until it was sent if it has none, in milliseconds
+        /// @details Lets the receiver place the frame on its own clock
+        uint16_t frameAge = 0;
+
+        /// @brief Targets in the frame. Only the first `MAX_TARGET_COUNT` are sent.
+        std::vector<VisionTarget> targets;
+
+        /// @brief Maximum number of targets in a frame
+        static constexpr size_t MAX_TARGET_COUNT = UINT8_MAX;
+    };
+
+    struct VisionFramePacketType : public SerialPacketType
+    {
+        VisionFramePacketType() : SerialPacketType(SerialPacketTypeID::VISION_FRAME)
+        {
+        }
+
+        std::unique_ptr<SerialPacket> deserialize(const EncodedSerialPacket &packet) override
+        {
+            // Make new vision frame packet
+            auto newPacket = std::make_unique<VisionFramePacket>();
+            newPacket->type = packet.type;
+            newPacket->id = packet.id;
+
+            // Read packet contents from payload
+            BufferReader reader(packet.payload);
+            newPacket->valueID = reader.readUInt16BE();
+            newPacket->frameNumber = reader.readUInt32BE();
+            newPacket->captureTime = reader.readUInt32BE();
+            newPacket->frameAge = reader.readUInt16BE();
+
+            // Read targets
+            uint8_t targetCount = reader.readUInt8();
+            if (reader.getBytesAvailable() < targetCount * TARGET_SIZE)
+                throw std::runtime_error("Vision frame is missing targets");
+
+            newPacket->targets.reserve(targetCount);
+            for (uint8_t i = 0; i < targetCount; i++)
+            {
+                VisionTarget &target = newPacket->targets.emplace_back();
+                target.x = (int16_t)reader.readUInt16BE() / POSITION_SCALE;
+                target.y = (int16_t)reader.readUInt16BE() / POSITION_SCALE;
+                target.width = reader.readUInt16BE() / SIZE_SCALE;
+                target.height = reader.readUInt16BE() / SIZE_SCALE;
+                target.confidence = reader.readUInt8() / CONFIDENCE_SCALE;
+                target.classID = reader.readUInt8();
+            }
+            return newPacket;
+        }
+
+        void serializePayload(const SerialPacket &packet, BufferWriter &writer) override
+        {
+            // Cast packet to vision frame packet
+            const VisionFramePacket &framePacket = dynamic_cast<const VisionFramePacket &>(packet);
+
+            // Write packet contents to payload
+            writer.writeUInt16BE(framePacket.valueID);
+            writer.writeUInt32BE(framePacket.frameNumber);
+            writer.writeUInt32BE(framePacket.captureTime);
+            writer.writeUInt16BE(framePacket.frameAge);
+
+            // Write targets
+            size_t targetCount = std::min(framePacket.targets.size(), VisionFramePacket::MAX_TARGET_COUNT);
+            writer.writeUInt8(targetCount);
+            for (size_t i = 0; i < targetCount; i++)
+            {
+                const VisionTarget &target = framePacket.targets[i];
+                writer.writeUInt16BE((uint16_t)(int16_t)quantize(target.x, -1, 1, POSITION_SCALE));
+                writer.writeUInt16BE((uint16_t)(int16_t)quantize(target.y, -1, 1, POSITION_SCALE));
+                writer.writeUInt16BE((uint16_t)quantize(target.width, 0, 1, SIZE_SCALE));
+                writer.writeUInt16BE((uint16_t)quantize(target.height, 0, 1, SIZE_SCALE));
+                writer.writeUInt8((uint8_t)quantize(target.confidence, 0, 1, CONFIDENCE_SCALE));
+                writer.writeUInt8(target.classID);
+            }
+        }
+
+    private:
+        /**
+         * Clamps a value to a range and rounds it to a fixed-point step.
+         * @param value The value to quantize.
+         * @param min The minimum value.
+         * @param max The maximum value.
+         * @param scale The number of steps per unit.
+         * @return The value as a multiple of `1 / scale`.
+         */
+        static int32_t quantize(float value, float min, float max, float scale)
+        {
+            return (int32_t)std::lround(std::clamp(value, min, max) * scale);
+        }
+
+        /// @brief Size of each serialized target in bytes
+        static constexpr size_t TARGET_SIZE = 10;
+
+        /// @brief Steps per unit of the target position
+        static constexpr float POSITION_SCALE = INT16_MAX;
+
+        /// @brief Steps per unit of the target size
+        static constexpr float SIZE_SCALE = UINT16_MAX;
+
+        /// @brief Steps per unit of the target confidence
+        static constexpr float CONFIDENCE_SCALE = UINT8_MAX;
+    };
+}
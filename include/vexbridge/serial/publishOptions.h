@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vexbridge::serial
+{
+    /**
+     * Limits how often updates of a value are sent.
+     * The default options send every change immediately.
+     */
+    struct PublishOptions
+    {
+        /// @brief Maximum number of updates sent per second, or 0 for no limit.
+        /// Updates in between are not lost. The latest one is sent once the limit allows.
+        float maxRate = 0;
+
+        /// @brief Minimum change from the last sent value before a numeric update is sent
+        double absoluteDeadband = 0;
+
+        /// @brief Minimum change before a numeric update is sent, as a fraction of the last sent value.
+        /// For example, 0.01 skips changes smaller than 1%. The larger of the two deadbands is used.
+        double relativeDeadband = 0;
+
+        /// @brief Time in milliseconds after which the latest value is sent again, even if it has not changed,
+        /// or 0 to never resend. Also sends values that were held back by a deadband.
+        uint32_t refreshInterval = 0;
+
+        /**
+         * Checks if the options send every change immediately.
+         * @return True if no limit is set.
+         */
+        bool isDefault() const
+        {
+            return maxRate <= 0 && absoluteDeadband <= 0 && relativeDeadband <= 0 && refreshInterval == 0;
+        }
+    };
+}
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include "pros/rtos.hpp"
+#include "serialSocket.hpp"
+#include "publishOptions.h"
+#include "serialization/allPacketTypes.hpp"
+#include "../utils/daemon.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * Decides when updates of values with `PublishOptions` are sent.
+     * Updates inside a value's deadband are held back, updates faster than its maximum rate wait until the rate allows,
+     * and unchanged values are resent once their refresh interval passes.
+     * Optionally enforces a byte budget for the whole link. The budget is measured from the bytes every
+     * serial socket actually wrote, so other traffic such as labels or vision uses up the same budget,
+     * and scheduled values wait until the link has room instead of starving it.
+     */
+    class PublishScheduler : private Daemon
+    {
+    public:
+        /**
+         * Sends a value update that the scheduler has released.
+         * @param valueID The ID of the value being updated.
+         * @param packet The update packet.
+         */
+        typedef void (*PublishFunction)(uint16_t valueID, std::shared_ptr<SerialPacket> packet);
+
+        /**
+         * Creates a new publish scheduler.
+         * @param publish Called outside the scheduler's mutex for every update that is released.
+         */
+        PublishScheduler(PublishFunction publish)
+            : publish(publish)
+        {
+            start();
+        }
+
+        /**
+         * Sets the publish options of a value.
+         * Setting the default options sends any held back update immediately.
+         * @param valueID The ID of the value.
+         * @param options The publish options of the value.
+         */
+        void setOptions(uint16_t valueID, const PublishOptions &options)
+        {
+            std::shared_ptr<SerialPacket> heldPacket;
+
+            mutex.take();
+            ScheduledValue &value = getOrCreateValue(valueID);
+            value.options = options;
+            value.minInterval = options.maxRate > 0 ? (uint32_t)(1000.0f / options.maxRate) : 0;
+
+            // Release the held update, since the value is no longer scheduled
+            if (options.isDefault() && value.isDirty)
+            {
+                value.isDirty = false;
+                heldPacket = value.latestPacket;
+            }
+            mutex.give();
+
+            if (heldPacket)
+                publish(valueID, std::move(heldPacket));
+        }
+
+        /**
+         * Sets the maximum number of bytes per second written to each serial port.
+         * @param bytesPerSecond The byte budget of the link, or 0 for no limit.
+         */
+        void setLinkBudget(uint32_t bytesPerSecond)
+        {
+            mutex.take();
+            linkBudget = bytesPerSecond;
+            tokens = getMaxTokens();
+            mutex.give();
+        }
+
+        /**
+         * Offers a value update to the scheduler.
+         * The update is sent immediately if the value's options and the link budget allow it.
+         * Otherwise it is held and replaces any held update of the same value.
+         * @param valueID The ID of the value being updated.
+         * @param packet The update packet.
+         */
+        void queue(uint16_t valueID, std::shared_ptr<SerialPacket> packet)
+        {
+            std::shared_ptr<SerialPacket> releasedPacket;
+            uint32_t now = pros::millis();
+
+            mutex.take();
+            ScheduledValue &value = getOrCreateValue(valueID);
+            value.latestPacket = std::move(packet);
+            value.isLatestNumeric = getNumber(*value.latestPacket, value.latestNumber);
+
+            // Hold back small changes of numeric values
+            if (!isInDeadband(value))
+                value.isDirty = true;
+
+            // Send now if nothing else is holding the update back
+            if (value.isDirty && now - value.lastPublishTime >= value.minInterval && hasBudget())
+                releasedPacket = release(value, now);
+            mutex.give();
+
+            if (releasedPacket)
+                publish(valueID, std::move(releasedPacket));
+        }
+
+    protected:
+        void update() override
+        {
+            uint32_t now = pros::millis();
+
+            // Take the updates that are due
+            // Values are visited round-robin, so a tight budget is shared evenly between them
+            mutex.take();
+            refillBudget(now);
+            for (size_t i = 0; i < scheduledIDs.size(); i++)
+            {
+                size_t index = (nextIndex + i) % scheduledIDs.size();
+                uint16_t valueID = scheduledIDs[index];
+                ScheduledValue &value = values[valueID];
+                if (!value.latestPacket || value.options.isDefault())
+                    continue;
+
+                bool isUpdateDue = value.isDirty && now - value.lastPublishTime >= value.minInterval;
+                bool isRefreshDue = value.options.refreshInterval > 0 && now - value.lastPublishTime >= value.options.refreshInterval;
+                if (!isUpdateDue && !isRefreshDue)
+                    continue;
+
+                // Continue from this value on the next update
+                if (!hasBudget())
+                {
+                    nextIndex = index;
+                    break;
+                }
+
+                releasedIDs.push_back(valueID);
+                releasedPackets.push_back(release(value, now));
+            }
+            mutex.give();
+
+            // Send the updates after the mutex is released so `queue` never waits on the serial port
+            for (size_t i = 0; i < releasedPackets.size(); i++)
+                publish(releasedIDs[i], std::move(releasedPackets[i]));
+            releasedIDs.clear();
+            releasedPackets.clear();
+
+            pros::delay(SCHEDULE_INTERVAL);
+        }
+
+    private:
+        /**
+         * Scheduling state of a single value.
+         */
+        struct ScheduledValue
+        {
+            /// @brief Publish options of the value
+            PublishOptions options;
+
+            /// @brief Minimum time between updates in milliseconds, derived from `options.maxRate`
+            uint32_t minInterval = 0;
+
+            /// @brief Latest update of the value, sent or not. Resent on refresh.
+            std::shared_ptr<SerialPacket> latestPacket;
+
+            /// @brief Numeric value of `latestPacket`, if `isLatestNumeric`
+            double latestNumber = 0;
+
+            /// @brief True if `latestPacket` holds a bool, int, float, or double
+            bool isLatestNumeric = false;
+
+            /// @brief True if `latestPacket` is outside the deadband and has not been sent
+            bool isDirty = false;
+
+            /// @brief True once an update of the value has been sent
+            bool isPublished = false;
+
+            /// @brief Numeric value of the last sent update
+            double publishedNumber = 0;
+
+            /// @brief Time the last update was sent in milliseconds
+            uint32_t lastPublishTime = 0;
+
+            /// @brief True once the value is in `scheduledIDs`
+            bool isListed = false;
+        };
+
+        /**
+         * Gets the scheduling state of a value, creating it if needed.
+         * Must be called with the mutex taken.
+         * @param valueID The ID of the value.
+         * @return The scheduling state.
+         */
+        ScheduledValue &getOrCreateValue(uint16_t valueID)
+        {
+            if (valueID >= values.size())
+                values.resize(valueID + 1);
+            ScheduledValue &value = values[valueID];
+            if (!value.isListed)
+            {
+                scheduledIDs.push_back(valueID);
+                value.isListed = true;
+            }
+            return value;
+        }
+
+        /**
+         * Checks if the latest update of a value is too close to the last sent one to be worth sending.
+         * @param value The scheduling state of the value.
+         * @return True if the update should be held back.
+         */
+        static bool isInDeadband(const ScheduledValue &value)
+        {
+            if (!value.isPublished || !value.isLatestNumeric)
+                return false;
+
+            // Use the larger of the absolute and relative deadbands
+            double deadband = std::max(value.options.absoluteDeadband,
+                                       value.options.relativeDeadband * std::fabs(value.publishedNumber));
+            return std::fabs(value.latestNumber - value.publishedNumber) < deadband;
+        }
+
+        /**
+         * Marks the latest update of a value as sent and charges it to the link budget.
+         * Must be called with the mutex taken.
+         * @param value The scheduling state of the value.
+         * @param now The current time in milliseconds.
+         * @return The update to send.
+         */
+        std::shared_ptr<SerialPacket> release(ScheduledValue &value, uint32_t now)
+        {
+            value.isDirty = false;
+            value.isPublished = true;
+            value.publishedNumber = value.latestNumber;
+            value.lastPublishTime = now;
+
+            // Charge an estimate now. It is replaced by the measured size on the next refill.
+            tokens -= ESTIMATED_FRAME_SIZE;
+            estimatedBytes += ESTIMATED_FRAME_SIZE;
+            return value.latestPacket;
+        }
+
+        /**
+         * Checks if the link budget allows another update.
+         * @return True if there is no budget or it has bytes left.
+         */
+        bool hasBudget() const
+        {
+            return linkBudget == 0 || tokens > 0;
+        }
+
+        /**
+         * Gets the number of bytes the budget can save up while the link is idle.
+         * @return The maximum number of tokens.
+         */
+        int64_t getMaxTokens() const
+        {
+            return (int64_t)linkBudget * MAX_BURST / 1000;
+        }
+
+        /**
+         * Adds the bytes earned since the last refill and charges the bytes actually written.
+         * Must be called with the mutex taken.
+         * @param now The current time in milliseconds.
+         */
+        void refillBudget(uint32_t now)
+        {
+            // Measure the bytes written by the busiest serial port
+            uint32_t bytesWritten = 0;
+            for (auto socket : SerialSocket::allInstances)
+                bytesWritten = std::max(bytesWritten, socket->getStats().bytesWritten);
+            int64_t bytesWrittenDelta = bytesWritten >= lastBytesWritten ? bytesWritten - lastBytesWritten : 0;
+            lastBytesWritten = bytesWritten;
+
+            uint32_t elapsed = now - lastRefillTime;
+            lastRefillTime = now;
+            if (linkBudget == 0)
+                return;
+
+            // Replace the estimates with the measured bytes
+            // Debt is limited to one second of budget, so a burst of other traffic cannot stall values for long
+            tokens += estimatedBytes - bytesWrittenDelta + (int64_t)linkBudget * elapsed / 1000;
+            tokens = std::clamp(tokens, -(int64_t)linkBudget, getMaxTokens());
+            estimatedBytes = 0;
+        }
+
+        /**
+         * Gets the numeric value of a bool, int, float, or double update.
+         * @param packet The update packet.
+         * @param number Set to the numeric value.
+         * @return True if the packet is a numeric update.
+         */
+        static bool getNumber(const SerialPacket &packet, double &number)
+        {
+            switch (packet.type)
+            {
+            case SerialPacketTypeID::UPDATE_BOOL:
+                number = static_cast<const UpdateBoolPacket &>(packet).newValue;
+                return true;
+            case SerialPacketTypeID::UPDATE_INT:
+                number = static_cast<const UpdateIntPacket &>(packet).newValue;
+                return true;
+            case SerialPacketTypeID::UPDATE_FLOAT:
+                number = static_cast<const UpdateFloatPacket &>(packet).newValue;
+                return true;
+            case SerialPacketTypeID::UPDATE_DOUBLE:
+                number = static_cast<const UpdateDoublePacket &>(packet).newValue;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /// @brief Time between scheduling passes in milliseconds
+        static constexpr uint32_t SCHEDULE_INTERVAL = 5;
+
+        /// @brief Time in milliseconds of budget that can be saved up while the link is idle
+        static constexpr uint32_t MAX_BURST = 100;
+
+        /// @brief Bytes charged for each released update until the written bytes are measured
+        static constexpr int64_t ESTIMATED_FRAME_SIZE = 16;
+
+        /// @brief Sends released updates
+        PublishFunction publish;
+
+        /// @brief Scheduling state of each value, indexed by value ID
+        std::vector<ScheduledValue> values;
+
+        /// @brief IDs of every value that was given options, in the order they were added
+        std::vector<uint16_t> scheduledIDs;
+
+        /// @brief Index in `scheduledIDs` the next scheduling pass starts from
+        size_t nextIndex = 0;
+
+        /// @brief IDs of the updates released during a scheduling pass. Reused to avoid reallocating.
+        std::vector<uint16_t> releasedIDs;
+
+        /// @brief Updates released during a scheduling pass. Reused to avoid reallocating.
+        std::vector<std::shared_ptr<SerialPacket>> releasedPackets;
+
+        /// @brief Maximum bytes per second written to each serial port, or 0 for no limit
+        uint32_t linkBudget = 0;
+
+        /// @brief Bytes left in the budget. Negative while other traffic has overspent it.
+        int64_t tokens = 0;
+
+        /// @brief Bytes charged by `release` since the last refill
+        int64_t estimatedBytes = 0;
+
+        /// @brief Bytes written by the busiest serial port at the last refill
+        uint32_t lastBytesWritten = 0;
+
+        /// @brief Time of the last refill in milliseconds
+        uint32_t lastRefillTime = pros::millis();
+
+        /// @brief Mutex for synchronizing access to the scheduling state
+        pros::Mutex mutex;
+    };
+}
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include "pros/rtos.hpp"
+#include "recordingFormat.h"
+#include "../serialization/framingType.h"
+#include "../../utils/bufferWriter.hpp"
+#include "../../utils/daemon.hpp"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * Appends written frames to a file, usually on the SD card, so telemetry is kept when no host is connected.
+     * `record` only copies the frame into a block in memory. A background task writes each block once it is full,
+     * so the task that writes frames never waits on the SD card. Frames are dropped if the blocks fill faster
+     * than the SD card takes them. See `RecordingFormat` for the layout of the file.
+     */
+    class FrameRecorder : private Daemon
+    {
+    public:
+        /**
+         * Creates a new recording in the first unused file named `vbNNN.vbr` in a directory.
+         * Names fit in 8.3 format, so they work on any SD card.
+         * Does nothing if no file can be created, such as when no SD card is inserted.
+         * @param directory The directory to create the recording in.
+         * @param framingType How the recorded frames are delimited, stored so they can be replayed.
+         */
+        FrameRecorder(const std::string &directory = "/usd", FramingType framingType = FramingType::BYTE_STUFFING)
+            : framingType(framingType),
+              blocks(std::make_unique<Block[]>(BLOCK_COUNT))
+        {
+            openBlock(blocks[writeIndex]);
+
+            // Find an unused file name
+            for (uint32_t i = 0; i < MAX_FILE_COUNT && !file; i++)
+            {
+                char fileName[16];
+                snprintf(fileName, sizeof(fileName), "/vb%03u.vbr", (unsigned)i);
+                std::string filePath = directory + fileName;
+
+                FILE *existingFile = fopen(filePath.c_str(), "rb");
+                if (existingFile)
+                {
+                    fclose(existingFile);
+                    continue;
+                }
+
+                file = fopen(filePath.c_str(), "wb");
+                if (!file)
+                    break;
+                path = filePath;
+            }
+
+            start();
+        }
+
+        /**
+         * Writes the frames still in memory, including the partly filled block, and closes the recording.
+         */
+        ~FrameRecorder()
+        {
+            // Wait for the task to finish writing
+            std::lock_guard<pros::Mutex> fileLock(fileMutex);
+            if (!file)
+                return;
+
+            // Pad the partly filled block, making room for it first if every other block is full
+            if (isRecording())
+            {
+                writeBlocks();
+                mutex.take();
+                if (blocks[writeIndex].length > RecordingFormat::BLOCK_HEADER_SIZE)
+                    closeBlock();
+                mutex.give();
+                writeBlocks();
+            }
+
+            fclose(file);
+            file = nullptr;
+        }
+
+        /**
+         * Checks if frames are being recorded.
+         * @return False if no file could be created or the file could no longer be written.
+         */
+        bool isRecording() const
+        {
+            return file != nullptr && !isFailed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets the path of the recording.
+         * @return The path or an empty string if no file could be created.
+         */
+        const std::string &getPath() const
+        {
+            return path;
+        }
+
+        /**
+         * Appends a frame to the recording. Never waits on the SD card.
+         * @param frame The frame, exactly as it was written to the serial port.
+         */
+        void record(std::span<const uint8_t> frame)
+        {
+            uint32_t now = pros::millis();
+
+            mutex.take();
+
+            // Drop the frame if it does not fit in the free blocks, leaving room to pad the current block
+            size_t recordSize = RecordingFormat::RECORD_HEADER_SIZE + frame.size();
+            if (!isRecording() || frame.empty() || frame.size() > RecordingFormat::MAX_FRAME_SIZE ||
+                getFreeBytes() < recordSize + RecordingFormat::RECORD_HEADER_SIZE)
+            {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                mutex.give();
+                return;
+            }
+            size_t fullCountBefore = fullCount;
+
+            // Record headers never cross a block, so pad the block if the header does not fit
+            if (blocks[writeIndex].length + RecordingFormat::RECORD_HEADER_SIZE > RecordingFormat::BLOCK_SIZE)
+                closeBlock();
+
+            // Write the record header
+            Block &block = blocks[writeIndex];
+            if (block.firstRecordOffset == RecordingFormat::NO_RECORD_START)
+            {
+                block.firstRecordOffset = block.length;
+                block.timestamp = now;
+            }
+            if (block.length == RecordingFormat::BLOCK_HEADER_SIZE)
+                block.openTime = now;
+            BufferWriter writer(std::span<uint8_t>(block.bytes, RecordingFormat::BLOCK_SIZE), block.length);
+            writer.writeUInt32BE(now);
+            writer.writeUInt16BE(frame.size());
+            lastRecordTime = now;
+
+            // Copy the frame, continuing into the next blocks
+            size_t copied = 0;
+            while (copied < frame.size())
+            {
+                Block &currentBlock = blocks[writeIndex];
+                size_t length = std::min(frame.size() - copied, RecordingFormat::BLOCK_SIZE - currentBlock.length);
+                memcpy(currentBlock.bytes + currentBlock.length, frame.data() + copied, length);
+                currentBlock.length += length;
+                copied += length;
+
+                if (currentBlock.length == RecordingFormat::BLOCK_SIZE)
+                    closeBlock();
+            }
+            bytesRecorded.fetch_add(recordSize, std::memory_order_relaxed);
+            bool isBlockFull = fullCount > fullCountBefore;
+
+            mutex.give();
+
+            // Wake the task to write the full blocks
+            if (isBlockFull)
+                notify();
+        }
+
+        /**
+         * Gets the number of frame and record header bytes recorded, including those not yet written to the file.
+         * @return The number of bytes recorded.
+         */
+        uint32_t getBytesRecorded() const
+        {
+            return bytesRecorded.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets the number of frames that were not recorded because the blocks were full or the file failed.
+         * @return The number of dropped frames.
+         */
+        uint32_t getDroppedCount() const
+        {
+            return droppedCount.load(std::memory_order_relaxed);
+        }
+
+    protected:
+        void update() override
+        {
+            // Wait for a full block, or until the current block is due to be written anyway
+            waitForNotify(FLUSH_INTERVAL);
+            std::lock_guard<pros::Mutex> fileLock(fileMutex);
+            if (!isRecording())
+                return;
+            uint32_t now = pros::millis();
+
+            // A block that has waited too long is padded, so a power loss loses at most `FLUSH_INTERVAL` of frames
+            mutex.take();
+            Block &currentBlock = blocks[writeIndex];
+            bool isCurrentBlockDue = currentBlock.length > RecordingFormat::BLOCK_HEADER_SIZE &&
+                                     now - currentBlock.openTime >= FLUSH_INTERVAL;
+            if (isCurrentBlockDue && fullCount < BLOCK_COUNT - 1)
+                closeBlock();
+            mutex.give();
+
+            writeBlocks();
+        }
+
+    private:
+        /**
+         * A block of the recording in memory.
+         */
+        struct Block
+        {
+            /// @brief Bytes of the block, including its header
+            uint8_t bytes[RecordingFormat::BLOCK_SIZE];
+
+            /// @brief Number of bytes filled, including the header
+            size_t length = 0;
+
+            /// @brief Offset of the first record that starts in the block, or `NO_RECORD_START`
+            uint16_t firstRecordOffset = RecordingFormat::NO_RECORD_START;
+
+            /// @brief Time of the first record that starts in the block, or of the record it continues
+            uint32_t timestamp = 0;
+
+            /// @brief Time the first byte after the header was filled in milliseconds
+            uint32_t openTime = 0;
+        };
+
+        /**
+         * Gets the number of bytes that can be recorded before the blocks are full.
+         * Must be called with the mutex taken.
+         * @return The number of free bytes.
+         */
+        size_t getFreeBytes() const
+        {
+            size_t freeBlockCount = BLOCK_COUNT - 1 - fullCount;
+            return RecordingFormat::BLOCK_SIZE - blocks[writeIndex].length +
+                   freeBlockCount * (RecordingFormat::BLOCK_SIZE - RecordingFormat::BLOCK_HEADER_SIZE);
+        }
+
+        /**
+         * Writes the full blocks to the file and frees them.
+         * Stops recording if the SD card is full or removed.
+         * Must be called with `fileMutex` taken.
+         */
+        void writeBlocks()
+        {
+            // Take the full blocks
+            mutex.take();
+            size_t blockCount = fullCount;
+            mutex.give();
+            if (blockCount == 0)
+                return;
+
+            // Write the blocks outside `mutex`, since full blocks are never touched by `record`
+            bool isWritten = true;
+            for (size_t i = 0; i < blockCount && isWritten; i++)
+                isWritten = fwrite(blocks[(flushIndex + i) % BLOCK_COUNT].bytes, 1, RecordingFormat::BLOCK_SIZE, file) == RecordingFormat::BLOCK_SIZE;
+            isWritten = isWritten && fflush(file) == 0;
+
+            // Free the written blocks
+            mutex.take();
+            fullCount -= blockCount;
+            flushIndex = (flushIndex + blockCount) % BLOCK_COUNT;
+            if (!isWritten)
+                isFailed.store(true, std::memory_order_relaxed);
+            mutex.give();
+        }
+
+        /**
+         * Starts filling a free block.
+         * @param block The block to start.
+         */
+        void openBlock(Block &block)
+        {
+            block.length = RecordingFormat::BLOCK_HEADER_SIZE;
+            block.firstRecordOffset = RecordingFormat::NO_RECORD_START;
+            block.timestamp = lastRecordTime;
+        }
+
+        /**
+         * Writes the header of the current block, pads it, and moves on to the next block.
+         * Must be called with the mutex taken and at least one free block.
+         */
+        void closeBlock()
+        {
+            Block &block = blocks[writeIndex];
+
+            // Padding is zeros, which reads as a record header with a length of 0
+            memset(block.bytes + block.length, 0, RecordingFormat::BLOCK_SIZE - block.length);
+
+            size_t headerLength = 0;
+            BufferWriter writer(std::span<uint8_t>(block.bytes, RecordingFormat::BLOCK_HEADER_SIZE), headerLength);
+            writer.writeUInt32BE(RecordingFormat::MAGIC);
+            writer.writeUInt8(RecordingFormat::VERSION);
+            writer.writeUInt8((uint8_t)framingType);
+            writer.writeUInt16BE(block.firstRecordOffset);
+            writer.writeUInt32BE(block.timestamp);
+            writer.writeUInt32BE(blockIndex++);
+
+            fullCount++;
+            writeIndex = (writeIndex + 1) % BLOCK_COUNT;
+            openBlock(blocks[writeIndex]);
+        }
+
+        /// @brief Number of blocks in memory. Frames are dropped if the SD card falls this far behind.
+        static constexpr size_t BLOCK_COUNT = 8;
+
+        /// @brief Maximum time in milliseconds a recorded frame waits before it is written to the file
+        static constexpr uint32_t FLUSH_INTERVAL = 1000;
+
+        /// @brief Number of file names tried before giving up
+        static constexpr uint32_t MAX_FILE_COUNT = 1000;
+
+        /// @brief How the recorded frames are delimited
+        FramingType framingType;
+
+        /// @brief Ring of blocks. Full blocks are written by the task, the rest are filled by `record`.
+        std::unique_ptr<Block[]> blocks;
+
+        /// @brief Index of the block being filled
+        size_t writeIndex = 0;
+
+        /// @brief Index of the oldest full block
+        size_t flushIndex = 0;
+
+        /// @brief Number of full blocks waiting to be written
+        size_t fullCount = 0;
+
+        /// @brief Index of the next block in the file
+        uint32_t blockIndex = 0;
+
+        /// @brief Time of the last recorded frame in milliseconds
+        uint32_t lastRecordTime = 0;
+
+        /// @brief Number of bytes recorded
+        std::atomic<uint32_t> bytesRecorded = 0;
+
+        /// @brief Number of frames dropped
+        std::atomic<uint32_t> droppedCount = 0;
+
+        /// @brief True once the file could not be written
+        std::atomic<bool> isFailed = false;
+
+        /// @brief Path of the recording
+        std::string path;
+
+        /// @brief The recording, or nullptr if no file could be created
+        FILE *file = nullptr;
+
+        /// @brief Mutex for synchronizing access to the blocks
+        pros::Mutex mutex;
+
+        /// @brief Mutex for synchronizing access to the file. Never taken by `record`, so it never waits on the SD card.
+        pros::Mutex fileMutex;
+    };
+}
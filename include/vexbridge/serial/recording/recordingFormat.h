@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "../../utils/checksum.hpp"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * Layout of a recording written by `FrameRecorder`.
+     *
+     * The file is a sequence of fixed-size blocks, so it is written to the SD card in whole sectors
+     * and can be searched by time without reading all of it. Each block starts with a header:
+     * - Magic number `MAGIC` (uint32_t BE)
+     * - Format version `VERSION` (uint8_t)
+     * - Framing type of the recorded frames (uint8_t)
+     * - Offset of the first record that starts in the block, or `NO_RECORD_START` (uint16_t BE)
+     * - Time of that record, or of the record continued from the previous block, in milliseconds (uint32_t BE)
+     * - Index of the block in the file (uint32_t BE)
+     *
+     * The block headers are the index of the file. The rest of each block holds records:
+     * - Time the frame was written, in milliseconds since the program started (uint32_t BE)
+     * - The length of the frame (uint16_t BE)
+     * - The frame, as it was written to the serial port but checked with `CHECKSUM_TYPE`
+     *
+     * The serial port switches checksums whenever a host connects, so frames are recorded with a fixed one
+     * and a recording can be replayed without knowing which host was connected.
+     *
+     * A record continues into the next block after its header. Record headers never cross a block,
+     * and a record header with a length of 0 marks the rest of the block as padding.
+     */
+    struct RecordingFormat
+    {
+        /// @brief Size of each block in bytes. A multiple of the SD card sector size.
+        static constexpr size_t BLOCK_SIZE = 4096;
+
+        /// @brief Size of the header at the start of each block
+        static constexpr size_t BLOCK_HEADER_SIZE = 16;
+
+        /// @brief Size of the header before each frame
+        static constexpr size_t RECORD_HEADER_SIZE = 6;
+
+        /// @brief Maximum length of a recorded frame
+        static constexpr size_t MAX_FRAME_SIZE = UINT16_MAX;
+
+        /// @brief Marks the start of a block. "VBRB" in ASCII.
+        static constexpr uint32_t MAGIC = 0x56425242;
+
+        /// @brief Version of the format
+        static constexpr uint8_t VERSION = 2;
+
+        /// @brief Checksum of every recorded frame, whatever checksum the serial port uses
+        static constexpr ChecksumType CHECKSUM_TYPE = ChecksumType::CRC32;
+
+        /// @brief First record offset of a block that only continues a record from the previous block
+        static constexpr uint16_t NO_RECORD_START = 0;
+    };
+}
@@ -1,14 +1,19 @@
 #pragma once
 
+#include <deque>
 #include "serialization/serialPacketWriter.hpp"
 #include "serialization/serialPacketReader.hpp"
 #include "../utils/daemon.hpp"
 #include "../utils/globalInstances.hpp"
+#include "../utils/mpscQueue.hpp"
 
 namespace vexbridge::serial
 {
     /**
      * Opens a socket to a serial port.
+     * Other tasks only queue packets and wake the socket's task, so they never wait on the serial port.
+     * The socket's task does all reading and writing, and sleeps until a packet is queued,
+     * an unacknowledged packet times out, or the serial port is due to be polled.
      */
     class SerialSocket :
 
@@ -22,42 +27,47 @@ namespace vexbridge::serial
         /**
          * Creates a new serial daemon.
          * @param serialDriver The serial driver to use for reading and writing data.
+         * @param framingType How frames are delimited. Must match the other side of the serial port.
+         * @param recorder The recorder to append every sent packet to, or nullptr to not record.
          */
-        SerialSocket(std::shared_ptr<SerialDriver> serialDriver)
+        SerialSocket(std::shared_ptr<SerialDriver> serialDriver, FramingType framingType = FramingType::BYTE_STUFFING,
+                     std::shared_ptr<FrameRecorder> recorder = nullptr)
+            : serialDriver(serialDriver)
         {
             // Initialize the serial writer and reader
             serialWriter = std::make_shared<SerialPacketWriter>(serialDriver);
             serialReader = std::make_shared<SerialPacketReader>(serialDriver);
+            serialWriter->setFramingType(framingType);
+            serialReader->setFramingType(framingType);
+            serialWriter->setRecorder(recorder);
 
             // Pass SerialWriter and SerialReader to each other
             serialWriter->setSerialReader(serialReader);
             serialReader->setSerialWriter(serialWriter);
 
             // Write `ResetPacket` on startup
-            auto resetPacket = std::make_shared<ResetPacket>();
+            // Advertises our checksums, the receiver replies with its own and both switch to the strongest shared one
+            // Sent reliably, so it is resent until acknowledged with the agreed checksum
+            auto resetPacket = makePacket<ResetPacket>();
             resetPacket->type = SerialPacketTypeID::RESET;
+            resetPacket->supportedChecksums = ResetPacketHandler::SUPPORTED_CHECKSUMS;
             writePacket(resetPacket);
+
+            start();
         }
 
         /**
          * Adds a serial packet to the write queue.
+         * Safe to call from any task. The packet is written by the socket's task.
          * @param packet The packet to write.
          */
         void writePacket(std::shared_ptr<SerialPacket> packet)
         {
-            try
-            {
-                // Check if the packet is nullptr
-                if (!packet)
-                    throw std::runtime_error("Cannot write a nullptr packet.");
+            // Check if the packet is nullptr
+            if (!packet)
+                return;
 
-                // Write the packet to the serial port
-                serialWriter->sendPacket(packet);
-            }
-            catch (std::exception &e)
-            {
-                // Do nothing
-            }
+            queuePacket({std::move(packet)});
         }
 
         /**
@@ -70,23 +80,240 @@ namespace vexbridge::serial
                 socket->writePacket(packet);
         }
 
+        /**
+         * Adds the latest update of a best-effort value to the write queue.
+         * Safe to call from any task. Replaces any earlier update of the value that is still waiting
+         * for room on the serial port once the socket's task writes it.
+         * @param valueID The ID of the value.
+         * @param packet The update packet.
+         */
+        void writeLatest(uint16_t valueID, std::shared_ptr<SerialPacket> packet)
+        {
+            // Check if the packet is nullptr
+            if (!packet)
+                return;
+
+            queuePacket({std::move(packet), valueID, true});
+        }
+
+        /**
+         * Writes the latest update of a best-effort value to all active serial sockets.
+         * @param valueID The ID of the value.
+         * @param packet The update packet.
+         */
+        static void writeLatestToAll(uint16_t valueID, std::shared_ptr<SerialPacket> packet)
+        {
+            for (auto socket : allInstances)
+                socket->writeLatest(valueID, packet);
+        }
+
+        /**
+         * Gets the usage counters of the serial driver, including bytes discarded by the reader.
+         * @return The usage counters.
+         */
+        SerialDriverStats getStats() const
+        {
+            SerialDriverStats stats = serialDriver->getStats();
+            stats.discarded += serialReader->getDiscardedCount();
+            stats.superseded += serialWriter->getSupersededCount();
+            stats.queueOverflows += queueOverflowCount.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        /**
+         * Gets the estimate of the other side's clock.
+         * Measured by a `PingPacket` exchange every `PING_INTERVAL`.
+         * @return The clock estimate.
+         */
+        const ClockSync &getClockSync() const
+        {
+            return serialReader->getClockSync();
+        }
+
     protected:
         void update() override
         {
+            // Take the packets that overflowed the queue before draining it
+            // They were queued after every reliable packet in the queue, so they are written last
+            std::deque<QueuedPacket> overflowPackets = takeOverflowPackets();
+
+            // Write the packets queued by other tasks
+            QueuedPacket queuedPacket;
+            while (writeQueue.pop(queuedPacket))
+                writeQueuedPacket(queuedPacket);
+            for (auto &overflowPacket : overflowPackets)
+                writeQueuedPacket(overflowPacket);
+            overflowPackets.clear();
+            clearOverflowIfDrained();
+
             // Read packets from the serial port
             serialReader->readPacketsFromSerial();
 
             // Resend any packets that have not been acknowledged
             serialWriter->resendMissingPackets();
 
-            // Pause to prevent cpu overload
-            pros::delay(UPDATE_INTERVAL);
+            // Write best-effort updates that were waiting for room
+            serialWriter->writeLatestPackets();
+
+            // Measure the offset of the other side's clock
+            sendPingIfDue();
+
+            // Sleep until a packet is queued, a packet times out, or the serial port is due to be polled
+            // The serial port is polled more often while ACKs or room for best-effort updates are expected
+            uint32_t resendDelay = serialWriter->getResendDelay();
+            bool isWaiting = resendDelay != UINT32_MAX || serialWriter->hasLatestPackets();
+            waitForNotify(std::min(resendDelay, isWaiting ? ACTIVE_POLL_INTERVAL : IDLE_POLL_INTERVAL));
         }
 
     private:
-        static constexpr uint32_t MAX_QUEUE_SIZE = 128; // Maximum number of packets in the write queue
-        static constexpr uint32_t UPDATE_INTERVAL = 2;  // ms
+        /**
+         * Packet waiting in the write queue.
+         */
+        struct QueuedPacket
+        {
+            /// @brief Packet to write
+            std::shared_ptr<SerialPacket> packet;
+
+            /// @brief ID of the value if `isLatest`
+            uint16_t valueID = 0;
+
+            /// @brief True to write the packet as the latest update of a best-effort value
+            bool isLatest = false;
+        };
+
+        /**
+         * Adds a packet to the write queue and wakes the socket's task.
+         * If the queue is full, best-effort packets are dropped, since a newer update follows,
+         * and reliable packets are added to the overflow list instead.
+         * @param queuedPacket The packet to queue.
+         */
+        void queuePacket(QueuedPacket queuedPacket)
+        {
+            // Reliable packets queue behind any that overflowed, so they are written in order
+            bool isReliable = !queuedPacket.isLatest && !(queuedPacket.packet->flags & SerialPacketFlag::NO_ACK);
+            bool isQueued = !(isReliable && hasOverflow.load(std::memory_order_acquire)) && writeQueue.push(queuedPacket);
+            if (!isQueued)
+            {
+                if (!isReliable)
+                {
+                    queueOverflowCount.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                overflowMutex.take();
+                overflowPackets.push_back(std::move(queuedPacket));
+                hasOverflow.store(true, std::memory_order_release);
+                overflowMutex.give();
+            }
+            notify();
+        }
+
+        /**
+         * Takes the reliable packets that overflowed the write queue.
+         * @return The packets, in the order they were queued.
+         */
+        std::deque<QueuedPacket> takeOverflowPackets()
+        {
+            if (!hasOverflow.load(std::memory_order_acquire))
+                return {};
+
+            overflowMutex.take();
+            std::deque<QueuedPacket> packets;
+            packets.swap(overflowPackets);
+            overflowMutex.give();
+            return packets;
+        }
+
+        /**
+         * Lets reliable packets use the write queue again once no packets overflowed since they were last taken.
+         */
+        void clearOverflowIfDrained()
+        {
+            if (!hasOverflow.load(std::memory_order_acquire))
+                return;
+
+            overflowMutex.take();
+            if (overflowPackets.empty())
+                hasOverflow.store(false, std::memory_order_release);
+            overflowMutex.give();
+        }
+
+        /**
+         * Writes a packet taken from the write queue.
+         * @param queuedPacket The packet to write. Released after writing.
+         */
+        void writeQueuedPacket(QueuedPacket &queuedPacket)
+        {
+            try
+            {
+                if (queuedPacket.isLatest)
+                    serialWriter->sendLatest(queuedPacket.valueID, std::move(queuedPacket.packet));
+                else
+                    serialWriter->sendPacket(std::move(queuedPacket.packet));
+            }
+            catch (std::exception &e)
+            {
+                // Do nothing
+            }
+            queuedPacket.packet.reset();
+        }
+
+        /**
+         * Sends a clock synchronization request if one is due.
+         * Requests are sent more often until the first reply, so the clock is synchronized soon after connecting.
+         */
+        void sendPingIfDue()
+        {
+            uint32_t now = pros::millis();
+            uint32_t interval = serialReader->getClockSync().isSynchronized() ? PING_INTERVAL : UNSYNCHRONIZED_PING_INTERVAL;
+            if (now - lastPingTime < interval)
+                return;
+            lastPingTime = now;
+
+            try
+            {
+                PingPacketHandler::sendRequest(serialWriter.get());
+            }
+            catch (std::exception &e)
+            {
+                // Do nothing
+            }
+        }
+
+        /// @brief Maximum number of packets in the write queue
+        static constexpr uint32_t MAX_QUEUE_SIZE = 512;
+
+        /// @brief Maximum time between polls of the serial port while ACKs or room for best-effort updates are expected in milliseconds
+        static constexpr uint32_t ACTIVE_POLL_INTERVAL = 2;
+
+        /// @brief Maximum time between polls of the serial port while idle in milliseconds
+        static constexpr uint32_t IDLE_POLL_INTERVAL = 10;
+
+        /// @brief Time between clock synchronization requests in milliseconds
+        static constexpr uint32_t PING_INTERVAL = 1000;
+
+        /// @brief Time between clock synchronization requests until the first reply in milliseconds
+        static constexpr uint32_t UNSYNCHRONIZED_PING_INTERVAL = 100;
+
+        /// @brief Time the last clock synchronization request was sent in milliseconds
+        uint32_t lastPingTime = 0;
+
+        /// @brief Packets queued by other tasks, written by the socket's task
+        MpscQueue<QueuedPacket, MAX_QUEUE_SIZE> writeQueue;
+
+        /// @brief Number of best-effort packets dropped because the write queue was full
+        std::atomic<uint32_t> queueOverflowCount = 0;
+
+        /// @brief Reliable packets that did not fit in the write queue, written by the socket's task
+        std::deque<QueuedPacket> overflowPackets;
+
+        /// @brief Guards `overflowPackets`
+        pros::Mutex overflowMutex;
+
+        /// @brief True while reliable packets must be added to `overflowPackets` to stay in order
+        std::atomic<bool> hasOverflow = false;
 
+        std::shared_ptr<SerialDriver> serialDriver;
         std::shared_ptr<SerialPacketWriter> serialWriter;
         std::shared_ptr<SerialPacketReader> serialReader;
     };
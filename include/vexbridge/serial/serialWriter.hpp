@@ -2,11 +2,18 @@
 
 #include <cstdint>
 #include <string>
+#include <atomic>
+#include <mutex>
 #include "serialSocket.hpp"
+#include "serialization/qos.h"
+#include "valueCoalescer.hpp"
+#include "publishScheduler.hpp"
 #include "packetTypes/updateBoolPacket.hpp"
 #include "packetTypes/updateIntPacket.hpp"
 #include "packetTypes/updateFloatPacket.hpp"
 #include "packetTypes/updateDoublePacket.hpp"
+#include "packetTypes/updateStringPacket.hpp"
+#include "packetTypes/updateRecordPacket.hpp"
 #include "packetTypes/assignLabelPacket.hpp"
 #include "packetTypes/updateBoolArrayPacket.hpp"
 #include "packetTypes/updateIntArrayPacket.hpp"
@@ -23,94 +30,254 @@ namespace vexbridge::serial
         // Prevent instantiation
         SerialWriter() = delete;
 
+        /**
+         * Coalesces value updates instead of sending each one immediately.
+         * Only the latest value of each ID is sent, once per flush interval.
+         * Safe to call from any task. Calling it again only changes the flush interval.
+         * @param flushInterval The time between flushes in milliseconds.
+         */
+        static void enableCoalescing(uint32_t flushInterval)
+        {
+            std::lock_guard<pros::Mutex> lock(coalescerMutex);
+            if (ValueCoalescer *currentCoalescer = coalescer.load(std::memory_order_acquire))
+            {
+                currentCoalescer->setFlushInterval(flushInterval);
+                return;
+            }
+
+            // Never freed, since its task runs until the program ends
+            coalescer.store(new ValueCoalescer(flushInterval), std::memory_order_release);
+        }
+
+        /**
+         * Sets how updates of a value are delivered.
+         * @param id The ID of the value.
+         * @param qos The delivery class of the value.
+         */
+        static void setQoS(uint16_t id, QoS qos)
+        {
+            uint32_t bit = 1u << (id % 32);
+            if (qos == QoS::BEST_EFFORT)
+                bestEffortBits[id / 32].fetch_or(bit, std::memory_order_relaxed);
+            else
+                bestEffortBits[id / 32].fetch_and(~bit, std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets how updates of a value are delivered.
+         * @param id The ID of the value.
+         * @return The delivery class of the value.
+         */
+        static QoS getQoS(uint16_t id)
+        {
+            bool isBestEffort = bestEffortBits[id / 32].load(std::memory_order_relaxed) & (1u << (id % 32));
+            return isBestEffort ? QoS::BEST_EFFORT : QoS::RELIABLE;
+        }
+
+        /**
+         * Sets the rate limit, deadband, and refresh interval of a value.
+         * Values without options send every change immediately.
+         * @param id The ID of the value.
+         * @param options The publish options of the value.
+         */
+        static void setPublishOptions(uint16_t id, const PublishOptions &options)
+        {
+            uint32_t bit = 1u << (id % 32);
+            if (!options.isDefault())
+                scheduledBits[id / 32].fetch_or(bit, std::memory_order_relaxed);
+            getScheduler().setOptions(id, options);
+            if (options.isDefault())
+                scheduledBits[id / 32].fetch_and(~bit, std::memory_order_relaxed);
+        }
+
+        /**
+         * Sets the maximum number of bytes per second written to each serial port.
+         * Values with publish options wait while the link is over budget. Other packets are never held back,
+         * but count against the budget.
+         * @param bytesPerSecond The byte budget of the link, or 0 for no limit.
+         */
+        static void setLinkBudget(uint32_t bytesPerSecond)
+        {
+            getScheduler().setLinkBudget(bytesPerSecond);
+        }
+
+        /**
+         * Stamps every value update with the time it was set, so the receiver knows when it was captured
+         * rather than when it arrived. Adds 4 bytes to each update.
+         * @param isEnabled True to stamp value updates.
+         */
+        static void setTimestamped(bool isEnabled)
+        {
+            isTimestamped.store(isEnabled, std::memory_order_relaxed);
+        }
+
         static void updateBool(uint16_t id, bool value)
         {
-            auto packet = std::make_shared<UpdateBoolPacket>();
+            auto packet = makePacket<UpdateBoolPacket>();
             packet->type = SerialPacketTypeID::UPDATE_BOOL;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateInt(uint16_t id, int value)
         {
-            auto packet = std::make_shared<UpdateIntPacket>();
+            auto packet = makePacket<UpdateIntPacket>();
             packet->type = SerialPacketTypeID::UPDATE_INT;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateFloat(uint16_t id, float value)
         {
-            auto packet = std::make_shared<UpdateFloatPacket>();
+            auto packet = makePacket<UpdateFloatPacket>();
             packet->type = SerialPacketTypeID::UPDATE_FLOAT;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateDouble(uint16_t id, double value)
         {
-            auto packet = std::make_shared<UpdateDoublePacket>();
+            auto packet = makePacket<UpdateDoublePacket>();
             packet->type = SerialPacketTypeID::UPDATE_DOUBLE;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateString(uint16_t id, std::string value)
         {
-            auto packet = std::make_shared<UpdateStringPacket>();
+            auto packet = makePacket<UpdateStringPacket>();
             packet->type = SerialPacketTypeID::UPDATE_STRING;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
-        static void assignLabel(uint16_t id, std::string label)
+        static void updateRecord(uint16_t id, Buffer value)
         {
-            auto packet = std::make_shared<AssignLabelPacket>();
+            auto packet = makePacket<UpdateRecordPacket>();
+            packet->type = SerialPacketTypeID::UPDATE_RECORD;
+            packet->valueID = id;
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
+        }
+
+        static void assignLabel(uint16_t id, std::string label, std::string schema = "")
+        {
+            auto packet = makePacket<AssignLabelPacket>();
             packet->type = SerialPacketTypeID::ASSIGN_LABEL;
             packet->valueID = id;
-            packet->label = label;
+            packet->label = std::move(label);
+            packet->schema = std::move(schema);
             SerialSocket::writePacketToAll(packet);
         }
 
         static void updateBoolArray(uint16_t id, std::vector<bool> value)
         {
-            auto packet = std::make_shared<UpdateBoolArrayPacket>();
+            auto packet = makePacket<UpdateBoolArrayPacket>();
             packet->type = SerialPacketTypeID::UPDATE_BOOL_ARRAY;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateIntArray(uint16_t id, std::vector<int> value)
         {
-            auto packet = std::make_shared<UpdateIntArrayPacket>();
+            auto packet = makePacket<UpdateIntArrayPacket>();
             packet->type = SerialPacketTypeID::UPDATE_INT_ARRAY;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateFloatArray(uint16_t id, std::vector<float> value)
         {
-            auto packet = std::make_shared<UpdateFloatArrayPacket>();
+            auto packet = makePacket<UpdateFloatArrayPacket>();
             packet->type = SerialPacketTypeID::UPDATE_FLOAT_ARRAY;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
         }
 
         static void updateDoubleArray(uint16_t id, std::vector<double> value)
         {
-            auto packet = std::make_shared<UpdateDoubleArrayPacket>();
+            auto packet = makePacket<UpdateDoubleArrayPacket>();
             packet->type = SerialPacketTypeID::UPDATE_DOUBLE_ARRAY;
             packet->valueID = id;
-            packet->newValue = value;
-            SerialSocket::writePacketToAll(packet);
+            packet->newValue = std::move(value);
+            writeValuePacket(id, std::move(packet));
+        }
+
+    private:
+        /**
+         * Passes a value update packet to the scheduler if the value has publish options, otherwise sends it.
+         * Best-effort updates are flagged so they are never acknowledged or resent.
+         * Updates are stamped with the current time if timestamps are enabled.
+         * @param id The ID of the value being updated.
+         * @param packet The update packet.
+         */
+        static void writeValuePacket(uint16_t id, std::shared_ptr<SerialPacket> packet)
+        {
+            if (getQoS(id) == QoS::BEST_EFFORT)
+                packet->flags |= SerialPacketFlag::NO_ACK;
+
+            // Stamp the update before it waits in the scheduler or coalescer
+            if (isTimestamped.load(std::memory_order_relaxed))
+            {
+                packet->flags |= SerialPacketFlag::HAS_TIMESTAMP;
+                packet->timestamp = pros::micros();
+            }
+
+            bool isScheduled = scheduledBits[id / 32].load(std::memory_order_relaxed) & (1u << (id % 32));
+            if (isScheduled)
+                getScheduler().queue(id, std::move(packet));
+            else
+                sendValuePacket(id, std::move(packet));
+        }
+
+        /**
+         * Sends a value update packet, or queues it if coalescing is enabled.
+         * @param id The ID of the value being updated.
+         * @param packet The update packet.
+         */
+        static void sendValuePacket(uint16_t id, std::shared_ptr<SerialPacket> packet)
+        {
+            bool isBestEffort = packet->flags & SerialPacketFlag::NO_ACK;
+            if (ValueCoalescer *currentCoalescer = coalescer.load(std::memory_order_acquire))
+                currentCoalescer->queue(id, std::move(packet));
+            else if (isBestEffort)
+                SerialSocket::writeLatestToAll(id, std::move(packet));
+            else
+                SerialSocket::writePacketToAll(std::move(packet));
+        }
+
+        /**
+         * Gets the scheduler of values with publish options.
+         * Created on first use, so programs without publish options do not run its task.
+         * @return The publish scheduler.
+         */
+        static PublishScheduler &getScheduler()
+        {
+            static PublishScheduler scheduler(&sendValuePacket);
+            return scheduler;
         }
+
+        /// @brief True if value updates are stamped with the time they were set
+        static inline std::atomic<bool> isTimestamped = false;
+
+        /// @brief Coalesces value updates if coalescing is enabled, otherwise nullptr. Set once.
+        static inline std::atomic<ValueCoalescer *> coalescer = nullptr;
+
+        /// @brief Mutex for creating the coalescer
+        static inline pros::Mutex coalescerMutex;
+
+        /// @brief Bit `id % 32` of word `id / 32` is set if value `id` is `QoS::BEST_EFFORT`
+        static inline std::atomic<uint32_t> bestEffortBits[65536 / 32] = {};
+
+        /// @brief Bit `id % 32` of word `id / 32` is set if value `id` has publish options
+        static inline std::atomic<uint32_t> scheduledBits[65536 / 32] = {};
     };
 }
\ No newline at end of file
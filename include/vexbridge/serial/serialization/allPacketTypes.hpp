@@ -1,21 +1,28 @@
 #pragma once
 
+#include <array>
 #include "../packetTypes/common/serialPacketType.h"
 #include "../packetTypes/assignLabelPacket.hpp"
 #include "../packetTypes/updateIntPacket.hpp"
 #include "../packetTypes/updateFloatPacket.hpp"
 #include "../packetTypes/updateDoublePacket.hpp"
 #include "../packetTypes/updateStringPacket.hpp"
+#include "../packetTypes/updateRecordPacket.hpp"
 #include "../packetTypes/genericAckPacket.hpp"
 #include "../packetTypes/genericNAckPacket.hpp"
 #include "../packetTypes/logPacket.hpp"
 #include "../packetTypes/pingPacket.hpp"
+#include "../packetTypes/fetchValuesPacket.hpp"
 #include "../packetTypes/resetPacket.hpp"
 #include "../packetTypes/updateBoolArrayPacket.hpp"
 #include "../packetTypes/updateIntArrayPacket.hpp"
 #include "../packetTypes/updateFloatArrayPacket.hpp"
 #include "../packetTypes/updateDoubleArrayPacket.hpp"
-#include "../packetTypes/updateFloatArrayPacket.hpp"
+#include "../packetTypes/updateBoolPacket.hpp"
+#include "../packetTypes/batchPacketV2.hpp"
+#include "../packetTypes/selectiveAckPacket.hpp"
+#include "../packetTypes/updateQuantizedArrayPacket.hpp"
+#include "../packetTypes/visionFramePacket.hpp"
 
 namespace vexbridge::serial
 {
@@ -26,44 +33,62 @@ namespace vexbridge::serial
     {
         /**
          * Gets a packet type by it's type ID.
+         * Looks up a table indexed by type ID, so it is constant time.
          * @param typeID The type ID of the packet type to get.
          * @return The packet type or nullptr if not found.
          */
-        static SerialPacketType *get(const SerialPacketTypeID typeID)
-        {
-            // Calculate Length of Packet Types
-            size_t length = sizeof(ALL_PACKET_TYPES) / sizeof(ALL_PACKET_TYPES[0]);
+        static SerialPacketType *get(const SerialPacketTypeID typeID);
 
-            // Iterate through all packet types
-            for (size_t i = 0; i < length; i++)
-            {
-                // Check if the packet type matches
-                if (ALL_PACKET_TYPES[i]->typeID == typeID)
-                    return ALL_PACKET_TYPES[i];
-            }
+    private:
+        /// @brief The single instance of a packet type
+        template <typename TPacketType>
+        static inline TPacketType instance;
 
-            // Packet type not found
-            return nullptr;
-        }
+        /// @brief Table of every packet type, indexed by type ID
+        using PacketTypeTable = std::array<SerialPacketType *, 256>;
 
-        /// @brief Array containing all SerialPacketType objects
-        static SerialPacketType *ALL_PACKET_TYPES[14];
+        /**
+         * Builds the packet type table at compile time.
+         * @return The packet type table.
+         */
+        static constexpr PacketTypeTable makeTable();
     };
 }
 
+// Batch packets look up their sub-packet types in `AllPacketTypes`, so they must be included after it is declared
+#include "../packetTypes/batchPacket.hpp"
+
 // Assign Packet Types
-vexbridge::serial::SerialPacketType *vexbridge::serial::AllPacketTypes::ALL_PACKET_TYPES[] = {
-    new AssignLabelPacketType(),
-    new UpdateIntPacketType(),
-    new UpdateFloatPacketType(),
-    new UpdateDoublePacketType(),
-    new UpdateStringPacketType(),
-    new GenericAckPacketType(),
-    new GenericNAckPacketType(),
-    new LogPacketType(),
-    new PingPacketType(),
-    new ResetPacketType(),
-    new UpdateBoolArrayPacketType(),
-    new UpdateIntArrayPacketType(),
-    new UpdateFloatArrayPacketType(),
-    new UpdateDoubleArrayPacketType()};
+constexpr vexbridge::serial::AllPacketTypes::PacketTypeTable vexbridge::serial::AllPacketTypes::makeTable()
+{
+    PacketTypeTable table = {};
+    table[(uint8_t)SerialPacketTypeID::RESET] = &instance<ResetPacketType>;
+    table[(uint8_t)SerialPacketTypeID::ASSIGN_LABEL] = &instance<AssignLabelPacketType>;
+    table[(uint8_t)SerialPacketTypeID::FETCH_VALUES] = &instance<FetchValuesPacketType>;
+    table[(uint8_t)SerialPacketTypeID::LOG] = &instance<LogPacketType>;
+    table[(uint8_t)SerialPacketTypeID::PING] = &instance<PingPacketType>;
+    table[(uint8_t)SerialPacketTypeID::GENERIC_ACK] = &instance<GenericAckPacketType>;
+    table[(uint8_t)SerialPacketTypeID::GENERIC_NACK] = &instance<GenericNAckPacketType>;
+    table[(uint8_t)SerialPacketTypeID::SELECTIVE_ACK] = &instance<SelectiveAckPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_BOOL] = &instance<UpdateBoolPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_INT] = &instance<UpdateIntPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_FLOAT] = &instance<UpdateFloatPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_DOUBLE] = &instance<UpdateDoublePacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_STRING] = &instance<UpdateStringPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_RECORD] = &instance<UpdateRecordPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_BOOL_ARRAY] = &instance<UpdateBoolArrayPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_INT_ARRAY] = &instance<UpdateIntArrayPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_FLOAT_ARRAY] = &instance<UpdateFloatArrayPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_DOUBLE_ARRAY] = &instance<UpdateDoubleArrayPacketType>;
+    table[(uint8_t)SerialPacketTypeID::UPDATE_QUANTIZED_ARRAY] = &instance<UpdateQuantizedArrayPacketType>;
+    table[(uint8_t)SerialPacketTypeID::VISION_FRAME] = &instance<VisionFramePacketType>;
+    table[(uint8_t)SerialPacketTypeID::BATCH_PACKET_V2] = &instance<BatchPacketV2Type>;
+    table[(uint8_t)SerialPacketTypeID::BATCH_PACKET] = &instance<BatchPacketType>;
+    return table;
+}
+
+inline vexbridge::serial::SerialPacketType *vexbridge::serial::AllPacketTypes::get(const SerialPacketTypeID typeID)
+{
+    static constexpr PacketTypeTable PACKET_TYPES = makeTable();
+    return PACKET_TYPES[(uint8_t)typeID];
+}
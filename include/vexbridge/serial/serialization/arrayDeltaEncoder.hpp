@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include "../packetTypes/updateFloatArrayPacket.hpp"
+#include "../packetTypes/updateDoubleArrayPacket.hpp"
+#include "../packetTypes/updateQuantizedArrayPacket.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * Converts float and double array updates into `UpdateQuantizedArrayPacket`s.
+     * Arrays are quantized to 16-bit fixed point and sent as the ranges that changed since the last version
+     * the receiver acknowledged. Keyframes are sent when there is no acknowledged version to build on.
+     * Each `SerialPacketWriter` owns its own encoder, since acknowledgements are per serial port.
+     * Not synchronized, the owner must lock around every call.
+     */
+    class ArrayDeltaEncoder
+    {
+    public:
+        /**
+         * Checks if a packet is an array update that can be quantized.
+         * @param packet The packet to check.
+         * @return True if the packet is a float or double array update.
+         */
+        static bool canEncode(const SerialPacket &packet)
+        {
+            return packet.type == SerialPacketTypeID::UPDATE_FLOAT_ARRAY ||
+                   packet.type == SerialPacketTypeID::UPDATE_DOUBLE_ARRAY;
+        }
+
+        /**
+         * Quantizes an array update.
+         * @param packet The packet to encode.
+         * @return The quantized packet, or `packet` if it is not a float or double array update.
+         */
+        std::shared_ptr<SerialPacket> encode(std::shared_ptr<SerialPacket> packet)
+        {
+            if (packet->type == SerialPacketTypeID::UPDATE_FLOAT_ARRAY)
+            {
+                auto &arrayPacket = static_cast<const UpdateFloatArrayPacket &>(*packet);
+                return encodeArray(arrayPacket.valueID, arrayPacket.type, arrayPacket.newValue);
+            }
+            if (packet->type == SerialPacketTypeID::UPDATE_DOUBLE_ARRAY)
+            {
+                auto &arrayPacket = static_cast<const UpdateDoubleArrayPacket &>(*packet);
+                return encodeArray(arrayPacket.valueID, arrayPacket.type, arrayPacket.newValue);
+            }
+            return packet;
+        }
+
+        /**
+         * Marks a quantized array version as received, so later updates are sent as deltas against it.
+         * Should be called when a packet sent by the owner is acknowledged.
+         * @param packet The acknowledged packet.
+         */
+        void onAcknowledged(const SerialPacket &packet)
+        {
+            if (packet.type != SerialPacketTypeID::UPDATE_QUANTIZED_ARRAY)
+                return;
+            auto &arrayPacket = static_cast<const UpdateQuantizedArrayPacket &>(packet);
+
+            // Ignore ACKs of versions that were replaced before they were acknowledged
+            auto it = arrayStates.find(arrayPacket.valueID);
+            if (it == arrayStates.end())
+                return;
+            ArrayState &state = it->second;
+            if (!state.isInFlight || state.inFlightVersion != arrayPacket.version)
+                return;
+
+            // The in-flight version becomes the base of later deltas
+            state.ackedValues.swap(state.inFlightValues);
+            state.ackedScale = arrayPacket.scale;
+            state.ackedVersion = arrayPacket.version;
+            state.hasAcked = true;
+            state.isInFlight = false;
+        }
+
+        /**
+         * Forgets every acknowledged version, so the next update of each array is a keyframe.
+         * Should be called when the receiver may have lost its arrays, such as when it resets or resyncs.
+         * Version numbers keep counting, so ACKs of packets sent before the reset are ignored.
+         */
+        void reset()
+        {
+            for (auto &[valueID, state] : arrayStates)
+            {
+                state.ackedValues.clear();
+                state.hasAcked = false;
+                state.isInFlight = false;
+                state.deltaCount = 0;
+            }
+        }
+
+    private:
+        /**
+         * Versions of an array sent to the receiver.
+         */
+        struct ArrayState
+        {
+            /// @brief Quantized elements of the last acknowledged version
+            std::vector<int16_t> ackedValues;
+
+            /// @brief Quantized elements of the version waiting for acknowledgement
+            std::vector<int16_t> inFlightValues;
+
+            float ackedScale = 1;
+            uint16_t ackedVersion = 0;
+            uint16_t inFlightVersion = 0;
+            uint16_t nextVersion = 0;
+            bool hasAcked = false;
+            bool isInFlight = false;
+
+            /// @brief Number of deltas sent since the last keyframe
+            uint8_t deltaCount = 0;
+        };
+
+        /**
+         * Quantizes an array and builds a keyframe or delta packet.
+         * @param valueID The ID of the array.
+         * @param arrayType The array update type the receiver stores the values as.
+         * @param values The new array.
+         * @return The quantized packet.
+         */
+        template <typename T>
+        std::shared_ptr<SerialPacket> encodeArray(uint16_t valueID, SerialPacketTypeID arrayType, const std::vector<T> &values)
+        {
+            ArrayState &state = arrayStates[valueID];
+            uint16_t length = std::min<size_t>(values.size(), UINT16_MAX);
+
+            // Deltas need an acknowledged base with a scale that fits every new value.
+            // Only one version is in flight at a time, since the receiver keeps a single version to apply deltas to.
+            // Values that are not finite are left out, since they are sent as 0 and would push the scale out of range
+            double maxValue = 0;
+            for (uint16_t i = 0; i < length; i++)
+                if (std::isfinite(values[i]))
+                    maxValue = std::max(maxValue, (double)std::fabs(values[i]));
+            bool useDelta = state.hasAcked &&
+                            !state.isInFlight &&
+                            state.deltaCount < KEYFRAME_INTERVAL &&
+                            maxValue <= state.ackedScale * INT16_MAX;
+            float scale = useDelta ? state.ackedScale : getScale(maxValue);
+
+            // Quantize the new array
+            std::vector<int16_t> &quantized = state.inFlightValues;
+            quantized.resize(length);
+            for (uint16_t i = 0; i < length; i++)
+                quantized[i] = quantize(values[i], scale);
+
+            // Make new quantized array packet
+            auto packet = makePacket<UpdateQuantizedArrayPacket>();
+            packet->type = SerialPacketTypeID::UPDATE_QUANTIZED_ARRAY;
+            packet->valueID = valueID;
+            packet->arrayType = arrayType;
+            packet->version = state.nextVersion++;
+            packet->scale = scale;
+            packet->length = length;
+
+            // Send only the changed ranges if that is smaller than the whole array
+            if (useDelta)
+                findChangedRanges(state.ackedValues, quantized, packet->ranges);
+            if (useDelta && getRangesSize(packet->ranges) < length * sizeof(int16_t))
+            {
+                packet->baseVersion = state.ackedVersion;
+                state.deltaCount++;
+            }
+            else
+            {
+                packet->baseVersion = packet->version;
+                packet->ranges.clear();
+                packet->ranges.push_back({0, quantized});
+                state.deltaCount = 0;
+            }
+
+            // Replaces any version that was never acknowledged
+            state.inFlightVersion = packet->version;
+            state.isInFlight = true;
+            return packet;
+        }
+
+        /**
+         * Finds the ranges of elements that differ between two arrays.
+         * Ranges separated by fewer elements than a range header are merged.
+         * @param base The acknowledged array.
+         * @param values The new array.
+         * @param ranges Filled with the changed ranges of `values`.
+         */
+        static void findChangedRanges(const std::vector<int16_t> &base,
+                                      const std::vector<int16_t> &values,
+                                      std::vector<QuantizedArrayRange> &ranges)
+        {
+            size_t i = 0;
+            while (i < values.size())
+            {
+                // Skip unchanged elements
+                if (i < base.size() && base[i] == values[i])
+                {
+                    i++;
+                    continue;
+                }
+
+                // Extend the range until enough unchanged elements follow
+                size_t start = i;
+                size_t end = i + 1;
+                for (size_t j = end; j < values.size() && j - end < RANGE_MERGE_GAP; j++)
+                    if (j >= base.size() || base[j] != values[j])
+                        end = j + 1;
+
+                ranges.push_back({(uint16_t)start, std::vector<int16_t>(values.begin() + start, values.begin() + end)});
+                i = end;
+            }
+        }
+
+        /**
+         * Gets the number of payload bytes used by a list of ranges.
+         * @param ranges The ranges.
+         * @return The size in bytes.
+         */
+        static size_t getRangesSize(const std::vector<QuantizedArrayRange> &ranges)
+        {
+            size_t size = 0;
+            for (const QuantizedArrayRange &range : ranges)
+                size += RANGE_HEADER_SIZE + range.values.size() * sizeof(int16_t);
+            return size;
+        }
+
+        /**
+         * Gets the smallest scale that fits a value in 16 bits.
+         * @param maxValue The largest absolute finite value in the array.
+         * @return The scale.
+         */
+        static float getScale(double maxValue)
+        {
+            if (maxValue <= 0)
+                return 1;
+            return std::min(maxValue / INT16_MAX, (double)std::numeric_limits<float>::max());
+        }
+
+        /**
+         * Quantizes a value to 16-bit fixed point.
+         * Values that are not finite are sent as 0, and values out of range are clamped,
+         * since rounding error in the scale may push the largest value just past `INT16_MAX`.
+         * @param value The value.
+         * @param scale The scale of the array.
+         * @return The quantized value.
+         */
+        static int16_t quantize(double value, float scale)
+        {
+            if (!std::isfinite(value))
+                return 0;
+            return (int16_t)std::lround(std::clamp(value / scale, (double)-INT16_MAX, (double)INT16_MAX));
+        }
+
+        /// @brief Size of the start and count fields of a range in bytes
+        static constexpr size_t RANGE_HEADER_SIZE = 4;
+
+        /// @brief Unchanged elements between two ranges that are sent anyway to save a range header
+        static constexpr size_t RANGE_MERGE_GAP = RANGE_HEADER_SIZE / sizeof(int16_t);
+
+        /// @brief Maximum number of deltas between keyframes, so a receiver that lost its base recovers
+        static constexpr uint8_t KEYFRAME_INTERVAL = 16;
+
+        /// @brief Sent versions of each array, indexed by value ID
+        std::unordered_map<uint16_t, ArrayState> arrayStates;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vexbridge::serial
+{
+    /**
+     * How frames are delimited on the serial port.
+     * Both sides of a serial port must use the same framing.
+     */
+    enum class FramingType : uint8_t
+    {
+        /// @brief Start flag, escaped frame, and 0x00 end flag. See `ByteStuffer`.
+        BYTE_STUFFING = 0,
+
+        /// @brief COBS encoded frame and 0x00 delimiter. See `Cobs`.
+        COBS = 1,
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vexbridge::serial
+{
+    /**
+     * How updates of a value are delivered.
+     */
+    enum class QoS : uint8_t
+    {
+        /// @brief Every update is acknowledged and resent until it arrives. Used for labels, resets, and parameters.
+        RELIABLE = 0,
+
+        /// @brief Updates are sent once and never acknowledged. Only the latest unsent update of each value is kept,
+        /// so a congested link drops superseded values instead of resending stale ones.
+        /// Used for high-rate telemetry that is replaced on the next update anyway.
+        BEST_EFFORT = 1,
+    };
+}
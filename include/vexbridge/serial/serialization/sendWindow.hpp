@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "../packetTypes/common/sentSerialPacket.h"
+
+namespace vexbridge::serial
+{
+    /**
+     * Packets that were sent but not acknowledged, stored in a ring indexed by sequence number.
+     * Finding, adding, and removing a packet are O(1).
+     * Not synchronized, the owner must lock around every call.
+     * @tparam Size The maximum number of unacknowledged packets. Must be a power of 2.
+     */
+    template <size_t Size>
+    class SendWindow
+    {
+        static_assert(Size > 0 && (Size & (Size - 1)) == 0, "SendWindow size must be a power of 2");
+        static_assert(Size <= 0x8000, "SendWindow size must fit in half of the sequence space");
+
+    public:
+        /**
+         * Gets the number of sequence numbers between the oldest unacknowledged packet and the next packet.
+         * @return The number of sequence numbers in use.
+         */
+        size_t size() const
+        {
+            return (uint16_t)(nextSeq - baseSeq);
+        }
+
+        /**
+         * Checks if no packets are waiting for acknowledgement.
+         * @return True if the window is empty.
+         */
+        bool empty() const
+        {
+            return baseSeq == nextSeq;
+        }
+
+        /**
+         * Checks if another packet can be added.
+         * @return True if the window is full.
+         */
+        bool isFull() const
+        {
+            return size() >= Size;
+        }
+
+        /**
+         * Gets the sequence number of the oldest unacknowledged packet.
+         * @return The oldest sequence number. Equal to `getNextSeq` if the window is empty.
+         */
+        uint16_t getBaseSeq() const
+        {
+            return baseSeq;
+        }
+
+        /**
+         * Gets the sequence number that will be assigned to the next packet.
+         * @return The next sequence number.
+         */
+        uint16_t getNextSeq() const
+        {
+            return nextSeq;
+        }
+
+        /**
+         * Adds a packet with the next sequence number.
+         * The window must not be full.
+         * @param packet The packet that was sent.
+         * @param timestamp The time the packet was sent in milliseconds.
+         * @return The sequence number assigned to the packet.
+         */
+        uint16_t push(std::shared_ptr<SerialPacket> packet, uint32_t timestamp)
+        {
+            SentSerialPacket &sentPacket = slots[nextSeq & MASK];
+            sentPacket.packet = std::move(packet);
+            sentPacket.seq = nextSeq;
+            sentPacket.timestamp = timestamp;
+            sentPacket.retries = 0;
+            return nextSeq++;
+        }
+
+        /**
+         * Gets an unacknowledged packet by sequence number.
+         * @param seq The sequence number of the packet.
+         * @return The packet or nullptr if it is not in the window.
+         */
+        SentSerialPacket *get(uint16_t seq)
+        {
+            if ((uint16_t)(seq - baseSeq) >= size())
+                return nullptr;
+
+            SentSerialPacket &sentPacket = slots[seq & MASK];
+            return sentPacket.packet ? &sentPacket : nullptr;
+        }
+
+        /**
+         * Removes a packet from the window.
+         * The oldest sequence number moves forward past any packets that were already removed.
+         * @param seq The sequence number of the packet.
+         */
+        void remove(uint16_t seq)
+        {
+            SentSerialPacket *sentPacket = get(seq);
+            if (!sentPacket)
+                return;
+            sentPacket->packet.reset();
+
+            // Move past removed packets
+            while (baseSeq != nextSeq && !slots[baseSeq & MASK].packet)
+                baseSeq++;
+        }
+
+        /**
+         * Calls a function on every unacknowledged packet from oldest to newest.
+         * The function may remove the packet it is called with.
+         * @param onPacket Called with a `SentSerialPacket &`.
+         */
+        template <typename F>
+        void forEach(F onPacket)
+        {
+            const uint16_t endSeq = nextSeq;
+            for (uint16_t seq = baseSeq; seq != endSeq; seq++)
+            {
+                SentSerialPacket &sentPacket = slots[seq & MASK];
+                if (sentPacket.packet)
+                    onPacket(sentPacket);
+            }
+        }
+
+    private:
+        static constexpr size_t MASK = Size - 1;
+
+        /// @brief Sent packets, indexed by sequence number
+        SentSerialPacket slots[Size];
+
+        /// @brief Sequence number of the oldest unacknowledged packet
+        uint16_t baseSeq = 0;
+
+        /// @brief Sequence number of the next packet
+        uint16_t nextSeq = 0;
+    };
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include "../../utils/ringBuffer.hpp"
+#include "../../utils/byteStuffer.hpp"
+#include "../../utils/cobs.hpp"
+#include "framingType.h"
+
+using namespace vexbridge::utils;
+
+namespace vexbridge::serial
+{
+    /**
+     * Splits a stream of stuffed or COBS encoded bytes into frames.
+     * Bytes are stored in a fixed-capacity ring buffer and frames are unstuffed into a fixed scratch array,
+     * so scanning a burst of frames never allocates and visits each byte once.
+     * @tparam Capacity The maximum number of buffered bytes. Must be a power of 2.
+     */
+    template <size_t Capacity>
+    class SerialFrameScanner
+    {
+    public:
+        /**
+         * Appends received bytes to the scanner.
+         * @param input The bytes received from the serial port.
+         * @return The number of bytes accepted. Less than `input.size()` if the buffer is full.
+         */
+        size_t write(std::span<const uint8_t> input)
+        {
+            return ringBuffer.write(input);
+        }
+
+        /**
+         * Gets the largest contiguous free region of the buffer, so a driver can read into it without copying.
+         * Bytes written into the region are added to the scanner with `commit`.
+         * @return The free region.
+         */
+        std::span<uint8_t> getWriteSpan()
+        {
+            return ringBuffer.getWriteSpan();
+        }
+
+        /**
+         * Adds bytes written into `getWriteSpan` to the scanner.
+         * @param length The number of bytes written.
+         */
+        void commit(const size_t length)
+        {
+            ringBuffer.commit(length);
+        }
+
+        /**
+         * Gets the number of bytes that can be written before the buffer is full.
+         * @return The number of free bytes.
+         */
+        size_t getFree() const
+        {
+            return ringBuffer.getFree();
+        }
+
+        /**
+         * Sets how frames are delimited.
+         * Drops all buffered bytes, since they were split using the previous framing.
+         * @param framingType The framing used by the sender.
+         */
+        void setFramingType(FramingType framingType)
+        {
+            this->framingType = framingType;
+            clear();
+        }
+
+        /**
+         * Drops all buffered bytes.
+         * Used when the buffer fills without containing an end flag (garbage or an oversized frame).
+         * @return The number of bytes dropped.
+         */
+        size_t clear()
+        {
+            size_t droppedSize = ringBuffer.size();
+            ringBuffer.clear();
+            scanOffset = 0;
+            isEscaping = false;
+            return droppedSize;
+        }
+
+        /**
+         * Finds the next complete frame and unstuffs it.
+         * @param frame Set to the unstuffed frame. Only valid until the next call to the scanner.
+         * @return True if a frame was found, false if more bytes are needed.
+         */
+        bool nextFrame(std::span<const uint8_t> &frame)
+        {
+            // Find the next unescaped end flag
+            size_t endOffset = findEndFlag();
+            if (endOffset == RingBuffer<Capacity>::NPOS)
+                return false;
+
+            // Unstuff the frame into the scratch array
+            // Contiguous frames are read directly from the ring buffer, wrapped frames are copied first
+            std::span<const uint8_t> stuffedFrame = ringBuffer.peek(endOffset + 1, scratch);
+            size_t frameSize = 0;
+            if (framingType == FramingType::COBS)
+            {
+                // Corrupt frames are returned empty, which fails to decode
+                frameSize = Cobs::decode(stuffedFrame.first(endOffset), scratch);
+                if (frameSize == Cobs::INVALID)
+                    frameSize = 0;
+            }
+            else
+            {
+                frameSize = ByteStuffer::decode(stuffedFrame, scratch);
+            }
+
+            // Remove the frame from the ring buffer
+            ringBuffer.discard(endOffset + 1);
+            scanOffset = 0;
+            isEscaping = false;
+
+            frame = std::span<const uint8_t>(scratch, frameSize);
+            return true;
+        }
+
+    private:
+        /**
+         * Scans the bytes that have not been scanned yet for an end flag that is not escaped.
+         * Escape state is kept between calls, so each byte is only visited once.
+         * Every 0x00 in the payload is escaped, so this steps through each contiguous region
+         * with a pointer rather than calling `memchr` once per escaped 0x00.
+         * COBS frames have no escapes, so they are searched with `memchr`.
+         * @return The offset of the end flag from the front of the ring buffer or `NPOS` if not found.
+         */
+        size_t findEndFlag()
+        {
+            // COBS frames never contain the delimiter, so the first 0x00 ends the frame
+            if (framingType == FramingType::COBS)
+            {
+                size_t endOffset = ringBuffer.find(Cobs::DELIMITER, scanOffset);
+                scanOffset = endOffset == RingBuffer<Capacity>::NPOS ? ringBuffer.size() : endOffset;
+                return endOffset;
+            }
+
+            // Keep the escape state in a local so it is not reloaded after each byte
+            bool escaping = isEscaping;
+            while (scanOffset < ringBuffer.size())
+            {
+                std::span<const uint8_t> region = ringBuffer.getReadSpan(scanOffset);
+                const uint8_t *bytes = region.data();
+                const size_t regionSize = region.size();
+                for (size_t i = 0; i < regionSize; i++)
+                {
+                    // The byte after an escape flag is always data
+                    if (escaping)
+                        escaping = false;
+                    else if (bytes[i] == ByteStuffer::ESCAPE_FLAG)
+                        escaping = true;
+                    else if (bytes[i] == ByteStuffer::END_FLAG)
+                        return scanOffset + i;
+                }
+                scanOffset += regionSize;
+            }
+            isEscaping = escaping;
+            return RingBuffer<Capacity>::NPOS;
+        }
+
+        /// @brief Bytes received but not yet split into frames
+        RingBuffer<Capacity> ringBuffer;
+
+        /// @brief Offset in `ringBuffer` that has already been searched for an end flag
+        size_t scanOffset = 0;
+
+        /// @brief True if the last scanned byte was an escape flag
+        bool isEscaping = false;
+
+        /// @brief How frames are delimited
+        FramingType framingType = FramingType::BYTE_STUFFING;
+
+        /// @brief Storage for the current unstuffed frame
+        uint8_t scratch[Capacity];
+    };
+}
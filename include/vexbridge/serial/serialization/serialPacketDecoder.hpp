@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include "allPacketTypes.hpp"
 #include "../../utils/bufferReader.hpp"
 #include "../../utils/checksum.hpp"
@@ -26,25 +27,61 @@ namespace vexbridge::serial
         {
             // Unstuff the buffer
             Buffer decodedBuffer = ByteStuffer::decode(buffer);
-            BufferReader reader(decodedBuffer);
+            return decodeFrame(decodedBuffer);
+        }
+
+        /**
+         * Decodes an unstuffed frame into a deserialized packet object.
+         * `ResetPacket`s are always checked with `ChecksumType::SUM8`, since they are sent before a checksum is agreed on.
+         * @param frame The unstuffed frame, starting at the packet type.
+         * @param checksumType The checksum algorithm agreed on with the sender.
+         * @return The deserialized packet object.
+         * @throws std::runtime_error if the frame is truncated, corrupt, or of an unknown type.
+         */
+        static std::unique_ptr<SerialPacket> decodeFrame(std::span<const uint8_t> frame, ChecksumType checksumType = ChecksumType::SUM8)
+        {
+            // Check the header is complete
+            if (frame.size() < HEADER_SIZE + 1)
+                throw std::runtime_error("Frame too short while decoding packet");
+            if (frame[0] == (uint8_t)SerialPacketTypeID::RESET)
+                checksumType = ChecksumType::SUM8;
+            size_t checksumSize = Checksum::getSize(checksumType);
 
             // Packet Data
-            uint8_t type = reader.readUInt8();              // Packet Type
-            uint8_t id = reader.readUInt8();                // Packet ID
-            uint16_t payloadSize = reader.readUInt16BE();   // Payload Size
-            Buffer payload = reader.readBytes(payloadSize); // Payload
-            uint8_t checksum = reader.readUInt8();          // Checksum
+            uint8_t type = frame[0];                                     // Packet Type
+            uint8_t flags = frame[1];                                    // Flags
+            uint16_t id = (uint16_t)(frame[2] << 8) | frame[3];          // Sequence Number
+            uint16_t payloadSize = (uint16_t)(frame[4] << 8) | frame[5]; // Payload Size
+
+            // Check the payload and checksum are complete
+            if (frame.size() < HEADER_SIZE + payloadSize + checksumSize)
+                throw std::runtime_error("Frame too short while decoding packet: " + std::to_string(id));
 
             // Check if the checksum is valid
-            uint8_t calculatedChecksum = Checksum::calc(decodedBuffer, payloadSize + 4);
+            uint32_t checksum = 0;
+            for (size_t i = 0; i < checksumSize; i++)
+                checksum = (checksum << 8) | frame[HEADER_SIZE + payloadSize + i];
+            uint32_t calculatedChecksum = Checksum::calc(checksumType, frame.first(HEADER_SIZE + payloadSize));
             if (checksum != calculatedChecksum)
                 throw std::runtime_error("Invalid checksum while decoding packet: " + std::to_string(id));
 
-            // Create Temporary Packet to store payload
+            // Read the timestamp before the payload
+            size_t payloadStart = HEADER_SIZE;
+            uint32_t timestamp = 0;
+            if (flags & SerialPacketFlag::HAS_TIMESTAMP)
+            {
+                if (payloadSize < TIMESTAMP_SIZE)
+                    throw std::runtime_error("Payload too short for timestamp while decoding packet: " + std::to_string(id));
+                for (size_t i = 0; i < TIMESTAMP_SIZE; i++)
+                    timestamp = (timestamp << 8) | frame[HEADER_SIZE + i];
+                payloadStart += TIMESTAMP_SIZE;
+            }
+
+            // View the payload in place rather than copying it out of the frame
             EncodedSerialPacket tempPacket;
             tempPacket.id = id;
             tempPacket.type = (SerialPacketTypeID)type;
-            tempPacket.payload = payload;
+            tempPacket.payload = frame.subspan(payloadStart, HEADER_SIZE + payloadSize - payloadStart);
 
             // Find the packet type
             SerialPacketType *packetType = AllPacketTypes::get(tempPacket.type);
@@ -52,7 +89,17 @@ namespace vexbridge::serial
                 throw std::runtime_error("Unknown packet type while decoding: " + std::to_string(type));
 
             // Deserialize the packet
-            return packetType->deserialize(tempPacket);
+            auto packet = packetType->deserialize(tempPacket);
+            packet->flags = flags;
+            packet->timestamp = timestamp;
+            return packet;
         }
+
+    private:
+        /// @brief Size of the type, flags, sequence number, and payload size fields
+        static constexpr size_t HEADER_SIZE = 6;
+
+        /// @brief Size of the sender timestamp at the start of the payload of packets flagged with `HAS_TIMESTAMP`
+        static constexpr size_t TIMESTAMP_SIZE = 4;
     };
 }
\ No newline at end of file
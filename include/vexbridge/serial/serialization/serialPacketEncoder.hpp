@@ -1,10 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <mutex>
+#include "pros/rtos.hpp"
 #include "allPacketTypes.hpp"
 #include "../packetTypes/common/serialPacketType.h"
 #include "../../utils/checksum.hpp"
 #include "../../utils/byteStuffer.hpp"
+#include "../../utils/cobs.hpp"
+#include "framingType.h"
 
 namespace vexbridge::serial
 {
@@ -16,35 +23,190 @@ namespace vexbridge::serial
         /**
          * Encodes a serializable packet into a complete packet.
          * @param packet The packet to encode.
-         * @param buffer The buffer to write the encoded packet to.
-         * @return The size of the encoded packet.
+         * @return The encoded packet.
          */
         static Buffer encode(const SerialPacket &packet)
+        {
+            return encode(packet, packet.id);
+        }
+
+        /**
+         * Encodes a serializable packet into a complete packet with a specific sequence number.
+         * The packet itself is not modified, so the same packet can be sent by several writers.
+         * `ResetPacket`s always use `ChecksumType::SUM8`, since they are sent before a checksum is agreed on.
+         * @param packet The packet to encode.
+         * @param seq The sequence number to write in the header.
+         * @param checksumType The checksum algorithm agreed on with the receiver.
+         * @param framingType How the frame is delimited.
+         * @return The encoded packet.
+         */
+        static Buffer encode(const SerialPacket &packet,
+                             uint16_t seq,
+                             ChecksumType checksumType = ChecksumType::SUM8,
+                             FramingType framingType = FramingType::BYTE_STUFFING)
+        {
+            Buffer output;
+            encode(packet, seq, checksumType, framingType, output);
+            return output;
+        }
+
+        /**
+         * Encodes a serializable packet into an existing buffer.
+         * The payload is serialized straight into `output` and framed in place,
+         * so encoding into a `StaticBuffer` does not allocate for types that override `SerialPacketType::serializePayload`.
+         * @tparam TBuffer `Buffer` or `StaticBuffer`.
+         * @param packet The packet to encode.
+         * @param seq The sequence number to write in the header.
+         * @param checksumType The checksum algorithm agreed on with the receiver.
+         * @param framingType How the frame is delimited.
+         * @param output The buffer to replace with the encoded packet.
+         * @throws std::runtime_error if the packet type is unknown or the encoded packet does not fit in `output`.
+         */
+        template <typename TBuffer>
+        static void encode(const SerialPacket &packet,
+                           uint16_t seq,
+                           ChecksumType checksumType,
+                           FramingType framingType,
+                           TBuffer &output)
+        {
+            output.clear();
+            BufferWriter packetWriter(output);
+            writeBody(packet, seq, packetWriter);
+            writeFrame(packetWriter, checksumType, framingType, output);
+        }
+
+        /**
+         * Gets the header and payload of a packet, serialized the first time they are needed.
+         * The result is immutable and kept with the packet, so every socket that sends the packet,
+         * and every resend, shares it rather than serializing the payload again.
+         * The sequence number is left 0 and written by `encodeBody`.
+         * @param packet The packet to serialize. Must not be modified once sent.
+         * @return The serialized header and payload.
+         * @throws std::runtime_error if the packet type is unknown.
+         */
+        static std::shared_ptr<const Buffer> getBody(const SerialPacket &packet)
+        {
+            // Released by the guard if serializing throws
+            std::lock_guard<pros::Mutex> lock(bodyMutex);
+            if (!packet.encodedBody)
+            {
+                auto body = std::allocate_shared<Buffer>(PoolAllocator<Buffer>());
+                BufferWriter bodyWriter(*body);
+                writeBody(packet, 0, bodyWriter);
+                packet.encodedBody = std::move(body);
+            }
+            return packet.encodedBody;
+        }
+
+        /**
+         * Frames a header and payload from `getBody` with a specific sequence number.
+         * The sequence number is patched in at its fixed offset in the header, so the payload is not serialized again.
+         * Only the checksum and framing are computed, since both cover the sequence number and may differ by socket.
+         * @tparam TBuffer `Buffer` or `StaticBuffer`.
+         * @param body The serialized header and payload.
+         * @param seq The sequence number to write in the header.
+         * @param checksumType The checksum algorithm agreed on with the receiver.
+         * @param framingType How the frame is delimited.
+         * @param output The buffer to replace with the encoded packet.
+         * @throws std::runtime_error if the encoded packet does not fit in `output`.
+         */
+        template <typename TBuffer>
+        static void encodeBody(std::span<const uint8_t> body,
+                               uint16_t seq,
+                               ChecksumType checksumType,
+                               FramingType framingType,
+                               TBuffer &output)
+        {
+            output.clear();
+            BufferWriter packetWriter(output);
+            packetWriter.writeBytes(body);
+            packetWriter.setUInt16BE(SEQ_OFFSET, seq);
+            writeFrame(packetWriter, checksumType, framingType, output);
+        }
+
+    private:
+        /// @brief Size of the type, flags, sequence number, and payload size fields
+        static constexpr size_t HEADER_SIZE = 6;
+
+        /// @brief Offset of the sequence number in the header
+        static constexpr size_t SEQ_OFFSET = 2;
+
+        /// @brief Guards the bodies cached on packets, since several sockets may send the same packet at once
+        static inline pros::Mutex bodyMutex;
+
+        /**
+         * Serializes the header and payload of a packet.
+         * @param packet The packet to serialize.
+         * @param seq The sequence number to write in the header.
+         * @param packetWriter The writer to append to. Must be empty.
+         * @throws std::runtime_error if the packet type is unknown or the payload is too large.
+         */
+        static void writeBody(const SerialPacket &packet, uint16_t seq, BufferWriter &packetWriter)
         {
             // Find the packet type
             SerialPacketType *packetType = AllPacketTypes::get(packet.type);
             if (packetType == nullptr)
                 throw std::runtime_error("Unknown packet type while encoding: " + std::to_string((uint8_t)packet.type));
 
-            // Serialize the packet
-            auto encodedPacket = packetType->serialize(packet);
+            // Header
+            // The payload size is filled in after the payload is serialized
+            packetWriter.writeUInt8((uint8_t)packet.type); // Type
+            packetWriter.writeUInt8(packet.flags);         // Flags
+            packetWriter.writeUInt16BE(seq);               // Sequence Number
+            packetWriter.writeUInt16BE(0);                 // Payload Size
 
-            // Create the packet buffer
-            Buffer packetBuffer;
-            BufferWriter packerWriter(packetBuffer);
+            // Timestamp
+            if (packet.flags & SerialPacketFlag::HAS_TIMESTAMP)
+                packetWriter.writeUInt32BE(packet.timestamp);
 
-            // Packet
-            packerWriter.writeUInt8((uint8_t)encodedPacket->type);                          // Type
-            packerWriter.writeUInt8(encodedPacket->id);                                     // ID
-            packerWriter.writeUInt16BE(encodedPacket->payload.size());                      // Payload Size
-            packerWriter.writeBytes(encodedPacket->payload, encodedPacket->payload.size()); // Payload
+            // Payload
+            packetType->serializePayload(packet, packetWriter);
+            size_t payloadSize = packetWriter.getOffset() - HEADER_SIZE;
+            if (payloadSize > 0xFFFF)
+                throw std::runtime_error("Packet payload is too large: " + std::to_string(payloadSize));
+            packetWriter.setUInt16BE(4, payloadSize);
+        }
 
+        /**
+         * Appends the checksum to a serialized header and payload, then frames it in place.
+         * `ResetPacket`s always use `ChecksumType::SUM8`, since they are sent before a checksum is agreed on.
+         * @tparam TBuffer `Buffer` or `StaticBuffer`.
+         * @param packetWriter The writer holding the header and payload.
+         * @param checksumType The checksum algorithm agreed on with the receiver.
+         * @param framingType How the frame is delimited.
+         * @param output The buffer `packetWriter` writes to.
+         */
+        template <typename TBuffer>
+        static void writeFrame(BufferWriter &packetWriter, ChecksumType checksumType, FramingType framingType, TBuffer &output)
+        {
             // Checksum
-            uint8_t checksum = Checksum::calc(packetBuffer, packerWriter.getOffset());
-            packerWriter.writeUInt8(checksum);
+            if (output.data()[0] == (uint8_t)SerialPacketTypeID::RESET)
+                checksumType = ChecksumType::SUM8;
+            uint32_t checksum = Checksum::calc(checksumType, packetWriter.getWritten());
+            if (checksumType == ChecksumType::CRC32)
+                packetWriter.writeUInt32BE(checksum);
+            else if (checksumType == ChecksumType::CRC16)
+                packetWriter.writeUInt16BE(checksum);
+            else
+                packetWriter.writeUInt8(checksum);
+
+            // COBS
+            // The frame is moved back by the overhead so it can be encoded in place
+            size_t frameSize = output.size();
+            if (framingType == FramingType::COBS)
+            {
+                size_t prefixSize = Cobs::getMaxOverhead(frameSize);
+                output.resize(Cobs::getMaxEncodedSize(frameSize));
+                memmove(output.data() + prefixSize, output.data(), frameSize);
+                size_t encodedSize = Cobs::encode(std::span<const uint8_t>(output.data() + prefixSize, frameSize),
+                                                  std::span<uint8_t>(output.data(), output.size()));
+                output.resize(encodedSize);
+                return;
+            }
 
             // Byte Stuff
-            return ByteStuffer::encode(packetBuffer);
+            output.resize(ByteStuffer::getEncodedSize(std::span<const uint8_t>(output.data(), frameSize)));
+            ByteStuffer::encodeInPlace(output.data(), frameSize);
         }
     };
 }
\ No newline at end of file
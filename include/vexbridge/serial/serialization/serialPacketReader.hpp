@@ -2,14 +2,24 @@
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <span>
+#include <algorithm>
+#include <atomic>
 #include "pros/rtos.hpp"
 #include "../packetTypes/common/sentSerialPacket.h"
 #include "../packetTypes/common/serialPacket.h"
 #include "../packetTypes/common/encodedSerialPacket.h"
 #include "../drivers/serialDriver.hpp"
 #include "../serialization/serialPacketDecoder.hpp"
+#include "../serialization/serialFrameScanner.hpp"
 #include "../helpers/updateValuePacketHandler.hpp"
 #include "../helpers/ackPacketHandler.hpp"
+#include "../helpers/quantizedArrayPacketHandler.hpp"
+#include "../helpers/resetPacketHandler.hpp"
+#include "../helpers/fetchValuesPacketHandler.hpp"
+#include "../helpers/visionFramePacketHandler.hpp"
+#include "../helpers/pingPacketHandler.hpp"
+#include "../../utils/clockSync.hpp"
 
 namespace vexbridge::serial
 {
@@ -37,31 +47,82 @@ namespace vexbridge::serial
 
         /**
          * Reads packets from the serial port and handles them.
+         * Reads at most `MAX_READ_PER_UPDATE` bytes, so a burst of data is spread across updates
+         * instead of stalling the daemon.
+         * Then continues any snapshot the host requested, as far as the send window allows.
          */
         void readPacketsFromSerial()
         {
-            while (true)
+            size_t readBudget = MAX_READ_PER_UPDATE;
+            while (readBudget > 0)
             {
-                // Read a packet from the serial port
-                auto packet = readPacketFromSerial();
-                if (!packet)
-                    break; // No packet available
-
-                // Handle the packet
-                try
-                {
-                    // Handle Value Packets
-                    UpdateValuePacketHandler::handlePacket(packet.get());
-
-                    // Handle ACK Packets
-                    AckPacketHandler::handlePacket(packet.get(), serialWriter.get());
-                }
-                catch (std::exception &e)
-                {
-                    // Log the error
-                    // printf("Failed to handle packet: %s\n", e.what());
-                }
+                // Drop the buffered bytes if they fill the scanner without an end flag
+                // Prevents garbage data from stalling the reader
+                if (frameScanner.getFree() == 0)
+                    discardedCount.fetch_add(frameScanner.clear(), std::memory_order_relaxed);
+
+                // Read directly into the free space of the scanner
+                // Packets may be split across multiple read operations, so partial frames remain in the scanner
+                std::span<uint8_t> writeSpan = frameScanner.getWriteSpan();
+                writeSpan = writeSpan.first(std::min(writeSpan.size(), readBudget));
+                int32_t bytesRead = serialDriver->read(writeSpan);
+
+                // Stop if no data was read
+                if (bytesRead <= 0)
+                    break;
+                frameScanner.commit(bytesRead);
+                readBudget -= std::min((size_t)bytesRead, readBudget);
+
+                // Handle every complete frame
+                std::span<const uint8_t> frame;
+                while (frameScanner.nextFrame(frame))
+                    handleFrame(frame);
+
+                // Stop once the serial port is drained
+                // The write span may also end at the wrap point of the scanner, in which case the loop continues
+                if ((size_t)bytesRead < writeSpan.size())
+                    break;
             }
+
+            // Send more of the snapshot now that ACKs may have freed the send window
+            try
+            {
+                if (serialWriter)
+                    FetchValuesPacketHandler::continueSnapshot(serialWriter.get(), snapshot);
+            }
+            catch (std::exception &e)
+            {
+                // Do nothing
+                // A batch that fails to serialize is dropped, and the snapshot continues with the next one
+            }
+        }
+
+        /**
+         * Gets the number of received bytes discarded because they filled the scanner without completing a frame,
+         * such as line noise or a frame larger than the scanner.
+         * @return The number of discarded bytes.
+         */
+        uint32_t getDiscardedCount() const
+        {
+            return discardedCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets the estimate of the sender's clock, measured by `PingPacket` exchanges.
+         * @return The clock estimate.
+         */
+        const ClockSync &getClockSync() const
+        {
+            return clockSync;
+        }
+
+        /**
+         * Sets how frames are delimited.
+         * @param framingType The framing used by the sender.
+         */
+        void setFramingType(FramingType framingType)
+        {
+            frameScanner.setFramingType(framingType);
         }
 
         /**
@@ -75,74 +136,68 @@ namespace vexbridge::serial
 
     protected:
         /**
-         * Reads the next packet from the serial port.
-         * @return The packet read from the serial port or nullptr if no packet is available.
+         * Decodes and handles a single unstuffed frame.
+         * @param frame The unstuffed frame.
          */
-        std::unique_ptr<SerialPacket> readPacketFromSerial()
+        void handleFrame(std::span<const uint8_t> frame)
         {
-            // Read data from the serial port
-            Buffer inputBuffer;
-            int32_t bytesRead = serialDriver->read(inputBuffer);
-
-            // Abort if no data was read
-            if (bytesRead <= 0)
-                return nullptr;
-
-            // Append to the read buffer
-            // This allows packets to be split across multiple read operations
-            readBuffer.reserve(readBuffer.size() + bytesRead);
-            readBuffer.insert(readBuffer.end(), inputBuffer.begin(), inputBuffer.end());
-
-            // Trim the read buffer to prevent it from growing too large
-            // Prevents memory leaks if the read buffer is never cleared (e.g. if no packets are found / garbage data is received)
-            if (readBuffer.size() > MAX_BUFFER_SIZE)
-                readBuffer.erase(readBuffer.begin(), readBuffer.begin() + readBuffer.size() - MAX_BUFFER_SIZE);
-
-            // Iterate through the read buffer
-            for (size_t i = 0; i < readBuffer.size(); i++)
+            try
             {
-                // If the current flag is an escape flag, skip the next byte
-                if (readBuffer[i] == ByteStuffer::ESCAPE_FLAG)
-                {
-                    i++;
-                    continue;
-                }
-
-                // If the current flag is not the end flag, skip it
-                if (readBuffer[i] != ByteStuffer::END_FLAG)
-                    continue;
-
-                // Decode the packet up to the end flag
-                try
-                {
-                    // TODO: Only splice the read queue up to "i"
-                    auto packet = SerialPacketDecoder::decode(readBuffer);
-
-                    // Remove the current segment from the read queue
-                    readBuffer.erase(readBuffer.begin(), readBuffer.begin() + i + 1);
-
-                    return packet;
-                }
-                catch (std::exception &e)
-                {
-                    // Do nothing
-                    // It's typical for the decoder to throw an exception if the packet got corrupt during transmission
-                }
-
-                // Remove the current segment from the read queue
-                readBuffer.erase(readBuffer.begin(), readBuffer.begin() + i + 1);
-            }
+                // Decode the packet
+                uint64_t receiveTime = pros::micros();
+                auto packet = SerialPacketDecoder::decodeFrame(frame, checksumType);
+
+                // Values were captured when the sender stamped them, or when they arrived if the clocks are not synchronized
+                uint64_t captureTime = receiveTime;
+                if ((packet->flags & SerialPacketFlag::HAS_TIMESTAMP) && clockSync.isSynchronized())
+                    captureTime = clockSync.toLocalTime(packet->timestamp, receiveTime);
+
+                // Handle Value Packets
+                UpdateValuePacketHandler::handlePacket(packet.get(), captureTime);
+                QuantizedArrayPacketHandler::handlePacket(packet.get(), captureTime);
+                VisionFramePacketHandler::handlePacket(packet.get(), captureTime);
+
+                // Handle ACK Packets
+                AckPacketHandler::handlePacket(packet.get(), serialWriter.get());
+
+                // Handle Clock Synchronization
+                PingPacketHandler::handlePacket(packet.get(), serialWriter.get(), clockSync, receiveTime);
+
+                // Handle Reset Packets
+                ResetPacketHandler::handlePacket(packet.get(), serialWriter.get(), checksumType);
 
-            // No packet found
-            return nullptr;
+                // Handle Snapshot Requests
+                FetchValuesPacketHandler::handlePacket(packet.get(), serialWriter.get(), snapshot);
+            }
+            catch (std::exception &e)
+            {
+                // Do nothing
+                // It's typical for the decoder to throw an exception if the packet got corrupt during transmission
+                // printf("Failed to handle packet: %s\n", e.what());
+            }
         }
 
     private:
-        /// @brief Maximum size of the read buffer. Prevents `readBuffer` from growing beyond hardware limits.
-        static constexpr size_t MAX_BUFFER_SIZE = 2048; // Maximum size of the read buffer
+        /// @brief Maximum number of buffered bytes. Also limits the size of a single frame.
+        static constexpr size_t MAX_BUFFER_SIZE = 4096;
+
+        /// @brief Maximum number of bytes read in a single update
+        static constexpr size_t MAX_READ_PER_UPDATE = 2048;
+
+        /// @brief Number of received bytes discarded by the scanner
+        std::atomic<uint32_t> discardedCount = 0;
+
+        /// @brief Splits the bytes read from the serial port into frames
+        SerialFrameScanner<MAX_BUFFER_SIZE> frameScanner;
+
+        /// @brief Offset and round-trip time of the sender's clock
+        ClockSync clockSync;
+
+        /// @brief Checksum agreed on with the sender
+        ChecksumType checksumType = ChecksumType::SUM8;
 
-        /// @brief Buffer of bytes read from the serial port
-        Buffer readBuffer;
+        /// @brief Progress of the snapshot requested by the host
+        SnapshotProgress snapshot;
 
         /// @brief Serial hardware driver to use for reading packets
         std::shared_ptr<SerialDriver> serialDriver;
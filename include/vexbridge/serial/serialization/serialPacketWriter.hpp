@@ -1,13 +1,21 @@
 #pragma once
 #include <vector>
+#include <deque>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 #include "pros/rtos.hpp"
 #include "../packetTypes/common/sentSerialPacket.h"
 #include "../packetTypes/common/serialPacket.h"
 #include "../packetTypes/common/encodedSerialPacket.h"
 #include "../drivers/serialDriver.hpp"
 #include "../serialization/serialPacketEncoder.hpp"
+#include "../serialization/sendWindow.hpp"
+#include "../serialization/arrayDeltaEncoder.hpp"
+#include "../recording/frameRecorder.hpp"
+#include "../../utils/rttEstimator.hpp"
 
 namespace vexbridge::serial
 {
@@ -35,6 +43,9 @@ namespace vexbridge::serial
 
         /**
          * Writes a packet to the serial port and handles acknowledgement and/or resending of the packet if needed.
+         * If the send window is full, the packet waits until an acknowledgement frees a slot.
+         * Reliable packets are never dropped to make room, so they are always written in the order they were sent.
+         * Packets flagged with `SerialPacketFlag::NO_ACK` are written once if the serial port has room and dropped otherwise.
          * @param serialPacket The packet to send.
          */
         void sendPacket(std::shared_ptr<SerialPacket> serialPacket)
@@ -42,27 +53,117 @@ namespace vexbridge::serial
             // Check if the packet is nullptr
             if (!serialPacket)
                 throw std::runtime_error("Cannot send a nullptr packet.");
+            recordPacket(*serialPacket);
 
-            // Assign the packet ID
-            static uint8_t packetID = 0;
-            serialPacket->id = packetID++;
+            // Best-effort packets are written once if they fit, and never tracked
+            if (serialPacket->flags & SerialPacketFlag::NO_ACK)
+            {
+                tryWriteBestEffort(*serialPacket);
+                return;
+            }
 
-            // Write the packet to the serial port
-            writePacketToSerial(serialPacket);
+            // Lock the mutex to prevent concurrent access
+            // Released by the guard if encoding throws
+            std::lock_guard<pros::Mutex> lock(sentPacketsMutex);
 
-            // Create a new sent packet
-            SentSerialPacket sentPacket;
-            sentPacket.packet = serialPacket;
-            sentPacket.timestamp = pros::millis();
+            // Wait behind any earlier packets for a free slot
+            waitingPackets.push_back(std::move(serialPacket));
+            sendWaitingPackets();
+        }
 
-            // Lock the mutex to prevent concurrent access
-            sentPacketsMutex.take();
+        /**
+         * Gets the number of reliable packets waiting for a free slot in the send window.
+         * @return The number of waiting packets.
+         */
+        size_t getWaitingCount()
+        {
+            std::lock_guard<pros::Mutex> lock(sentPacketsMutex);
+            return waitingPackets.size();
+        }
 
-            // Add the packet to the sent packets list
-            sentPackets.push_back(sentPacket);
+        /**
+         * Gets the number of reliable packets that can be sent before one has to wait for a free slot.
+         * @return The number of free slots in the send window, less the packets already waiting for one.
+         */
+        size_t getFreeSlotCount()
+        {
+            std::lock_guard<pros::Mutex> lock(sentPacketsMutex);
+            size_t usedCount = sentPackets.size() + waitingPackets.size();
+            return usedCount >= WINDOW_SIZE ? 0 : WINDOW_SIZE - usedCount;
+        }
 
-            // Unlock the mutex after adding the packet
-            sentPacketsMutex.give();
+        /**
+         * Sends the latest update of a best-effort value.
+         * The update is written once and never acknowledged or resent.
+         * If the serial port cannot take the frame yet, the update waits in a slot for its value,
+         * and a newer update of the same value replaces it rather than queuing behind it.
+         * @param valueID The ID of the value.
+         * @param serialPacket The update packet. Flagged with `SerialPacketFlag::NO_ACK`.
+         */
+        void sendLatest(uint16_t valueID, std::shared_ptr<SerialPacket> serialPacket)
+        {
+            // Check if the packet is nullptr
+            if (!serialPacket)
+                throw std::runtime_error("Cannot send a nullptr packet.");
+            serialPacket->flags |= SerialPacketFlag::NO_ACK;
+            recordPacket(*serialPacket);
+
+            latestMutex.take();
+
+            // Grow the slots to fit the ID
+            if (valueID >= latestPackets.size())
+                latestPackets.resize(valueID + 1);
+
+            // Replace any update that has not been written yet
+            if (latestPackets[valueID])
+                supersededCount.fetch_add(1, std::memory_order_relaxed);
+            else
+                latestIDs.push_back(valueID);
+            latestPackets[valueID] = std::move(serialPacket);
+
+            latestMutex.give();
+
+            // Write as many waiting updates as fit
+            writeLatestPackets();
+        }
+
+        /**
+         * Writes waiting best-effort updates, oldest first, until the serial port is full.
+         * Called whenever an update is added and on every socket update.
+         */
+        void writeLatestPackets()
+        {
+            // Released by the guard if encoding throws
+            std::lock_guard<pros::Mutex> lock(latestMutex);
+
+            size_t writtenCount = 0;
+            for (; writtenCount < latestIDs.size(); writtenCount++)
+            {
+                std::shared_ptr<SerialPacket> &packet = latestPackets[latestIDs[writtenCount]];
+                if (!tryWriteBestEffort(*packet))
+                    break;
+                packet.reset();
+            }
+            latestIDs.erase(latestIDs.begin(), latestIDs.begin() + writtenCount);
+        }
+
+        /**
+         * Checks if any best-effort updates are waiting for room on the serial port.
+         * @return True if `writeLatestPackets` has updates to write.
+         */
+        bool hasLatestPackets()
+        {
+            std::lock_guard<pros::Mutex> lock(latestMutex);
+            return !latestIDs.empty();
+        }
+
+        /**
+         * Gets the number of best-effort updates replaced by a newer update before they were written.
+         * @return The number of superseded updates.
+         */
+        uint32_t getSupersededCount() const
+        {
+            return supersededCount.load(std::memory_order_relaxed);
         }
 
         /**
@@ -72,76 +173,183 @@ namespace vexbridge::serial
         void resendMissingPackets()
         {
             // Lock the mutex to prevent concurrent access
-            sentPacketsMutex.take();
+            // Released by the guard if encoding throws
+            std::lock_guard<pros::Mutex> lock(sentPacketsMutex);
 
-            // Iterate through all sent packets
-            for (int i = 0; i < sentPackets.size(); i++)
-            {
-                // Get the iterator to the current packet
-                auto it = sentPackets.begin() + i;
-                if (it == sentPackets.end())
-                    break; // Break if the iterator is at the end of the list
+            // Send packets that waited for the slots freed by acknowledgements since the last call
+            sendWaitingPackets();
 
+            // Iterate through all sent packets
+            uint32_t now = pros::millis();
+            sentPackets.forEach([&](SentSerialPacket &sentPacket)
+                                {
                 // Check if the packet has timed out
-                if (pros::millis() - it->timestamp < TIMEOUT)
-                    continue;
-
-                // Get the sent packet
-                SentSerialPacket &sentPacket = *it;
+                // The timeout doubles with each retry so a busy host is not flooded
+                if (now - sentPacket.timestamp < rttEstimator.getTimeout(sentPacket.retries))
+                    return;
 
                 // Check if the packet has reached the max number of retries
                 if (sentPacket.retries >= MAX_RETRIES)
                 {
-                    // Remove the packet from the list
-                    sentPackets.erase(it);
+                    // Remove the packet from the window
+                    sentPackets.remove(sentPacket.seq);
 
                     // Log the failure
-                    // printf("Packet %d failed to send after %d retries.\n", sentPacket.packet->id, MAX_RETRIES);
-
-                    // Decrement the index to account for the removed packet and continue
-                    i--;
-                    continue;
+                    // printf("Packet %d failed to send after %d retries.\n", sentPacket.seq, MAX_RETRIES);
+                    return;
                 }
 
                 // Log the retry attempt
-                // printf("Resending packet %d (attempt %d)\n", sentPacket.packet->id, sentPacket.retries + 1);
+                // printf("Resending packet %d (attempt %d)\n", sentPacket.seq, sentPacket.retries + 1);
 
                 // Resend the packet
-                writePacketToSerial(sentPacket.packet);
+                writePacketToSerial(*sentPacket.packet, sentPacket.seq);
 
                 // Update retries/timestamp
                 sentPacket.retries++;
-                sentPacket.timestamp = pros::millis();
-            }
+                sentPacket.timestamp = now; });
+
+            // Send packets that waited for the slots of packets that were given up on
+            sendWaitingPackets();
+        }
+
+        /**
+         * Gets the time until `resendMissingPackets` has work to do.
+         * @return The time until the earliest unacknowledged packet times out in milliseconds,
+         *         or `UINT32_MAX` if every packet was acknowledged.
+         */
+        uint32_t getResendDelay()
+        {
+            // Lock the mutex to prevent concurrent access
+            sentPacketsMutex.take();
+
+            // Find the earliest timeout
+            uint32_t now = pros::millis();
+            uint32_t resendDelay = UINT32_MAX;
+            sentPackets.forEach([&](SentSerialPacket &sentPacket)
+                                {
+                uint32_t elapsed = now - sentPacket.timestamp;
+                uint32_t timeout = rttEstimator.getTimeout(sentPacket.retries);
+                resendDelay = std::min(resendDelay, elapsed < timeout ? timeout - elapsed : 0); });
 
             // Unlock the mutex after processing all packets
             sentPacketsMutex.give();
+            return resendDelay;
         }
 
         /**
          * Marks a packet as acknowledged.
          * This should be called when a packet is acknowledged by the VEXBridge.
-         * @param id The ID of the packet to acknowledge.
+         * @param seq The sequence number of the packet to acknowledge.
          */
-        void ackPacket(uint8_t id)
+        void ackPacket(uint16_t seq)
         {
             // Lock the mutex to prevent concurrent access
             sentPacketsMutex.take();
 
-            // Remove the packet from the sent packets list
-            for (auto it = sentPackets.begin(); it != sentPackets.end(); ++it)
-            {
-                if (it->packet->id == id)
-                {
-                    sentPackets.erase(it);
-                    break;
-                }
-            }
+            // Remove the packet from the send window
+            retirePacket(seq, pros::millis());
+
+            // Unlock the mutex after processing the packet
+            sentPacketsMutex.give();
+        }
+
+        /**
+         * Marks a range of packets as acknowledged.
+         * This should be called when a `SelectiveAckPacket` is received.
+         * @param cumulativeSeq Every packet up to and including this sequence number was received.
+         * @param receivedBitmap Bit `i` is set if packet `cumulativeSeq + 1 + i` was received.
+         */
+        void ackPackets(uint16_t cumulativeSeq, uint32_t receivedBitmap)
+        {
+            // Lock the mutex to prevent concurrent access
+            sentPacketsMutex.take();
+
+            // Remove every packet up to the cumulative sequence number
+            // Signed distance handles sequence numbers that wrap around
+            uint32_t now = pros::millis();
+            while (!sentPackets.empty() && (int16_t)(cumulativeSeq - sentPackets.getBaseSeq()) >= 0)
+                retirePacket(sentPackets.getBaseSeq(), now);
+
+            // Remove packets received after a gap
+            for (uint8_t i = 0; receivedBitmap != 0; i++, receivedBitmap >>= 1)
+                if (receivedBitmap & 1)
+                    retirePacket(cumulativeSeq + 1 + i, now);
 
             // Unlock the mutex after processing all packets
             sentPacketsMutex.give();
         }
 
+        /**
+         * Gets the current retransmit timeout.
+         * @return The timeout of a packet that was not resent yet in milliseconds.
+         */
+        uint32_t getTimeout() const
+        {
+            return rttEstimator.getTimeout();
+        }
+
+        /**
+         * Sends float and double array updates as 16-bit fixed point, and only the ranges that changed
+         * since the last acknowledged version. Trades precision for a much smaller payload.
+         * Applies to every serial packet writer.
+         * @param isEnabled True to quantize arrays.
+         */
+        static void setArrayQuantization(bool isEnabled)
+        {
+            isArrayQuantizationEnabled = isEnabled;
+        }
+
+        /**
+         * Checks if array updates are quantized.
+         * @return True if array updates are quantized.
+         */
+        static bool isArrayQuantized()
+        {
+            return isArrayQuantizationEnabled;
+        }
+
+        /**
+         * Sends the next update of each array as a keyframe rather than a delta.
+         * Called when the receiver resets or resyncs, since it may no longer have the versions acknowledged before.
+         */
+        void resetArrayBaselines()
+        {
+            std::lock_guard<pros::Mutex> lock(sentPacketsMutex);
+            arrayDeltaEncoder.reset();
+        }
+
+        /**
+         * Sets the checksum used for packets sent after this call.
+         * Packets waiting for acknowledgement use it when they are resent.
+         * @param checksumType The checksum agreed on with the receiver.
+         */
+        void setChecksumType(ChecksumType checksumType)
+        {
+            this->checksumType = checksumType;
+        }
+
+        /**
+         * Sets how frames are delimited.
+         * @param framingType The framing used by the receiver.
+         */
+        void setFramingType(FramingType framingType)
+        {
+            this->framingType = framingType;
+        }
+
+        /**
+         * Records every packet sent after this call.
+         * Each packet is recorded once when it is sent, whether or not the serial port has room for it,
+         * and resends are not recorded. Array updates are recorded whole, before they are quantized.
+         * @param recorder The recorder to append frames to, or nullptr to stop recording.
+         */
+        void setRecorder(std::shared_ptr<FrameRecorder> recorder)
+        {
+            std::lock_guard<pros::Mutex> lock(writeMutex);
+            this->recorder = recorder;
+        }
+
         /**
          * Sets the serial reader to use for reading packets.
          * @param serialReader The serial reader to use.
@@ -152,39 +360,191 @@ namespace vexbridge::serial
         }
 
     protected:
+        /**
+         * Moves waiting packets into the send window and writes them, oldest first, until the window is full.
+         * Must be called with `sentPacketsMutex` taken.
+         * @throws std::runtime_error if a packet fails to serialize. The packet is removed, since it would fail again.
+         */
+        void sendWaitingPackets()
+        {
+            while (!waitingPackets.empty() && !sentPackets.isFull())
+            {
+                std::shared_ptr<SerialPacket> serialPacket = std::move(waitingPackets.front());
+                waitingPackets.pop_front();
+
+                // Quantize float and double arrays
+                // Deltas are taken against the last acknowledged version, so only reliable packets are quantized
+                if (isArrayQuantizationEnabled)
+                    serialPacket = arrayDeltaEncoder.encode(serialPacket);
+
+                // Assign the next sequence number
+                // The packet is not modified, since the same packet may be sent by several writers
+                uint16_t seq = sentPackets.push(serialPacket, pros::millis());
+
+                // Write the packet to the serial port
+                try
+                {
+                    writePacketToSerial(*serialPacket, seq);
+                }
+                catch (std::exception &e)
+                {
+                    sentPackets.remove(seq);
+                    throw;
+                }
+            }
+        }
+
         /**
          * Writes a packet to the serial port.
+         * The payload is serialized once and shared with other sockets and resends, so only the frame is encoded here.
          * @param packet The packet to write.
-         * @throws std::runtime_error if the packet is nullptr.
+         * @param seq The sequence number to send the packet with.
+         * @throws std::runtime_error if the packet fails to serialize.
          */
-        void writePacketToSerial(std::shared_ptr<SerialPacket> packet)
+        void writePacketToSerial(const SerialPacket &packet, uint16_t seq)
         {
-            // Check if the packet is nullptr
-            if (!packet)
-                throw std::runtime_error("Cannot write a nullptr packet.");
+            // Serialized before taking the mutex, since another socket may be serializing the same packet
+            std::shared_ptr<const Buffer> body = SerialPacketEncoder::getBody(packet);
 
-            // Serialize the packet
-            Buffer writeBuffer = SerialPacketEncoder::encode(*packet);
-            if (writeBuffer.empty())
+            // Lock the mutex to prevent concurrent use of the frame buffer
+            // Released by the guard if encoding throws
+            std::lock_guard<pros::Mutex> lock(writeMutex);
+
+            // Frame the packet into the reused frame buffer
+            SerialPacketEncoder::encodeBody(*body, seq, checksumType, framingType, frameBuffer);
+            if (frameBuffer.empty())
                 throw std::runtime_error("Failed to serialize packet.");
 
             // Write to Serial
-            serialDriver->write(writeBuffer);
+            serialDriver->write(std::span<const uint8_t>(frameBuffer));
+        }
+
+        /**
+         * Writes a best-effort packet if the serial port has room for the whole frame.
+         * Best-effort packets use their own sequence numbers, since they never enter the send window.
+         * @param packet The packet to write.
+         * @return True if the packet was written, false if the serial port is full.
+         * @throws std::runtime_error if the packet fails to serialize.
+         */
+        bool tryWriteBestEffort(const SerialPacket &packet)
+        {
+            std::shared_ptr<const Buffer> body = SerialPacketEncoder::getBody(packet);
+            std::lock_guard<pros::Mutex> lock(writeMutex);
+
+            // Frame the packet into the reused frame buffer
+            SerialPacketEncoder::encodeBody(*body, bestEffortSeq, checksumType, framingType, frameBuffer);
+            if (frameBuffer.empty())
+                throw std::runtime_error("Failed to serialize packet.");
+
+            // Hold the packet back rather than writing part of a frame
+            if ((size_t)serialDriver->getWriteFree() < frameBuffer.size())
+                return false;
+
+            serialDriver->write(std::span<const uint8_t>(frameBuffer));
+            bestEffortSeq++;
+            return true;
+        }
+
+        /**
+         * Appends a packet to the recording, framed as it would be written but checked with `RecordingFormat::CHECKSUM_TYPE`.
+         * Recorded packets use their own sequence numbers, since they are recorded before they are assigned one.
+         * @param packet The packet to record.
+         * @throws std::runtime_error if the packet fails to serialize.
+         */
+        void recordPacket(const SerialPacket &packet)
+        {
+            // `setRecorder` may replace the recorder from another task
+            std::lock_guard<pros::Mutex> lock(writeMutex);
+            if (!recorder)
+                return;
+            std::shared_ptr<const Buffer> body = SerialPacketEncoder::getBody(packet);
+
+            // Frame the packet into the reused frame buffer
+            SerialPacketEncoder::encodeBody(*body, recordedSeq, RecordingFormat::CHECKSUM_TYPE, framingType, frameBuffer);
+            if (frameBuffer.empty())
+                throw std::runtime_error("Failed to serialize packet.");
+
+            recorder->record(std::span<const uint8_t>(frameBuffer));
+            recordedSeq++;
+        }
+
+        /**
+         * Removes an acknowledged packet from the send window.
+         * Packets that were never resent update the round-trip time, since the ACK of a resent packet is ambiguous.
+         * Must be called with `sentPacketsMutex` taken.
+         * @param seq The sequence number of the packet.
+         * @param now The current time in milliseconds.
+         */
+        void retirePacket(uint16_t seq, uint32_t now)
+        {
+            SentSerialPacket *sentPacket = sentPackets.get(seq);
+            if (!sentPacket)
+                return;
+
+            if (sentPacket->retries == 0)
+                rttEstimator.addSample(now - sentPacket->timestamp);
+            arrayDeltaEncoder.onAcknowledged(*sentPacket->packet);
+            sentPackets.remove(seq);
         }
 
     private:
         /// @brief Maximum number of retries for sending a packet
         static constexpr uint8_t MAX_RETRIES = 3;
 
-        /// @brief Maximum time to wait for a packet to be acknowledged (in milliseconds)
-        static constexpr uint32_t TIMEOUT = 10;
+        /// @brief Maximum number of packets waiting for acknowledgement
+        static constexpr size_t WINDOW_SIZE = 64;
+
+        /// @brief Packets that have been sent but not acknowledged, indexed by sequence number
+        SendWindow<WINDOW_SIZE> sentPackets;
+
+        /// @brief Reliable packets waiting for a free slot in `sentPackets`, oldest first. Guarded by `sentPacketsMutex`.
+        std::deque<std::shared_ptr<SerialPacket>> waitingPackets;
+
+        /// @brief Estimates the retransmit timeout from acknowledged packets
+        RttEstimator rttEstimator;
+
+        /// @brief Checksum agreed on with the receiver
+        ChecksumType checksumType = ChecksumType::SUM8;
+
+        /// @brief How frames are delimited
+        FramingType framingType = FramingType::BYTE_STUFFING;
 
-        /// @brief List of packets that have been sent but not acknowledged
-        std::vector<SentSerialPacket> sentPackets;
+        /// @brief Quantizes array updates against the versions acknowledged on this serial port
+        ArrayDeltaEncoder arrayDeltaEncoder;
 
-        /// @brief Mutex for synchronizing access to the sent packets list
+        /// @brief True if array updates are quantized
+        static inline bool isArrayQuantizationEnabled = false;
+
+        /// @brief Mutex for synchronizing access to the send window, waiting packets, and round-trip time
         pros::Mutex sentPacketsMutex;
 
+        /// @brief Frame being written. Keeps its capacity between packets, so encoding stops allocating once it has grown to the largest frame.
+        Buffer frameBuffer;
+
+        /// @brief Mutex for synchronizing access to the frame buffer. Taken after `sentPacketsMutex`.
+        pros::Mutex writeMutex;
+
+        /// @brief Sequence number of the next best-effort packet. Guarded by `writeMutex`.
+        uint16_t bestEffortSeq = 0;
+
+        /// @brief Recorder that every sent packet is appended to, or nullptr if not recording. Guarded by `writeMutex`.
+        std::shared_ptr<FrameRecorder> recorder;
+
+        /// @brief Sequence number of the next recorded packet. Guarded by `writeMutex`.
+        uint16_t recordedSeq = 0;
+
+        /// @brief Latest unwritten update of each best-effort value, indexed by value ID
+        std::vector<std::shared_ptr<SerialPacket>> latestPackets;
+
+        /// @brief IDs of the values in `latestPackets` that have an unwritten update, oldest first
+        std::vector<uint16_t> latestIDs;
+
+        /// @brief Number of best-effort updates replaced before they were written
+        std::atomic<uint32_t> supersededCount = 0;
+
+        /// @brief Mutex for synchronizing access to the best-effort updates. Taken before `writeMutex`.
+        pros::Mutex latestMutex;
+
         /// @brief Serial hardware driver to use for sending packets
         std::shared_ptr<SerialDriver> serialDriver;
 
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include "pros/rtos.hpp"
+#include "serialSocket.hpp"
+#include "serialization/allPacketTypes.hpp"
+#include "../utils/daemon.hpp"
+
+namespace vexbridge::serial
+{
+    /**
+     * Holds value updates and sends them to all active serial sockets at a fixed rate.
+     * Only the latest update of each value ID is kept between flushes.
+     * Updates of any type are packed into a single `BatchPacketV2`,
+     * so many values cost one frame, checksum, and ACK.
+     * Best-effort updates are packed into their own batch, which is sent once and never acknowledged.
+     */
+    class ValueCoalescer : private Daemon
+    {
+    public:
+        /**
+         * Creates a new value coalescer.
+         * @param flushInterval The time between flushes in milliseconds.
+         */
+        ValueCoalescer(uint32_t flushInterval)
+            : flushInterval(flushInterval)
+        {
+            start();
+        }
+
+        /**
+         * Queues a value update to be sent on the next flush.
+         * Replaces any update of the same value ID that has not been sent yet.
+         * @param valueID The ID of the value being updated.
+         * @param packet The update packet.
+         */
+        void queue(uint16_t valueID, std::shared_ptr<SerialPacket> packet)
+        {
+            mutex.take();
+
+            // Grow the slots to fit the ID
+            if (valueID >= pendingPackets.size())
+                pendingPackets.resize(valueID + 1);
+
+            // Mark the slot as dirty if it was clean
+            if (!pendingPackets[valueID])
+                dirtyIDs.push_back(valueID);
+
+            // Keep only the latest value
+            pendingPackets[valueID] = std::move(packet);
+
+            mutex.give();
+        }
+
+        /**
+         * Sends all queued updates to all active serial sockets.
+         */
+        void flush()
+        {
+            // Take the queued updates
+            // Packets are sent after the mutex is released so `queue` never waits on the serial port
+            mutex.take();
+            for (uint16_t valueID : dirtyIDs)
+                flushedPackets.push_back(std::move(pendingPackets[valueID]));
+            dirtyIDs.clear();
+            mutex.give();
+
+            // Pack every update into mixed batches
+            // Best-effort updates are batched separately, so reliable updates are never sent unacknowledged
+            for (auto &packet : flushedPackets)
+            {
+                if (!packet)
+                    continue;
+
+                // Non-value packets cannot be batched
+                // Quantized arrays are encoded per serial port, so they are sent on their own
+                bool isBestEffort = packet->flags & SerialPacketFlag::NO_ACK;
+                bool isQuantized = !isBestEffort && SerialPacketWriter::isArrayQuantized() && ArrayDeltaEncoder::canEncode(*packet);
+                PendingBatch &batch = isBestEffort ? bestEffortBatch : reliableBatch;
+                if (isQuantized || !batch.packet->addPacket(*packet))
+                {
+                    SerialSocket::writePacketToAll(std::move(packet));
+                    continue;
+                }
+                batch.count++;
+
+                // A batch carries a single timestamp, so its entries share the time of the earliest
+                bool isTimestamped = packet->flags & SerialPacketFlag::HAS_TIMESTAMP;
+                bool isBatchTimestamped = batch.packet->flags & SerialPacketFlag::HAS_TIMESTAMP;
+                if (isTimestamped && (!isBatchTimestamped || (int32_t)(packet->timestamp - batch.packet->timestamp) < 0))
+                {
+                    batch.packet->flags |= SerialPacketFlag::HAS_TIMESTAMP;
+                    batch.packet->timestamp = packet->timestamp;
+                }
+
+                // Kept until the batch is written in case it is sent on its own
+                batch.lastPacket = std::move(packet);
+
+                // Split the batch once it is large enough
+                if (batch.packet->entries.size() >= MAX_BATCH_BYTES)
+                    writeBatch(batch, isBestEffort);
+            }
+            writeBatch(reliableBatch, false);
+            writeBatch(bestEffortBatch, true);
+            flushedPackets.clear();
+        }
+
+        /**
+         * Sets the time between flushes.
+         * Safe to call from any task. Takes effect after the next flush.
+         * @param flushInterval The time between flushes in milliseconds.
+         */
+        void setFlushInterval(uint32_t flushInterval)
+        {
+            this->flushInterval.store(flushInterval, std::memory_order_relaxed);
+        }
+
+    protected:
+        void update() override
+        {
+            flush();
+            pros::delay(flushInterval.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * Batch of updates being packed during a flush.
+         */
+        struct PendingBatch
+        {
+            /// @brief Batch the updates are packed into
+            std::shared_ptr<BatchPacketV2> packet = makePacket<BatchPacketV2>();
+
+            /// @brief Number of updates in the batch
+            size_t count = 0;
+
+            /// @brief Last update added to the batch
+            std::shared_ptr<SerialPacket> lastPacket;
+        };
+
+        /**
+         * Writes a batch to all active serial sockets and starts a new one.
+         * A batch with a single update is sent as that update to avoid the batch overhead.
+         * @param batch The batch to write.
+         * @param isBestEffort True if the batch only holds best-effort updates.
+         */
+        void writeBatch(PendingBatch &batch, bool isBestEffort)
+        {
+            if (batch.count == 1 && batch.lastPacket)
+                SerialSocket::writePacketToAll(std::move(batch.lastPacket));
+            else if (batch.count > 1)
+            {
+                batch.packet->type = SerialPacketTypeID::BATCH_PACKET_V2;
+                if (isBestEffort)
+                    batch.packet->flags |= SerialPacketFlag::NO_ACK;
+                SerialSocket::writePacketToAll(std::move(batch.packet));
+            }
+
+            // Start a new batch unless the current one is still empty
+            if (batch.count > 0)
+                batch.packet = makePacket<BatchPacketV2>();
+            batch.count = 0;
+            batch.lastPacket.reset();
+        }
+
+    private:
+        /// @brief Size of the serialized entries at which a batch is split
+        static constexpr size_t MAX_BATCH_BYTES = 1024;
+
+        /// @brief Time between flushes in milliseconds
+        std::atomic<uint32_t> flushInterval;
+
+        /// @brief Latest unsent update of each value, indexed by value ID
+        std::vector<std::shared_ptr<SerialPacket>> pendingPackets;
+
+        /// @brief IDs of the values in `pendingPackets` that have an unsent update
+        std::vector<uint16_t> dirtyIDs;
+
+        /// @brief Updates taken from `pendingPackets` during a flush. Reused to avoid reallocating.
+        std::vector<std::shared_ptr<SerialPacket>> flushedPackets;
+
+        /// @brief Reliable updates being packed during a flush
+        PendingBatch reliableBatch;
+
+        /// @brief Best-effort updates being packed during a flush
+        PendingBatch bestEffortBatch;
+
+        /// @brief Mutex for synchronizing access to the pending updates
+        pros::Mutex mutex;
+    };
+}
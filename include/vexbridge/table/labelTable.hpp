@@ -3,6 +3,9 @@
 #include <unordered_map>
 #include <cstdint>
 #include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
 #include "pros/rtos.hpp"
 
 namespace vexbridge::table
@@ -20,10 +23,11 @@ namespace vexbridge::table
          */
         static int32_t get(const std::string &label)
         {
-            if (!contains(label))
-                return -1;
-
-            return labelToID.at(label);
+            mutex.take();
+            auto it = labelToID.find(label);
+            int32_t id = it == labelToID.end() ? -1 : it->second;
+            mutex.give();
+            return id;
         }
 
         /**
@@ -33,7 +37,7 @@ namespace vexbridge::table
          */
         static bool contains(const std::string &label)
         {
-            return labelToID.find(label) != labelToID.end();
+            return get(label) >= 0;
         }
 
         /**
@@ -44,13 +48,11 @@ namespace vexbridge::table
         static uint16_t create(const std::string &label)
         {
             // Avoid race conditions
-            mutex.take(0);
-
-            // Create a new ID
-            static uint16_t idCounter = ID_OFFSET;
-            uint16_t id = idCounter++;
+            // Waits for the mutex, since `labelToID` must never be modified by two tasks at once
+            mutex.take();
 
             // Assign the ID to the label
+            uint16_t id = nextID++;
             labelToID[label] = id;
 
             // Release mutex and return the ID
@@ -58,10 +60,75 @@ namespace vexbridge::table
             return id;
         }
 
+        /**
+         * Gets the ID of a label, assigning a new ID if it does not have one.
+         * Looks up and assigns in one step, so two tasks never assign different IDs to the same label.
+         * @param label The label to search for.
+         * @param isCreated Set to true if a new ID was assigned.
+         * @return The ID of the label.
+         */
+        static uint16_t getOrCreate(const std::string &label, bool &isCreated)
+        {
+            mutex.take();
+
+            // Assign an ID if the label is new
+            auto [it, isInserted] = labelToID.try_emplace(label, nextID);
+            if (isInserted)
+                nextID++;
+            uint16_t id = it->second;
+
+            mutex.give();
+            isCreated = isInserted;
+            return id;
+        }
+
+        /**
+         * Gets the label of an ID.
+         * Searches every label, so it should only be used when a label must be resent.
+         * @param id The ID to search for.
+         * @return The label or an empty string if the ID was never assigned.
+         */
+        static std::string getLabel(const uint16_t id)
+        {
+            mutex.take();
+            std::string label;
+            for (auto &[entryLabel, entryID] : labelToID)
+            {
+                if (entryID == id)
+                {
+                    label = entryLabel;
+                    break;
+                }
+            }
+            mutex.give();
+            return label;
+        }
+
+        /**
+         * Gets every label and its ID.
+         * Copies the labels, so the table is not locked while they are used.
+         * @return The ID and label of every label, ordered by ID.
+         */
+        static std::vector<std::pair<uint16_t, std::string>> getAll()
+        {
+            mutex.take();
+            std::vector<std::pair<uint16_t, std::string>> labels;
+            labels.reserve(labelToID.size());
+            for (auto &[label, id] : labelToID)
+                labels.emplace_back(id, label);
+            mutex.give();
+
+            std::sort(labels.begin(), labels.end());
+            return labels;
+        }
+
     private:
         // The offset to start assigning IDs at
         static constexpr uint16_t ID_OFFSET = 0;
 
+        /// @brief ID assigned to the next new label
+        static inline uint16_t nextID = ID_OFFSET;
+
         static pros::Mutex mutex;
         static std::unordered_map<std::string, uint16_t> labelToID;
     };
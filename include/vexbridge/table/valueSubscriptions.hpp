@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include "pros/rtos.hpp"
+
+namespace vexbridge::table
+{
+    /**
+     * Registry of callbacks to call when a value changes.
+     * Shared by `ValueTable` and `VisionFrameTable`, since both are keyed by label ID.
+     * Callbacks run on the task that changed the value, usually the serial daemon, right after the change.
+     * They should be short, such as notifying a task, and must not subscribe or unsubscribe.
+     */
+    class ValueSubscriptions
+    {
+    public:
+        /// @brief Function called when a value changes
+        typedef std::function<void()> Callback;
+
+        /**
+         * Calls a function each time a value changes.
+         * @param id The ID of the value.
+         * @param callback The function to call.
+         * @return A handle to pass to `unsubscribe`.
+         */
+        static uint32_t subscribe(const uint16_t id, Callback callback)
+        {
+            mutex.take();
+            uint32_t handle = nextHandle++;
+            subscriptions.push_back(Subscription{handle, id, std::move(callback)});
+            subscriptionCount.store(subscriptions.size(), std::memory_order_release);
+            mutex.give();
+            return handle;
+        }
+
+        /**
+         * Notifies a task each time a value changes.
+         * The task can wait with `pros::Task::notify_take`.
+         * @param id The ID of the value.
+         * @param task The task to notify.
+         * @return A handle to pass to `unsubscribe`.
+         */
+        static uint32_t notifyOnChange(const uint16_t id, pros::Task task)
+        {
+            pros::task_t handle = (pros::task_t)task;
+            return subscribe(id, [handle]()
+                             { pros::Task(handle).notify(); });
+        }
+
+        /**
+         * Stops calling a subscribed function.
+         * Does nothing if the handle was already unsubscribed.
+         * @param handle The handle returned by `subscribe`.
+         */
+        static void unsubscribe(const uint32_t handle)
+        {
+            mutex.take();
+            std::erase_if(subscriptions, [handle](const Subscription &subscription)
+                          { return subscription.handle == handle; });
+            subscriptionCount.store(subscriptions.size(), std::memory_order_release);
+            mutex.give();
+        }
+
+        /**
+         * Checks if any function is subscribed to any value.
+         * @return True if `notify` may call a function.
+         */
+        static bool hasSubscriptions()
+        {
+            return subscriptionCount.load(std::memory_order_relaxed) != 0;
+        }
+
+        /**
+         * Calls every function subscribed to a value.
+         * Returns without locking if nothing is subscribed, so unsubscribed values cost a single load.
+         * @param id The ID of the value that changed.
+         */
+        static void notify(const uint16_t id)
+        {
+            if (subscriptionCount.load(std::memory_order_acquire) == 0)
+                return;
+
+            mutex.take();
+            for (Subscription &subscription : subscriptions)
+                if (subscription.id == id)
+                    subscription.callback();
+            mutex.give();
+        }
+
+    private:
+        /**
+         * A function subscribed to a value.
+         */
+        struct Subscription
+        {
+            /// @brief Handle returned by `subscribe`
+            uint32_t handle;
+
+            /// @brief ID of the value
+            uint16_t id;
+
+            /// @brief Function to call when the value changes
+            Callback callback;
+        };
+
+        static inline std::vector<Subscription> subscriptions;
+        static inline std::atomic<size_t> subscriptionCount = 0;
+        static inline uint32_t nextHandle = 1;
+        static inline pros::Mutex mutex;
+    };
+}
@@ -1,24 +1,259 @@
 #pragma once
 
-#include <map>
 #include <cstdint>
-#include <any>
+#include <cstring>
+#include <string>
+#include <span>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
 #include <stdexcept>
+#include "pros/rtos.hpp"
+#include "valueSubscriptions.hpp"
+#include "../utils/buffer.h"
+#include "../utils/bufferReader.hpp"
+#include "../utils/bufferWriter.hpp"
+#include "../vbRecord.hpp"
 
 namespace vexbridge::table
 {
+    /**
+     * Type of a value stored in `ValueTable`.
+     */
+    enum class ValueType : uint8_t
+    {
+        NONE,
+        BOOL,
+        INT,
+        FLOAT,
+        DOUBLE,
+        STRING,
+        BOOL_ARRAY,
+        INT_ARRAY,
+        FLOAT_ARRAY,
+        DOUBLE_ARRAY,
+        RECORD,
+    };
+
+    /**
+     * Maps a C++ type to its `ValueType`.
+     * Only the types VEXBridge can send are specialized.
+     * Records are stored packed, so a `Buffer` holds the bytes of a record of any type.
+     */
+    template <typename T, typename = void>
+    struct ValueTypeOf;
+
+    template <>
+    struct ValueTypeOf<bool>
+    {
+        static constexpr ValueType TYPE = ValueType::BOOL;
+    };
+
+    template <>
+    struct ValueTypeOf<int>
+    {
+        static constexpr ValueType TYPE = ValueType::INT;
+    };
+
+    template <>
+    struct ValueTypeOf<float>
+    {
+        static constexpr ValueType TYPE = ValueType::FLOAT;
+    };
+
+    template <>
+    struct ValueTypeOf<double>
+    {
+        static constexpr ValueType TYPE = ValueType::DOUBLE;
+    };
+
+    template <>
+    struct ValueTypeOf<std::string>
+    {
+        static constexpr ValueType TYPE = ValueType::STRING;
+    };
+
+    template <>
+    struct ValueTypeOf<std::vector<bool>>
+    {
+        static constexpr ValueType TYPE = ValueType::BOOL_ARRAY;
+    };
+
+    template <>
+    struct ValueTypeOf<std::vector<int>>
+    {
+        static constexpr ValueType TYPE = ValueType::INT_ARRAY;
+    };
+
+    template <>
+    struct ValueTypeOf<std::vector<float>>
+    {
+        static constexpr ValueType TYPE = ValueType::FLOAT_ARRAY;
+    };
+
+    template <>
+    struct ValueTypeOf<std::vector<double>>
+    {
+        static constexpr ValueType TYPE = ValueType::DOUBLE_ARRAY;
+    };
+
+    template <>
+    struct ValueTypeOf<vexbridge::utils::Buffer>
+    {
+        static constexpr ValueType TYPE = ValueType::RECORD;
+    };
+
+    template <typename T>
+    struct ValueTypeOf<T, std::enable_if_t<IsRecord<T>::value>>
+    {
+        static constexpr ValueType TYPE = ValueType::RECORD;
+    };
+
+
+    /**
+     * A value read from `ValueTable` along with when and how often it changed.
+     * All fields come from the same update.
+     */
+    template <typename T>
+    struct ValueSnapshot
+    {
+        /// @brief The value, or the default value if it was never set
+        T value;
+
+        /// @brief Time the value was captured in microseconds since the program started, or 0 if it was never set
+        uint64_t captureTime = 0;
+
+        /// @brief Number of times the value changed. Differs between two snapshots if the value changed in between.
+        uint32_t updateCount = 0;
+
+        /**
+         * Gets the time since the value was captured.
+         * @return The age in microseconds, or the time since the program started if the value was never set.
+         */
+        uint64_t getAge() const
+        {
+            return pros::micros() - captureTime;
+        }
+    };
+
+    /**
+     * Table of the latest value of every ID.
+     * Values are stored in flat slots indexed by ID, so every access is a constant-time array lookup.
+     * Scalars are stored inline. Strings and arrays are stored as bytes in a per-slot block
+     * that keeps its capacity, so updating an array of the same length does not allocate.
+     * Records are stored packed, along with the schema of the record type that set them.
+     *
+     * Each slot is double-buffered. Writers take turns filling the copy readers are not directed to, then publish it,
+     * so reads never lock and never wait on a write in progress. A reader only retries if the copy it was reading
+     * was rewritten under it, which takes two writes completing first, so values are never torn.
+     * Writers of a slot take turns by claiming its write sequence, so writers of different slots never wait on each other.
+     */
     class ValueTable
     {
     public:
+        /**
+         * Sets a value within the table, captured now.
+         * The time is only read if capture times are enabled or a value has subscribers,
+         * since reading the clock costs more than the rest of a scalar write. Otherwise the capture time is 0.
+         * @param id The id of the value to set.
+         * @param value The value to set.
+         * @return True if the value or its type changed.
+         */
+        template <typename T>
+        static bool set(const uint16_t id, const T &value)
+        {
+            bool isTimed = isCaptureTimed.load(std::memory_order_relaxed) || ValueSubscriptions::hasSubscriptions();
+            return set(id, value, isTimed ? pros::micros() : 0);
+        }
+
         /**
          * Sets a value within the table.
+         * The capture time is updated even if the value did not change, since the value is still current at that time.
+         * Calls the subscriptions of the value if it changed.
          * @param id The id of the value to set.
          * @param value The value to set.
+         * @param captureTime The time the value was captured in microseconds since the program started,
+         * or 0 if it is not known, in which case an unchanged value keeps its capture time.
+         * @return True if the value or its type changed.
          */
         template <typename T>
-        static void set(const uint16_t id, const T value)
+        static bool set(const uint16_t id, const T &value, const uint64_t captureTime)
         {
-            idToPath[id] = value;
+            ValueSlot &slot = getOrCreateSlot(id);
+
+            // Compare before claiming the slot, so an unchanged value without a capture time publishes nothing
+            // and never waits on another writer
+            const ValueCopy *comparedCopy;
+            uint32_t comparedSequence;
+            bool isChanged = !holds(slot, value, comparedCopy, comparedSequence);
+            if (!isChanged && captureTime == 0)
+                return false;
+
+            uint32_t writeSequence = claimSlot(slot);
+
+            // Other writers of the slot wait for the claim, so the published copy can be read directly
+            // It is only compared again if another writer published it since the first comparison
+            uint8_t publishedIndex = slot.publishedIndex.load(std::memory_order_relaxed);
+            const ValueCopy &current = slot.copies[publishedIndex];
+            if (&current != comparedCopy || current.sequence.load(std::memory_order_relaxed) != comparedSequence)
+                isChanged = current.type != ValueTypeOf<T>::TYPE || !equals(current, value);
+
+            // Nothing to publish if neither the value nor its capture time changed
+            if (!isChanged && captureTime == 0)
+            {
+                releaseSlot(slot, writeSequence);
+                return false;
+            }
+
+            // Fill the other copy
+            ValueCopy &next = slot.copies[1 - publishedIndex];
+            uint32_t sequence = next.sequence.load(std::memory_order_relaxed);
+            next.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            next.captureTime = captureTime;
+            if (isChanged)
+            {
+                // Packed records keep the schema of the record type that set them, if any
+                next.schema = current.type == ValueTypeOf<T>::TYPE ? current.schema : nullptr;
+                store(next, value);
+                next.type = ValueTypeOf<T>::TYPE;
+                next.updateCount = current.updateCount + 1;
+            }
+            else if (next.updateCount != current.updateCount)
+            {
+                // The other copy holds an older update, so bring it up to date
+                // Later unchanged writes find both copies on the same update and only change the capture time
+                next.type = current.type;
+                next.schema = current.schema;
+                memcpy(next.scalar, current.scalar, sizeof(next.scalar));
+                std::span<const uint8_t> bytes = getBytes(current);
+                memcpy(reserveBytes(next, bytes.size()), bytes.data(), bytes.size());
+                next.size.store(bytes.size(), std::memory_order_relaxed);
+                next.updateCount = current.updateCount;
+            }
+
+            // Publish the copy
+            next.sequence.store(sequence + 2, std::memory_order_release);
+            slot.publishedIndex.store(1 - publishedIndex, std::memory_order_release);
+            slot.isSet.store(true, std::memory_order_release);
+            releaseSlot(slot, writeSequence);
+
+            // Subscriptions may read the value, so they are called after it is published
+            if (isChanged)
+                ValueSubscriptions::notify(id);
+            return isChanged;
+        }
+
+        /**
+         * Stamps values set without a capture time with the time they were set.
+         * Values received over the serial port always have a capture time.
+         * @param isEnabled True to read the time on every `set`.
+         */
+        static void setCaptureTimed(bool isEnabled)
+        {
+            isCaptureTimed.store(isEnabled, std::memory_order_relaxed);
         }
 
         /**
@@ -28,7 +263,7 @@ namespace vexbridge::table
          */
         static bool contains(const uint16_t id)
         {
-            return idToPath.find(id) != idToPath.end();
+            return getSlot(id) != nullptr;
         }
 
         /**
@@ -39,28 +274,510 @@ namespace vexbridge::table
         template <typename T>
         static bool isType(const uint16_t id)
         {
-            if (!contains(id))
-                return false;
+            return getType(id) == ValueTypeOf<T>::TYPE;
+        }
+
+        /**
+         * Gets the type of a value.
+         * @param id The id of the value.
+         * @return The type of the value or `ValueType::NONE` if it was never set.
+         */
+        static ValueType getType(const uint16_t id)
+        {
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
+                return ValueType::NONE;
+
+            ValueType type;
+            read(*slot, [&](const ValueCopy &copy)
+                 { type = copy.type; });
+            return type;
+        }
+
+        /**
+         * Gets the schema of a record value.
+         * @param id The id of the value.
+         * @return The schema of the record type that last set the value,
+         * or nullptr if the value is not a record or was received packed.
+         */
+        static const std::string *getSchema(const uint16_t id)
+        {
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
+                return nullptr;
+
+            const std::string *schema;
+            read(*slot, [&](const ValueCopy &copy)
+                 { schema = copy.schema; });
+            return schema;
+        }
+
+        /**
+         * Gets the time the latest value was captured.
+         * Values received with a sender timestamp are moved to this clock, others were captured when they were received.
+         * @param id The id of the value.
+         * @return The time in microseconds since the program started, or 0 if the value was never set.
+         */
+        static uint64_t getCaptureTime(const uint16_t id)
+        {
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
+                return 0;
 
-            return idToPath.at(id).type() == typeid(T);
+            uint64_t captureTime;
+            read(*slot, [&](const ValueCopy &copy)
+                 { captureTime = copy.captureTime; });
+            return captureTime;
         }
 
         /**
          * Gets the value within the table.
          * @param id The id of the value to get.
+         * @throws std::runtime_error if the value does not exist or is of a different type.
          */
         template <typename T>
         static T get(const uint16_t id)
         {
-            if (!contains(id))
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
                 throw std::runtime_error("Value not found");
-            return std::any_cast<T>(idToPath.at(id));
+            return getSnapshot<T>(*slot, id).value;
+        }
+
+        /**
+         * Gets the value within the table, or a default value if it does not exist.
+         * @param id The id of the value to get.
+         * @param defaultValue The value to return if the value does not exist.
+         * @throws std::runtime_error if the value is of a different type.
+         */
+        template <typename T>
+        static T get(const uint16_t id, const T &defaultValue)
+        {
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
+                return defaultValue;
+            return getSnapshot<T>(*slot, id).value;
+        }
+
+        /**
+         * Gets the value within the table along with its capture time and update count, or a default value if it does not exist.
+         * @param id The id of the value to get.
+         * @param defaultValue The value to return if the value does not exist.
+         * @throws std::runtime_error if the value is of a different type.
+         */
+        template <typename T>
+        static ValueSnapshot<T> getSnapshot(const uint16_t id, const T &defaultValue)
+        {
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
+                return ValueSnapshot<T>{defaultValue};
+            return getSnapshot<T>(*slot, id);
+        }
+
+        /**
+         * Gets the value within the table if it is of a type.
+         * The type is checked against the same copy the value is read from,
+         * so a value that changes type while being read is reported rather than thrown.
+         * @param id The id of the value to get.
+         * @param value Set to the value if it is of type `T`.
+         * @return True if the value exists and is of type `T`, false otherwise.
+         */
+        template <typename T>
+        static bool tryGet(const uint16_t id, T &value)
+        {
+            const ValueSlot *slot = getSlot(id);
+            if (slot == nullptr)
+                return false;
+
+            bool isLoaded;
+            read(*slot, [&](const ValueCopy &copy)
+                 { isLoaded = load(copy, value); });
+            return isLoaded;
         }
 
     private:
-        static std::map<uint16_t, std::any> idToPath;
+        /// @brief Number of slots allocated at a time
+        static constexpr size_t PAGE_SIZE = 256;
+
+        /// @brief Number of pages needed to cover every 16-bit ID
+        static constexpr size_t PAGE_COUNT = 65536 / PAGE_SIZE;
+
+        /// @brief Smallest byte block allocated for a string, array, or record
+        static constexpr size_t MIN_BLOCK_CAPACITY = 16;
+
+        /**
+         * Bytes of a string, array, or packed record value.
+         * Blocks are never freed, since a reader that was preempted may still be copying from an outgrown block.
+         * Each block at least doubles the last, so outgrown blocks never total more than the latest.
+         */
+        struct ByteBlock
+        {
+            /// @brief Number of bytes the block holds
+            const size_t capacity;
+
+            /// @brief Bytes of the block
+            uint8_t *const data;
+        };
+
+        /**
+         * One of the two copies of a value.
+         */
+        struct ValueCopy
+        {
+            /// @brief Odd while the copy is being written
+            std::atomic<uint32_t> sequence = 0;
+
+            /// @brief Type of the value or `ValueType::NONE` if it was never set
+            ValueType type = ValueType::NONE;
+
+            /// @brief Bytes of a scalar value
+            alignas(double) uint8_t scalar[sizeof(double)] = {};
+
+            /// @brief Bytes of a string, array, or packed record value. Keeps its capacity between updates.
+            std::atomic<ByteBlock *> block = nullptr;
+
+            /// @brief Number of bytes used in `block`
+            std::atomic<size_t> size = 0;
+
+            /// @brief Schema of the record type that set the value, from `RecordCodec::getSchema`
+            const std::string *schema = nullptr;
+
+            /// @brief Time the value was captured in microseconds since the program started
+            uint64_t captureTime = 0;
+
+            /// @brief Number of times the value changed
+            uint32_t updateCount = 0;
+        };
+
+        /**
+         * Storage of a single value.
+         */
+        struct ValueSlot
+        {
+            /// @brief Both copies of the value
+            ValueCopy copies[2];
+
+            /// @brief Index of the copy readers are directed to
+            std::atomic<uint8_t> publishedIndex = 0;
+
+            /// @brief True once a value was published
+            std::atomic<bool> isSet = false;
+
+            /// @brief Odd while a writer has claimed the slot
+            std::atomic<uint32_t> writeSequence = 0;
+        };
+
+        template <typename T>
+        struct IsVector : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct IsVector<std::vector<T>> : std::true_type
+        {
+        };
+
+        /**
+         * Gets the slot of an existing value.
+         * @param id The id of the value.
+         * @return The slot or nullptr if the value was never set.
+         */
+        static const ValueSlot *getSlot(const uint16_t id)
+        {
+            const ValueSlot *page = pages[id / PAGE_SIZE].load(std::memory_order_acquire);
+            if (page == nullptr || !page[id % PAGE_SIZE].isSet.load(std::memory_order_acquire))
+                return nullptr;
+            return &page[id % PAGE_SIZE];
+        }
+
+        /**
+         * Gets the slot of a value, allocating its page if needed.
+         * @param id The id of the value.
+         * @return The slot.
+         */
+        static ValueSlot &getOrCreateSlot(const uint16_t id)
+        {
+            std::atomic<ValueSlot *> &pageEntry = pages[id / PAGE_SIZE];
+            ValueSlot *page = pageEntry.load(std::memory_order_acquire);
+            if (page == nullptr)
+            {
+                // Another task may allocate the same page at the same time, in which case its page is used
+                ValueSlot *newPage = new ValueSlot[PAGE_SIZE];
+                if (pageEntry.compare_exchange_strong(page, newPage, std::memory_order_acq_rel))
+                    page = newPage;
+                else
+                    delete[] newPage;
+            }
+            return page[id % PAGE_SIZE];
+        }
+
+        /**
+         * Waits for any other writer of a slot to finish, then claims the slot.
+         * Two tasks rarely write the same value at once, so a waiting writer sleeps rather than spins,
+         * which lets a lower priority writer finish.
+         * @param slot The slot to write.
+         * @return The claimed write sequence, to pass to `releaseSlot`.
+         */
+        static uint32_t claimSlot(ValueSlot &slot)
+        {
+            uint32_t sequence = slot.writeSequence.load(std::memory_order_relaxed);
+            while (sequence % 2 != 0 ||
+                   !slot.writeSequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                if (sequence % 2 == 0)
+                    continue;
+                pros::delay(1);
+                sequence = slot.writeSequence.load(std::memory_order_relaxed);
+            }
+            return sequence + 1;
+        }
+
+        /**
+         * Lets the next writer of a slot claim it.
+         * @param slot The slot that was written.
+         * @param sequence The write sequence returned by `claimSlot`.
+         */
+        static void releaseSlot(ValueSlot &slot, const uint32_t sequence)
+        {
+            slot.writeSequence.store(sequence + 1, std::memory_order_release);
+        }
+
+        /**
+         * Reads the published copy of a slot, retrying if it is rewritten while being read.
+         * The reader may see a torn copy on a try that is retried, so it must not throw or follow pointers of the copy,
+         * other than through `getBytes`.
+         * @param slot The slot to read.
+         * @param reader Called with the copy to read from.
+         */
+        template <typename Reader>
+        static void read(const ValueSlot &slot, Reader &&reader)
+        {
+            while (true)
+            {
+                const ValueCopy &copy = slot.copies[slot.publishedIndex.load(std::memory_order_acquire)];
+                uint32_t sequence = copy.sequence.load(std::memory_order_acquire);
+
+                // The copy was republished and is being written, so the other copy is now published
+                if (sequence % 2 != 0)
+                    continue;
+
+                reader(copy);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (copy.sequence.load(std::memory_order_relaxed) == sequence)
+                    return;
+            }
+        }
+
+        /**
+         * Reads a value along with its capture time and update count.
+         * @param slot The slot to read.
+         * @param id The id of the value, used in the error message.
+         * @return The snapshot of the value.
+         * @throws std::runtime_error if the value is of a different type, or a record of a different schema.
+         */
+        template <typename T>
+        static ValueSnapshot<T> getSnapshot(const ValueSlot &slot, const uint16_t id)
+        {
+            ValueSnapshot<T> snapshot;
+            bool isLoaded;
+            read(slot, [&](const ValueCopy &copy)
+                 {
+                     isLoaded = load(copy, snapshot.value);
+                     snapshot.captureTime = copy.captureTime;
+                     snapshot.updateCount = copy.updateCount; });
+
+            // Only throw once the copy is known to be whole
+            if (!isLoaded)
+                throw std::runtime_error((ValueTypeOf<T>::TYPE == ValueType::RECORD ? "Record mismatch for value " : "Type mismatch for value ") + std::to_string(id));
+            return snapshot;
+        }
+
+        /**
+         * Gets the bytes of a string, array, or packed record value.
+         * Safe to call on a copy that is being written, in which case the bytes may be torn but stay in bounds.
+         * @param copy The copy to read.
+         * @return The bytes of the value.
+         */
+        static std::span<const uint8_t> getBytes(const ValueCopy &copy)
+        {
+            const ByteBlock *block = copy.block.load(std::memory_order_relaxed);
+            if (block == nullptr)
+                return {};
+            return std::span<const uint8_t>(block->data, std::min(copy.size.load(std::memory_order_relaxed), block->capacity));
+        }
+
+        /**
+         * Gets room for the bytes of a value, growing the block of a copy if needed.
+         * Only called by the writer of the copy.
+         * @param copy The copy to write to.
+         * @param size The number of bytes needed.
+         * @return The start of the block.
+         */
+        static uint8_t *reserveBytes(ValueCopy &copy, const size_t size)
+        {
+            ByteBlock *block = copy.block.load(std::memory_order_relaxed);
+            if (block != nullptr && block->capacity >= size)
+                return block->data;
+
+            // The old block is kept for readers that may still be copying from it
+            size_t capacity = std::max({size, MIN_BLOCK_CAPACITY, block == nullptr ? 0 : block->capacity * 2});
+            block = new ByteBlock{capacity, new uint8_t[capacity]};
+            copy.block.store(block, std::memory_order_relaxed);
+            return block->data;
+        }
+
+        /**
+         * Copies a value into a copy.
+         * @param copy The copy to write to.
+         * @param value The value to write.
+         */
+        template <typename T>
+        static void store(ValueCopy &copy, const T &value)
+        {
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                memcpy(copy.scalar, &value, sizeof(T));
+            }
+            else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<bool>> ||
+                               std::is_same_v<T, vexbridge::utils::Buffer>)
+            {
+                std::copy(value.begin(), value.end(), reserveBytes(copy, value.size()));
+                copy.size.store(value.size(), std::memory_order_relaxed);
+            }
+            else if constexpr (IsRecord<T>::value)
+            {
+                size_t length = 0;
+                uint8_t *bytes = reserveBytes(copy, RecordCodec<T>::getSize());
+                vexbridge::utils::BufferWriter writer(std::span<uint8_t>(bytes, RecordCodec<T>::getSize()), length);
+                RecordCodec<T>::write(writer, value);
+                copy.size.store(length, std::memory_order_relaxed);
+                copy.schema = &RecordCodec<T>::getSchema();
+            }
+            else
+            {
+                static_assert(IsVector<T>::value, "Unsupported value type");
+                size_t size = value.size() * sizeof(typename T::value_type);
+                uint8_t *bytes = reserveBytes(copy, size);
+                if (!value.empty())
+                    memcpy(bytes, value.data(), size);
+                copy.size.store(size, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Copies a value out of a copy.
+         * Does not throw, since the copy may be torn until it is known to be whole.
+         * @param copy The copy to read from.
+         * @param value Set to the value.
+         * @return False if the value is of a different type, or a record of a different schema.
+         */
+        template <typename T>
+        static bool load(const ValueCopy &copy, T &value)
+        {
+            if (copy.type != ValueTypeOf<T>::TYPE)
+                return false;
+
+            std::span<const uint8_t> bytes = getBytes(copy);
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                memcpy(&value, copy.scalar, sizeof(T));
+            }
+            else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<bool>> ||
+                               std::is_same_v<T, vexbridge::utils::Buffer>)
+            {
+                value.assign(bytes.begin(), bytes.end());
+            }
+            else if constexpr (IsRecord<T>::value)
+            {
+                // Records received packed have no schema, so only their size can be checked
+                bool isSameSchema = copy.schema == nullptr || copy.schema == &RecordCodec<T>::getSchema();
+                if (!isSameSchema || bytes.size() != RecordCodec<T>::getSize())
+                    return false;
+
+                vexbridge::utils::BufferReader reader(bytes);
+                RecordCodec<T>::read(reader, value);
+            }
+            else
+            {
+                value.resize(bytes.size() / sizeof(typename T::value_type));
+                if (!value.empty())
+                    memcpy(value.data(), bytes.data(), value.size() * sizeof(typename T::value_type));
+            }
+            return true;
+        }
+
+        /**
+         * Checks if the published copy of a slot holds a value, without claiming the slot.
+         * @param slot The slot to read.
+         * @param value The value to compare.
+         * @param comparedCopy Set to the copy that was compared.
+         * @param comparedSequence Set to the sequence of the copy when it was compared.
+         * @return True if the slot holds a value of the same type that is equal.
+         */
+        template <typename T>
+        static bool holds(const ValueSlot &slot, const T &value, const ValueCopy *&comparedCopy, uint32_t &comparedSequence)
+        {
+            bool isEqual;
+            read(slot, [&](const ValueCopy &copy)
+                 {
+                     comparedCopy = &copy;
+                     comparedSequence = copy.sequence.load(std::memory_order_relaxed);
+                     isEqual = copy.type == ValueTypeOf<T>::TYPE && equals(copy, value); });
+            return isEqual;
+        }
+
+        /**
+         * Compares a copy to a value of the same type without copying it.
+         * Elements are compared with `==`, so NaNs are never equal.
+         * @param copy The copy to compare.
+         * @param value The value to compare.
+         * @return True if the copy holds the value.
+         */
+        template <typename T>
+        static bool equals(const ValueCopy &copy, const T &value)
+        {
+            std::span<const uint8_t> bytes = getBytes(copy);
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                T storedValue;
+                memcpy(&storedValue, copy.scalar, sizeof(T));
+                return storedValue == value;
+            }
+            else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<bool>> ||
+                               std::is_same_v<T, vexbridge::utils::Buffer>)
+            {
+                return std::equal(value.begin(), value.end(), bytes.begin(), bytes.end(),
+                                  [](auto element, uint8_t byte)
+                                  { return (uint8_t)element == byte; });
+            }
+            else if constexpr (IsRecord<T>::value)
+            {
+                // A record of another type may pack to the same bytes, but must still announce its schema
+                if (copy.schema != &RecordCodec<T>::getSchema() || bytes.size() != RecordCodec<T>::getSize())
+                    return false;
+                vexbridge::utils::BufferReader reader(bytes);
+                return RecordCodec<T>::equals(reader, value);
+            }
+            else
+            {
+                using Element = typename T::value_type;
+                if (bytes.size() != value.size() * sizeof(Element))
+                    return false;
+                for (size_t i = 0; i < value.size(); i++)
+                {
+                    Element storedElement;
+                    memcpy(&storedElement, bytes.data() + i * sizeof(Element), sizeof(Element));
+                    if (storedElement != value[i])
+                        return false;
+                }
+                return true;
+            }
+        }
+
+        /// @brief Pages of slots indexed by `id / PAGE_SIZE`, allocated on first use
+        static inline std::atomic<ValueSlot *> pages[PAGE_COUNT] = {};
+
+        /// @brief True if values set without a capture time are stamped with the time they were set
+        static inline std::atomic<bool> isCaptureTimed = false;
     };
 }
-
-// Initialize the static member variable
-std::map<uint16_t, std::any> vexbridge::table::ValueTable::idToPath = std::map<uint16_t, std::any>();
\ No newline at end of file
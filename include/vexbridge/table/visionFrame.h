@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace vexbridge::table
+{
+    /**
+     * A target detected in a vision frame.
+     */
+    struct VisionTarget
+    {
+        /// @brief Horizontal center of the target, from -1 (left) to 1 (right) of the frame
+        float x = 0;
+
+        /// @brief Vertical center of the target, from -1 (top) to 1 (bottom) of the frame
+        float y = 0;
+
+        /// @brief Width of the target as a fraction of the frame width, from 0 to 1
+        float width = 0;
+
+        /// @brief Height of the target as a fraction of the frame height, from 0 to 1
+        float height = 0;
+
+        /// @brief Confidence of the detection, from 0 to 1
+        float confidence = 0;
+
+        /// @brief Class of the target, defined by the vision pipeline
+        uint8_t classID = 0;
+    };
+
+    /**
+     * Every target detected in a single camera frame.
+     */
+    struct VisionFrame
+    {
+        /// @brief Number of the frame, counted by the sender
+        uint32_t frameNumber = 0;
+
+        /// @brief Time the frame was captured on the sender's clock in milliseconds
+        uint32_t sourceCaptureTime = 0;
+
+        /// @brief Time the frame was captured on the receiver's clock in milliseconds, or 0 if no frame was received
+        uint32_t captureTime = 0;
+
+        /// @brief Targets in the frame
+        std::vector<VisionTarget> targets;
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include "pros/rtos.hpp"
+#include "visionFrame.h"
+#include "valueSubscriptions.hpp"
+
+namespace vexbridge::table
+{
+    /**
+     * Table to store the latest vision frame of each ID.
+     * Frames are set and copied whole under a mutex, so a reader never sees targets from two frames.
+     */
+    class VisionFrameTable
+    {
+    public:
+        /**
+         * Replaces the frame of an ID.
+         * Calls the subscriptions of the ID once the frame is stored.
+         * @param id The ID of the frame.
+         * @param frame The new frame.
+         */
+        static void set(const uint16_t id, const VisionFrame &frame)
+        {
+            mutex.take();
+            VisionFrame &storedFrame = frames[id];
+            storedFrame.frameNumber = frame.frameNumber;
+            storedFrame.sourceCaptureTime = frame.sourceCaptureTime;
+            storedFrame.captureTime = frame.captureTime;
+            storedFrame.targets.assign(frame.targets.begin(), frame.targets.end());
+            mutex.give();
+
+            ValueSubscriptions::notify(id);
+        }
+
+        /**
+         * Copies the frame of an ID.
+         * Reuses the capacity of `frame`, so polling the same frame object does not allocate.
+         * @param id The ID of the frame.
+         * @param frame Set to the frame of the ID.
+         * @return True if a frame was received for the ID, false otherwise.
+         */
+        static bool get(const uint16_t id, VisionFrame &frame)
+        {
+            mutex.take();
+            auto it = frames.find(id);
+            bool isFound = it != frames.end();
+            if (isFound)
+            {
+                frame.frameNumber = it->second.frameNumber;
+                frame.sourceCaptureTime = it->second.sourceCaptureTime;
+                frame.captureTime = it->second.captureTime;
+                frame.targets.assign(it->second.targets.begin(), it->second.targets.end());
+            }
+            mutex.give();
+            return isFound;
+        }
+
+    private:
+        static inline std::unordered_map<uint16_t, VisionFrame> frames;
+        static inline pros::Mutex mutex;
+    };
+}
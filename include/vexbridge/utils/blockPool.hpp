@@ -0,0 +1,340 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <new>
+
+namespace vexbridge::utils
+{
+    /**
+     * Usage counters of a single size class in `BlockPool`.
+     */
+    struct BlockPoolStats
+    {
+        /// @brief Size of each block in bytes
+        size_t blockSize = 0;
+
+        /// @brief Number of blocks currently allocated
+        uint32_t inUse = 0;
+
+        /// @brief Most blocks ever allocated at once
+        uint32_t highWater = 0;
+
+        /// @brief Number of blocks taken from the heap so far, in use or free
+        uint32_t capacity = 0;
+
+        /// @brief Number of allocations that went to the general-purpose heap because the class was full
+        uint32_t heapFallbacks = 0;
+    };
+
+    /**
+     * Fixed-block allocator for packets and their payloads.
+     * Allocations are rounded up to one of a few size classes, each with its own lock-free free list.
+     * Blocks are taken from the heap in chunks and never returned, so once the pool has grown to
+     * the program's working set it no longer calls `malloc` or waits on newlib's malloc lock.
+     * Allocations larger than the largest class go straight to the heap.
+     */
+    class BlockPool
+    {
+    public:
+        // Prevent instantiation
+        BlockPool() = delete;
+
+        /// @brief Number of size classes
+        static constexpr size_t SIZE_CLASS_COUNT = 6;
+
+        /// @brief Block size of each size class in bytes
+        static constexpr size_t SIZE_CLASSES[SIZE_CLASS_COUNT] = {32, 64, 128, 256, 512, 2048};
+
+        /**
+         * Allocates a block of at least `size` bytes.
+         * @param size The number of bytes to allocate.
+         * @return The allocated block. Aligned to `alignof(std::max_align_t)`.
+         * @throws std::bad_alloc if the heap is out of memory.
+         */
+        static void *allocate(size_t size)
+        {
+            // Large allocations go straight to the heap
+            size_t classIndex = getSizeClass(size);
+            if (classIndex == SIZE_CLASS_COUNT)
+                return ::operator new(size);
+
+            // Pop a free block, taking a new chunk from the heap if there are none
+            SizeClass &sizeClass = sizeClasses[classIndex];
+            void *block = sizeClass.pop();
+            while (block == nullptr)
+            {
+                if (!sizeClass.grow())
+                {
+                    sizeClass.heapFallbacks.fetch_add(1, std::memory_order_relaxed);
+                    return ::operator new(size);
+                }
+                block = sizeClass.pop();
+            }
+
+            // Update the counters
+            uint32_t inUse = sizeClass.inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint32_t highWater = sizeClass.highWater.load(std::memory_order_relaxed);
+            while (inUse > highWater &&
+                   !sizeClass.highWater.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed))
+                ;
+            return block;
+        }
+
+        /**
+         * Frees a block allocated by `allocate`.
+         * @param block The block to free. May be nullptr.
+         * @param size The size passed to `allocate`.
+         */
+        static void deallocate(void *block, size_t size)
+        {
+            if (block == nullptr)
+                return;
+
+            // Blocks outside the pool came from the heap
+            size_t classIndex = getSizeClass(size);
+            if (classIndex == SIZE_CLASS_COUNT || !sizeClasses[classIndex].push(block))
+            {
+                ::operator delete(block);
+                return;
+            }
+            sizeClasses[classIndex].inUse.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets the usage counters of a size class.
+         * @param classIndex The index of the size class in `SIZE_CLASSES`.
+         * @return The usage counters.
+         */
+        static BlockPoolStats getStats(size_t classIndex)
+        {
+            const SizeClass &sizeClass = sizeClasses[classIndex];
+            BlockPoolStats stats;
+            stats.blockSize = SIZE_CLASSES[classIndex];
+            stats.inUse = sizeClass.inUse.load(std::memory_order_relaxed);
+            stats.highWater = sizeClass.highWater.load(std::memory_order_relaxed);
+            stats.capacity = sizeClass.chunkCount.load(std::memory_order_relaxed) * sizeClass.blocksPerChunk;
+            stats.heapFallbacks = sizeClass.heapFallbacks.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        /// @brief Number of bytes taken from the heap at a time
+        static constexpr size_t CHUNK_SIZE = 4096;
+
+        /// @brief Maximum number of chunks per size class
+        static constexpr size_t MAX_CHUNKS = 32;
+
+        /// @brief Block index marking the end of a free list
+        static constexpr uint16_t EMPTY = 0xFFFF;
+
+        /**
+         * Gets the smallest size class that fits an allocation.
+         * @param size The number of bytes to allocate.
+         * @return The index of the size class or `SIZE_CLASS_COUNT` if none fits.
+         */
+        static constexpr size_t getSizeClass(size_t size)
+        {
+            for (size_t i = 0; i < SIZE_CLASS_COUNT; i++)
+                if (size <= SIZE_CLASSES[i])
+                    return i;
+            return SIZE_CLASS_COUNT;
+        }
+
+        /**
+         * Free list and chunks of a single block size.
+         * The free list is a Treiber stack of block indices. The head holds a 16-bit index and a 16-bit tag
+         * that changes on every pop, so a pop that raced with a pop and push of the same block fails its CAS.
+         * Each free block stores the index of the next free block in its first two bytes.
+         */
+        struct SizeClass
+        {
+            /**
+             * Creates an empty size class.
+             * @param blockSize The size of each block in bytes.
+             */
+            constexpr SizeClass(size_t blockSize)
+                : blockSize(blockSize),
+                  blocksPerChunk(CHUNK_SIZE / blockSize)
+            {
+            }
+
+            /**
+             * Pops a free block.
+             * @return The block or nullptr if the free list is empty.
+             */
+            void *pop()
+            {
+                uint32_t head = freeHead.load(std::memory_order_acquire);
+                while (true)
+                {
+                    uint16_t index = head & 0xFFFF;
+                    if (index == EMPTY)
+                        return nullptr;
+
+                    // The block may be popped and written by another task while it is read here,
+                    // in which case the tag has changed and the CAS fails
+                    uint8_t *block = getBlock(index);
+                    uint16_t next = std::atomic_ref<uint16_t>(*(uint16_t *)block).load(std::memory_order_relaxed);
+                    uint32_t newHead = ((head + 0x10000) & 0xFFFF0000) | next;
+                    if (freeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire))
+                        return block;
+                }
+            }
+
+            /**
+             * Pushes a block onto the free list.
+             * @param block The block to free.
+             * @return False if the block is not in this size class.
+             */
+            bool push(void *block)
+            {
+                uint16_t index = getIndex((uint8_t *)block);
+                if (index == EMPTY)
+                    return false;
+                pushIndex(index);
+                return true;
+            }
+
+            /**
+             * Takes a new chunk of blocks from the heap and frees all of them.
+             * Several tasks may grow at once, each adds its own chunk.
+             * @return False if the size class already has `MAX_CHUNKS` chunks.
+             */
+            bool grow()
+            {
+                if (chunkCount.load(std::memory_order_relaxed) >= MAX_CHUNKS)
+                    return false;
+                uint8_t *chunk = (uint8_t *)::operator new(CHUNK_SIZE);
+
+                // Claim the first empty chunk slot
+                for (size_t chunkIndex = 0; chunkIndex < MAX_CHUNKS; chunkIndex++)
+                {
+                    uint8_t *expected = nullptr;
+                    if (!chunks[chunkIndex].compare_exchange_strong(expected, chunk, std::memory_order_release))
+                        continue;
+                    chunkCount.fetch_add(1, std::memory_order_relaxed);
+
+                    // Free every block of the chunk
+                    for (size_t i = 0; i < blocksPerChunk; i++)
+                        pushIndex(chunkIndex * blocksPerChunk + i);
+                    return true;
+                }
+
+                ::operator delete(chunk);
+                return false;
+            }
+
+            /**
+             * Gets a block by its index.
+             * @param index The index of the block.
+             * @return The block.
+             */
+            uint8_t *getBlock(uint16_t index) const
+            {
+                uint8_t *chunk = chunks[index / blocksPerChunk].load(std::memory_order_acquire);
+                return chunk + (index % blocksPerChunk) * blockSize;
+            }
+
+            /**
+             * Gets the index of a block.
+             * @param block The block.
+             * @return The index of the block or `EMPTY` if it is not in this size class.
+             */
+            uint16_t getIndex(uint8_t *block) const
+            {
+                for (size_t chunkIndex = 0; chunkIndex < MAX_CHUNKS; chunkIndex++)
+                {
+                    uint8_t *chunk = chunks[chunkIndex].load(std::memory_order_acquire);
+                    if (chunk == nullptr)
+                        break;
+                    if (block >= chunk && block < chunk + CHUNK_SIZE)
+                        return chunkIndex * blocksPerChunk + (block - chunk) / blockSize;
+                }
+                return EMPTY;
+            }
+
+            /**
+             * Pushes a block onto the free list by its index.
+             * @param index The index of the block.
+             */
+            void pushIndex(uint16_t index)
+            {
+                uint8_t *block = getBlock(index);
+                uint32_t head = freeHead.load(std::memory_order_relaxed);
+                do
+                {
+                    std::atomic_ref<uint16_t>(*(uint16_t *)block).store(head & 0xFFFF, std::memory_order_relaxed);
+                } while (!freeHead.compare_exchange_weak(head, (head & 0xFFFF0000) | index, std::memory_order_release));
+            }
+
+            /// @brief Size of each block in bytes
+            const size_t blockSize;
+
+            /// @brief Number of blocks in each chunk
+            const size_t blocksPerChunk;
+
+            /// @brief Tag in the upper 16 bits and index of the first free block in the lower 16 bits
+            std::atomic<uint32_t> freeHead = EMPTY;
+
+            /// @brief Chunks taken from the heap, filled in order
+            std::atomic<uint8_t *> chunks[MAX_CHUNKS] = {};
+
+            /// @brief Number of chunks taken from the heap
+            std::atomic<uint32_t> chunkCount = 0;
+
+            /// @brief Number of blocks currently allocated
+            std::atomic<uint32_t> inUse = 0;
+
+            /// @brief Most blocks ever allocated at once
+            std::atomic<uint32_t> highWater = 0;
+
+            /// @brief Number of allocations that went to the heap because the class was full
+            std::atomic<uint32_t> heapFallbacks = 0;
+        };
+
+        /// @brief Free lists of each size class
+        static inline SizeClass sizeClasses[SIZE_CLASS_COUNT] = {
+            SizeClass(SIZE_CLASSES[0]),
+            SizeClass(SIZE_CLASSES[1]),
+            SizeClass(SIZE_CLASSES[2]),
+            SizeClass(SIZE_CLASSES[3]),
+            SizeClass(SIZE_CLASSES[4]),
+            SizeClass(SIZE_CLASSES[5])};
+    };
+
+    /**
+     * Standard allocator that allocates from `BlockPool`.
+     * Used with `std::allocate_shared` and standard containers.
+     * @tparam T The type to allocate.
+     */
+    template <typename T>
+    struct PoolAllocator
+    {
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &)
+        {
+        }
+
+        T *allocate(size_t count)
+        {
+            return (T *)BlockPool::allocate(count * sizeof(T));
+        }
+
+        void deallocate(T *pointer, size_t count)
+        {
+            BlockPool::deallocate(pointer, count * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U> &) const
+        {
+            return true;
+        }
+    };
+}
@@ -3,8 +3,10 @@
 #include <vector>
 #include <memory>
 #include <cstdint>
+#include "blockPool.hpp"
 
 namespace vexbridge::utils
 {
-    typedef std::vector<uint8_t> Buffer;
+    /// @brief Byte array allocated from the block pool, so payloads do not touch the heap
+    typedef std::vector<uint8_t, PoolAllocator<uint8_t>> Buffer;
 }
\ No newline at end of file
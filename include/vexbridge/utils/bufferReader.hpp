@@ -2,6 +2,11 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <string>
+#include <span>
+#include <bit>
+#include <algorithm>
 #include "buffer.h"
 
 namespace vexbridge::utils
@@ -9,6 +14,7 @@ namespace vexbridge::utils
     /**
      * Reads data sequentially from a buffer.
      * Checks for buffer overflow.
+     * Reads from any contiguous bytes, so a frame can be read in place without copying it into a `Buffer`.
      */
     class BufferReader
     {
@@ -18,7 +24,16 @@ namespace vexbridge::utils
          * @param buffer The buffer to read from.
          */
         BufferReader(const Buffer &buffer)
-            : buffer(buffer)
+            : buffer(buffer.data(), buffer.size())
+        {
+        }
+
+        /**
+         * Creates a new buffer reader.
+         * @param bytes The bytes to read from. Must outlive the reader.
+         */
+        BufferReader(std::span<const uint8_t> bytes)
+            : buffer(bytes)
         {
         }
 
@@ -28,7 +43,7 @@ namespace vexbridge::utils
          */
         void setOffset(const size_t offset)
         {
-            this->offset = offset;
+            this->offset = std::min(offset, buffer.size());
         }
 
         /**
@@ -66,16 +81,25 @@ namespace vexbridge::utils
          * @return The new buffer containing the copied bytes.
          */
         Buffer readBytes(uint16_t length)
+        {
+            std::span<const uint8_t> bytes = readSpan(length);
+            return Buffer(bytes.begin(), bytes.end());
+        }
+
+        /**
+         * Gets a view of the next n bytes without copying them.
+         * @param length The number of bytes to read.
+         * @return The bytes read. Shorter than `length` if the buffer runs out.
+         */
+        std::span<const uint8_t> readSpan(size_t length)
         {
             // Check for buffer overflow
             if (length > buffer.size() - offset)
                 length = buffer.size() - offset;
 
-            // Copy the bytes
-            Buffer newBuffer;
-            for (uint16_t i = 0; i < length; i++)
-                newBuffer.push_back(readUInt8());
-            return newBuffer;
+            std::span<const uint8_t> bytes = buffer.subspan(offset, length);
+            offset += length;
+            return bytes;
         }
 
         /**
@@ -84,9 +108,7 @@ namespace vexbridge::utils
          */
         uint16_t readUInt16LE()
         {
-            uint16_t value = readUInt8();
-            value |= (uint16_t)readUInt8() << 8;
-            return value;
+            return readLE<uint16_t>();
         }
 
         /**
@@ -95,9 +117,16 @@ namespace vexbridge::utils
          */
         uint16_t readUInt16BE()
         {
-            uint16_t value = (uint16_t)readUInt8() << 8;
-            value |= readUInt8();
-            return value;
+            return readBE<uint16_t>();
+        }
+
+        /**
+         * Reads an unsigned 32-bit integer from the buffer in big-endian format.
+         * @return The integer read from the buffer.
+         */
+        uint32_t readUInt32BE()
+        {
+            return readBE<uint32_t>();
         }
 
         /**
@@ -106,15 +135,7 @@ namespace vexbridge::utils
          */
         double readDoubleBE()
         {
-            uint64_t value = (uint64_t)readUInt8() << 56;
-            value |= (uint64_t)readUInt8() << 48;
-            value |= (uint64_t)readUInt8() << 40;
-            value |= (uint64_t)readUInt8() << 32;
-            value |= (uint64_t)readUInt8() << 24;
-            value |= (uint64_t)readUInt8() << 16;
-            value |= (uint64_t)readUInt8() << 8;
-            value |= (uint64_t)readUInt8();
-            return *(double *)&value;
+            return std::bit_cast<double>(readBE<uint64_t>());
         }
 
         /**
@@ -123,15 +144,7 @@ namespace vexbridge::utils
          */
         double readDoubleLE()
         {
-            uint64_t value = (uint64_t)readUInt8();
-            value |= (uint64_t)readUInt8() << 8;
-            value |= (uint64_t)readUInt8() << 16;
-            value |= (uint64_t)readUInt8() << 24;
-            value |= (uint64_t)readUInt8() << 32;
-            value |= (uint64_t)readUInt8() << 40;
-            value |= (uint64_t)readUInt8() << 48;
-            value |= (uint64_t)readUInt8() << 56;
-            return *(double *)&value;
+            return std::bit_cast<double>(readLE<uint64_t>());
         }
 
         /**
@@ -140,11 +153,7 @@ namespace vexbridge::utils
          */
         float readFloatBE()
         {
-            uint32_t value = (uint32_t)readUInt8() << 24;
-            value |= (uint32_t)readUInt8() << 16;
-            value |= (uint32_t)readUInt8() << 8;
-            value |= (uint32_t)readUInt8();
-            return *(float *)&value;
+            return std::bit_cast<float>(readBE<uint32_t>());
         }
 
         /**
@@ -153,11 +162,7 @@ namespace vexbridge::utils
          */
         float readFloatLE()
         {
-            uint32_t value = (uint32_t)readUInt8();
-            value |= (uint32_t)readUInt8() << 8;
-            value |= (uint32_t)readUInt8() << 16;
-            value |= (uint32_t)readUInt8() << 24;
-            return *(float *)&value;
+            return std::bit_cast<float>(readLE<uint32_t>());
         }
 
         /**
@@ -167,15 +172,8 @@ namespace vexbridge::utils
          */
         std::string readString16()
         {
-            uint16_t stringLength = readUInt16BE();
-            if (stringLength > buffer.size() - offset)
-                stringLength = buffer.size() - offset;
-
-            std::string str = "";
-            for (uint16_t i = 0; i < stringLength; i++)
-                str += (char)readUInt8();
-
-            return str;
+            std::span<const uint8_t> bytes = readSpan(readUInt16BE());
+            return std::string((const char *)bytes.data(), bytes.size());
         }
 
         /**
@@ -185,18 +183,25 @@ namespace vexbridge::utils
          */
         std::string readString8()
         {
-            // Read the string length
-            uint8_t stringLength = readUInt8();
-
-            // Check for buffer overflow
-            if (stringLength > buffer.size() - offset)
-                stringLength = buffer.size() - offset;
-
-            std::string str = "";
-            for (uint8_t i = 0; i < stringLength; i++)
-                str += (char)readUInt8();
+            std::span<const uint8_t> bytes = readSpan(readUInt8());
+            return std::string((const char *)bytes.data(), bytes.size());
+        }
 
-            return str;
+        /**
+         * Reads an unsigned integer stored as a variable-length quantity (LEB128).
+         * @return The integer read from the buffer.
+         */
+        uint32_t readVarUInt()
+        {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 32 && hasData(); shift += 7)
+            {
+                uint8_t byte = readUInt8();
+                value |= (uint32_t)(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+            return value;
         }
 
         /**
@@ -209,7 +214,66 @@ namespace vexbridge::utils
         }
 
     private:
-        const Buffer &buffer;
+        /**
+         * Reads a multi-byte integer in big-endian format.
+         * Returns 0 if the buffer runs out, matching `readUInt8`.
+         * @tparam T The unsigned integer type.
+         * @return The integer read from the buffer.
+         */
+        template <typename T>
+        T readBE()
+        {
+            T value = readRaw<T>();
+            if constexpr (std::endian::native == std::endian::little)
+                value = byteSwap(value);
+            return value;
+        }
+
+        /**
+         * Reads a multi-byte integer in little-endian format.
+         * @tparam T The unsigned integer type.
+         * @return The integer read from the buffer.
+         */
+        template <typename T>
+        T readLE()
+        {
+            T value = readRaw<T>();
+            if constexpr (std::endian::native == std::endian::big)
+                value = byteSwap(value);
+            return value;
+        }
+
+        template <typename T>
+        T readRaw()
+        {
+            // Fall back to bytewise reads at the end of the buffer
+            T value = 0;
+            if (sizeof(T) > buffer.size() - offset)
+            {
+                uint8_t bytes[sizeof(T)];
+                for (size_t i = 0; i < sizeof(T); i++)
+                    bytes[i] = readUInt8();
+                memcpy(&value, bytes, sizeof(T));
+                return value;
+            }
+
+            memcpy(&value, buffer.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        template <typename T>
+        static T byteSwap(T value)
+        {
+            if constexpr (sizeof(T) == 2)
+                return __builtin_bswap16(value);
+            else if constexpr (sizeof(T) == 4)
+                return __builtin_bswap32(value);
+            else
+                return __builtin_bswap64(value);
+        }
+
+        std::span<const uint8_t> buffer;
         size_t offset = 0;
     };
 }
\ No newline at end of file
@@ -2,24 +2,54 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <string>
+#include <span>
+#include <bit>
+#include <stdexcept>
 #include <algorithm>
 #include "buffer.h"
+#include "staticBuffer.hpp"
 
 namespace vexbridge::utils
 {
     /**
      * Writes data sequentially into a buffer.
+     * Writes into either a growable `Buffer` or fixed-capacity storage such as a `StaticBuffer`.
+     * Multi-byte values are copied with `memcpy` and byte-swapped with `__builtin_bswap`.
      */
     class BufferWriter
     {
     public:
         /**
-         * Creates a new buffer writer.
+         * Creates a new buffer writer that appends to a growable buffer.
          * @param buffer The buffer to write to.
          */
         BufferWriter(Buffer &buffer)
-            : buffer(buffer)
+            : buffer(&buffer)
+        {
+        }
+
+        /**
+         * Creates a new buffer writer that appends to fixed-capacity storage.
+         * Never allocates.
+         * @param storage The storage to write to.
+         * @param length The number of bytes already in `storage`. Updated after each write.
+         */
+        BufferWriter(std::span<uint8_t> storage, size_t &length)
+            : storage(storage),
+              storageLength(&length)
+        {
+        }
+
+        /**
+         * Creates a new buffer writer that appends to a static buffer.
+         * Never allocates.
+         * @param buffer The buffer to write to.
+         */
+        template <size_t Capacity>
+        BufferWriter(StaticBuffer<Capacity> &buffer)
+            : BufferWriter(std::span<uint8_t>(buffer.bytes, Capacity), buffer.length)
         {
         }
 
@@ -29,7 +59,19 @@ namespace vexbridge::utils
          */
         size_t getOffset() const
         {
-            return buffer.size();
+            return buffer ? buffer->size() : *storageLength;
+        }
+
+        /**
+         * Gets the bytes written to the buffer, including any bytes that were in it before the writer was created.
+         * Only valid until the next write.
+         * @return The written bytes.
+         */
+        std::span<uint8_t> getWritten()
+        {
+            if (buffer)
+                return std::span<uint8_t>(buffer->data(), buffer->size());
+            return storage.first(*storageLength);
         }
 
         /**
@@ -38,7 +80,7 @@ namespace vexbridge::utils
          */
         void writeUInt8(uint8_t value)
         {
-            buffer.push_back(value);
+            *reserve(1) = value;
         }
 
         /**
@@ -47,8 +89,7 @@ namespace vexbridge::utils
          */
         void writeUInt16LE(uint16_t value)
         {
-            buffer.push_back(value & 0xFF);
-            buffer.push_back(value >> 8);
+            writeLE(value);
         }
 
         /**
@@ -57,8 +98,16 @@ namespace vexbridge::utils
          */
         void writeUInt16BE(uint16_t value)
         {
-            buffer.push_back(value >> 8);
-            buffer.push_back(value & 0xFF);
+            writeBE(value);
+        }
+
+        /**
+         * Writes an unsigned 32-bit integer to the buffer in big-endian format.
+         * @param value The integer to write.
+         */
+        void writeUInt32BE(uint32_t value)
+        {
+            writeBE(value);
         }
 
         /**
@@ -67,9 +116,7 @@ namespace vexbridge::utils
          */
         void writeFloatBE(float value)
         {
-            uint8_t *bytes = (uint8_t *)&value;
-            for (int i = 3; i >= 0; i--)
-                writeUInt8(bytes[i]);
+            writeBE(std::bit_cast<uint32_t>(value));
         }
 
         /**
@@ -78,9 +125,7 @@ namespace vexbridge::utils
          */
         void writeFloatLE(float value)
         {
-            uint8_t *bytes = (uint8_t *)&value;
-            for (int i = 0; i < 4; i++)
-                writeUInt8(bytes[i]);
+            writeLE(std::bit_cast<uint32_t>(value));
         }
 
         /**
@@ -88,15 +133,24 @@ namespace vexbridge::utils
          * @param bytes The bytes to write.
          * @param length The number of bytes to write. Must be less than or equal to the length of the array.
          */
-        void writeBytes(Buffer bytes, uint16_t length)
+        void writeBytes(std::span<const uint8_t> bytes, size_t length)
         {
             // Check if the length is greater than the array length
             if (length > bytes.size())
                 length = bytes.size();
 
             // Write the bytes
-            for (uint16_t i = 0; i < length; i++)
-                writeUInt8(bytes[i]);
+            if (length > 0)
+                memcpy(reserve(length), bytes.data(), length);
+        }
+
+        /**
+         * Writes a byte array to the buffer.
+         * @param bytes The bytes to write.
+         */
+        void writeBytes(std::span<const uint8_t> bytes)
+        {
+            writeBytes(bytes, bytes.size());
         }
 
         /**
@@ -105,9 +159,7 @@ namespace vexbridge::utils
          */
         void writeDoubleBE(double value)
         {
-            uint8_t *bytes = (uint8_t *)&value;
-            for (int i = 7; i >= 0; i--)
-                writeUInt8(bytes[i]);
+            writeBE(std::bit_cast<uint64_t>(value));
         }
 
         /**
@@ -116,42 +168,149 @@ namespace vexbridge::utils
          */
         void writeDoubleLE(double value)
         {
-            uint8_t *bytes = (uint8_t *)&value;
-            for (int i = 0; i < 8; i++)
-                writeUInt8(bytes[i]);
+            writeLE(std::bit_cast<uint64_t>(value));
         }
 
         /**
          * Writes the length of the string as a uint16_t (BE) followed by the string.
          * @param str The string to write.
          */
-        void writeString16(std::string str)
+        void writeString16(const std::string &str)
         {
-            uint16_t length = str.length();
-            if (length > 0xFFFF)
-                length = 0xFFFF;
+            uint16_t length = std::min<size_t>(str.length(), 0xFFFF);
 
             writeUInt16BE(length);
-            for (uint16_t i = 0; i < length; i++)
-                writeUInt8(str[i]);
+            writeBytes(std::span<const uint8_t>((const uint8_t *)str.data(), length));
         }
 
         /**
          * Writes the length of the string as a uint8_t followed by the string.
          * @param str The string to write.
          */
-        void writeString8(std::string str)
+        void writeString8(const std::string &str)
         {
-            uint8_t length = str.length();
-            if (length > 0xFF)
-                length = 0xFF;
+            uint8_t length = std::min<size_t>(str.length(), 0xFF);
 
             writeUInt8(length);
-            for (uint8_t i = 0; i < length; i++)
-                writeUInt8(str[i]);
+            writeBytes(std::span<const uint8_t>((const uint8_t *)str.data(), length));
+        }
+
+        /**
+         * Writes an unsigned integer as a variable-length quantity (LEB128).
+         * Each byte holds 7 bits, least significant first, with the high bit set if more bytes follow.
+         * @param value The integer to write.
+         */
+        void writeVarUInt(uint32_t value)
+        {
+            while (value >= 0x80)
+            {
+                writeUInt8((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            writeUInt8(value);
+        }
+
+        /**
+         * Overwrites an unsigned 8-bit integer that was already written.
+         * Used to fill in a length once the data after it is written.
+         * @param offset The offset of the integer.
+         * @param value The integer to write.
+         */
+        void setUInt8(size_t offset, uint8_t value)
+        {
+            if (offset + 1 > getOffset())
+                throw std::runtime_error("BufferWriter offset out of range.");
+            getWritten()[offset] = value;
+        }
+
+        /**
+         * Overwrites an unsigned 16-bit integer that was already written, in big-endian format.
+         * Used to fill in a length once the data after it is written.
+         * @param offset The offset of the integer.
+         * @param value The integer to write.
+         */
+        void setUInt16BE(size_t offset, uint16_t value)
+        {
+            if (offset + 2 > getOffset())
+                throw std::runtime_error("BufferWriter offset out of range.");
+            value = toBigEndian(value);
+            memcpy(getWritten().data() + offset, &value, 2);
         }
 
     private:
-        Buffer &buffer;
+        /**
+         * Adds bytes to the end of the buffer.
+         * @param length The number of bytes to add.
+         * @return A pointer to the added bytes.
+         * @throws std::runtime_error if fixed-capacity storage is full.
+         */
+        uint8_t *reserve(size_t length)
+        {
+            if (buffer)
+            {
+                size_t offset = buffer->size();
+                buffer->resize(offset + length);
+                return buffer->data() + offset;
+            }
+
+            size_t offset = *storageLength;
+            if (length > storage.size() - offset)
+                throw std::runtime_error("BufferWriter capacity exceeded.");
+            *storageLength = offset + length;
+            return storage.data() + offset;
+        }
+
+        template <typename T>
+        static T toBigEndian(T value)
+        {
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                if constexpr (sizeof(T) == 2)
+                    return __builtin_bswap16(value);
+                else if constexpr (sizeof(T) == 4)
+                    return __builtin_bswap32(value);
+                else
+                    return __builtin_bswap64(value);
+            }
+            return value;
+        }
+
+        template <typename T>
+        static T toLittleEndian(T value)
+        {
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                if constexpr (sizeof(T) == 2)
+                    return __builtin_bswap16(value);
+                else if constexpr (sizeof(T) == 4)
+                    return __builtin_bswap32(value);
+                else
+                    return __builtin_bswap64(value);
+            }
+            return value;
+        }
+
+        template <typename T>
+        void writeBE(T value)
+        {
+            value = toBigEndian(value);
+            memcpy(reserve(sizeof(T)), &value, sizeof(T));
+        }
+
+        template <typename T>
+        void writeLE(T value)
+        {
+            value = toLittleEndian(value);
+            memcpy(reserve(sizeof(T)), &value, sizeof(T));
+        }
+
+        /// @brief Growable buffer to write to, or nullptr if writing to fixed-capacity storage
+        Buffer *buffer = nullptr;
+
+        /// @brief Fixed-capacity storage to write to
+        std::span<uint8_t> storage;
+
+        /// @brief Number of bytes in `storage`
+        size_t *storageLength = nullptr;
     };
-}
\ No newline at end of file
+}
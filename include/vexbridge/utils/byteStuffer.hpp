@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <stddef.h>
+#include <span>
+#include <cstring>
 #include "buffer.h"
 
 namespace vexbridge::utils
@@ -20,47 +22,57 @@ namespace vexbridge::utils
          */
         static Buffer encode(const Buffer &input)
         {
-            // Create the output buffer
-            Buffer output;
+            // Copy the input into an output buffer of the exact encoded size
+            Buffer output(getEncodedSize(input));
+            if (!input.empty())
+                memcpy(output.data(), input.data(), input.size());
 
-            // Reserve worst-case space for the output buffer
-            output.reserve(input.size() * 2);
+            // Encode in place
+            encodeInPlace(output.data(), input.size());
+            return output;
+        }
 
-            // Add the start flag to the output buffer
-            output.push_back(START_FLAG);
+        /**
+         * Gets the number of bytes `encode` writes for an input, including the start flag and end flag.
+         * @param input The input bytes.
+         * @return The encoded size in bytes.
+         */
+        static size_t getEncodedSize(std::span<const uint8_t> input)
+        {
+            size_t encodedSize = input.size() + 2;
+            for (uint8_t byte : input)
+                if (isFlag(byte))
+                    encodedSize++;
+            return encodedSize;
+        }
 
-            // Iterate over the input buffer
-            for (size_t inputIndex = 0; inputIndex < input.size(); inputIndex++)
+        /**
+         * Encodes a frame in place without allocating.
+         * Bytes are moved from the back so no unread byte is overwritten.
+         * @param data The frame to encode. Must hold `getEncodedSize` bytes of the frame.
+         * @param length The size of the frame.
+         * @return The number of encoded bytes in `data`.
+         */
+        static size_t encodeInPlace(uint8_t *data, size_t length)
+        {
+            size_t encodedSize = getEncodedSize(std::span<const uint8_t>(data, length));
+
+            // Add the end flag
+            size_t outputIndex = encodedSize - 1;
+            data[outputIndex] = END_FLAG;
+
+            // Copy each byte to its escaped position, from the back
+            for (size_t inputIndex = length; inputIndex-- > 0;)
             {
-                // If the current byte is the end flag, add the escape flag and the end flag to the output buffer
-                if (input[inputIndex] == END_FLAG)
-                {
-                    output.push_back(ESCAPE_FLAG);
-                    output.push_back(END_FLAG);
-                }
-                // If the current byte is the start flag, add the escape flag and the start flag to the output buffer
-                else if (input[inputIndex] == START_FLAG)
-                {
-                    output.push_back(ESCAPE_FLAG);
-                    output.push_back(START_FLAG);
-                }
-                // If the current byte is the escape flag, add 2 escape flags to the output buffer
-                else if (input[inputIndex] == ESCAPE_FLAG)
-                {
-                    output.push_back(ESCAPE_FLAG);
-                    output.push_back(ESCAPE_FLAG);
-                }
-                // Otherwise, add the current byte to the output buffer
-                else
-                {
-                    output.push_back(input[inputIndex]);
-                }
+                uint8_t byte = data[inputIndex];
+                data[--outputIndex] = byte;
+                if (isFlag(byte))
+                    data[--outputIndex] = ESCAPE_FLAG;
             }
 
-            // Add the end flag to the output buffer
-            output.push_back(END_FLAG);
-
-            return output;
+            // Add the start flag
+            data[0] = START_FLAG;
+            return encodedSize;
         }
 
         /**
@@ -70,11 +82,36 @@ namespace vexbridge::utils
          */
         static Buffer decode(const Buffer &input)
         {
-            // Create the output buffer
-            Buffer output;
-
             // Reserve worst-case space for the output buffer
-            output.reserve(input.size());
+            Buffer output(input.size());
+
+            // Decode and trim to the decoded size
+            size_t outputSize = decode(input, output.data());
+            output.resize(outputSize);
+
+            return output;
+        }
+
+        /**
+         * Checks if a byte must be escaped.
+         * @param byte The byte to check.
+         * @return True if the byte is a flag.
+         */
+        static constexpr bool isFlag(uint8_t byte)
+        {
+            return byte == START_FLAG || byte == END_FLAG || byte == ESCAPE_FLAG;
+        }
+
+        /**
+         * Decodes a stuffed frame without allocating.
+         * The output never grows past the input, so `output` may point to `input.data()` to decode in place.
+         * @param input The stuffed frame.
+         * @param output The output array. Must hold at least `input.size()` bytes.
+         * @return The number of bytes written to `output`.
+         */
+        static size_t decode(std::span<const uint8_t> input, uint8_t *output)
+        {
+            size_t outputSize = 0;
 
             // Iterate over the input buffer
             for (size_t inputIndex = 0; inputIndex < input.size(); inputIndex++)
@@ -82,7 +119,7 @@ namespace vexbridge::utils
                 // If the current byte is the start flag, reset and continue
                 if (input[inputIndex] == START_FLAG)
                 {
-                    output.clear();
+                    outputSize = 0;
                     continue;
                 }
                 // If the current byte is the end flag, break out of the loop
@@ -93,16 +130,17 @@ namespace vexbridge::utils
                 // If the current byte is the escape flag, add the next byte to the output buffer
                 if (input[inputIndex] == ESCAPE_FLAG)
                 {
-                    output.push_back(input[++inputIndex]);
+                    if (++inputIndex < input.size())
+                        output[outputSize++] = input[inputIndex];
                 }
                 // Otherwise, add the current byte to the output buffer
                 else
                 {
-                    output.push_back(input[inputIndex]);
+                    output[outputSize++] = input[inputIndex];
                 }
             }
 
-            return output;
+            return outputSize;
         }
     };
 }
\ No newline at end of file
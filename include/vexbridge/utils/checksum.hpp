@@ -1,10 +1,24 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
+#include <stdexcept>
 #include "buffer.h"
+#include "crc.hpp"
 
 namespace vexbridge::utils
 {
+    /**
+     * Algorithm used to check a frame for corruption.
+     * Values are sent in the `ResetPacket` handshake.
+     */
+    enum class ChecksumType : uint8_t
+    {
+        SUM8 = 0,
+        CRC16 = 1,
+        CRC32 = 2,
+    };
+
     /**
      * Helper class for calculating checksums.
      */
@@ -25,11 +39,57 @@ namespace vexbridge::utils
             if (length > buffer.size())
                 throw std::runtime_error("Checksum length exceeds buffer size.");
 
-            // Calculate the checksum
+            return calc(std::span<const uint8_t>(buffer.data(), length));
+        }
+
+        /**
+         * Calculates the 8-bit checksum of a span of bytes using a simple sum algorithm.
+         * @param bytes The bytes to calculate the checksum of.
+         * @return The checksum of the bytes.
+         */
+        static uint8_t calc(std::span<const uint8_t> bytes)
+        {
             uint8_t checksum = 0;
-            for (size_t i = 0; i < length; i++)
-                checksum += buffer[i];
+            for (uint8_t byte : bytes)
+                checksum += byte;
             return checksum;
         }
+
+        /**
+         * Calculates the checksum of a span of bytes using a selectable algorithm.
+         * @param type The checksum algorithm.
+         * @param bytes The bytes to calculate the checksum of.
+         * @return The checksum of the bytes, using the low `getSize(type)` bytes.
+         */
+        static uint32_t calc(ChecksumType type, std::span<const uint8_t> bytes)
+        {
+            switch (type)
+            {
+            case ChecksumType::CRC16:
+                return Crc::calc16(bytes);
+            case ChecksumType::CRC32:
+                return Crc::calc32(bytes);
+            default:
+                return calc(bytes);
+            }
+        }
+
+        /**
+         * Gets the number of bytes a checksum takes in a frame.
+         * @param type The checksum algorithm.
+         * @return The size of the checksum in bytes.
+         */
+        static constexpr size_t getSize(ChecksumType type)
+        {
+            switch (type)
+            {
+            case ChecksumType::CRC16:
+                return 2;
+            case ChecksumType::CRC32:
+                return 4;
+            default:
+                return 1;
+            }
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+
+namespace vexbridge::utils
+{
+    /**
+     * Estimates the offset between the local clock and the clock of the other side of a link.
+     * Each sample is an NTP-style exchange of four timestamps. Of the last `SAMPLE_COUNT` samples,
+     * the one with the shortest round trip is used, since it waited the least in queues (the NTP clock filter).
+     * Timestamps are 32-bit microseconds and all math is modulo 2^32, so the clocks may start at any time.
+     */
+    class ClockSync
+    {
+    public:
+        /**
+         * Adds a completed exchange.
+         * Should be called from a single task. The estimate may be read from any task.
+         * @param originTime Time the request was sent, on the local clock.
+         * @param receiveTime Time the request was received, on the remote clock.
+         * @param transmitTime Time the reply was sent, on the remote clock.
+         * @param arrivalTime Time the reply was received, on the local clock.
+         */
+        void addSample(uint32_t originTime, uint32_t receiveTime, uint32_t transmitTime, uint32_t arrivalTime)
+        {
+            // Time spent on the link, without the time the other side held the request
+            int32_t roundTripTime = (int32_t)(arrivalTime - originTime) - (int32_t)(transmitTime - receiveTime);
+            if (roundTripTime < 0)
+                return;
+
+            // outbound = offset + delay there, inbound = offset - delay back
+            // The difference is the round trip, which is small, so halving it never overflows
+            uint32_t outbound = receiveTime - originTime;
+            uint32_t inbound = transmitTime - arrivalTime;
+            uint32_t offset = inbound + (uint32_t)((int32_t)(outbound - inbound) / 2);
+
+            samples[nextSample] = Sample{offset, (uint32_t)roundTripTime};
+            nextSample = (nextSample + 1) % SAMPLE_COUNT;
+            sampleCount = std::min(sampleCount + 1, SAMPLE_COUNT);
+
+            // Use the sample with the shortest round trip
+            const Sample *bestSample = std::min_element(
+                samples,
+                samples + sampleCount,
+                [](const Sample &a, const Sample &b)
+                { return a.roundTripTime < b.roundTripTime; });
+            this->offset.store(bestSample->offset, std::memory_order_relaxed);
+            this->roundTripTime.store(bestSample->roundTripTime, std::memory_order_relaxed);
+            isSynchronizedFlag.store(true, std::memory_order_release);
+        }
+
+        /**
+         * Checks if any exchange has completed.
+         * @return True if the offset is known.
+         */
+        bool isSynchronized() const
+        {
+            return isSynchronizedFlag.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Gets the offset of the remote clock.
+         * @return The remote time minus the local time in microseconds, modulo 2^32.
+         */
+        uint32_t getOffset() const
+        {
+            return offset.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets the round-trip time of the sample the offset was taken from.
+         * The offset is accurate to within half of it.
+         * @return The round-trip time in microseconds, or 0 if not synchronized.
+         */
+        uint32_t getRoundTripTime() const
+        {
+            return roundTripTime.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Moves a past time from the remote clock to the local clock.
+         * @param remoteTime The time on the remote clock in microseconds.
+         * @param now The current local time in microseconds. Extends the result to 64 bits.
+         * @return The local time in microseconds, no later than `now`.
+         */
+        uint64_t toLocalTime(uint32_t remoteTime, uint64_t now) const
+        {
+            // Times within 35 minutes of now are extended correctly
+            int32_t age = (int32_t)((uint32_t)now - (remoteTime - getOffset()));
+            return now - (uint64_t)std::max(age, 0);
+        }
+
+    private:
+        /**
+         * A completed exchange.
+         */
+        struct Sample
+        {
+            /// @brief Remote time minus local time in microseconds, modulo 2^32
+            uint32_t offset = 0;
+
+            /// @brief Round-trip time in microseconds
+            uint32_t roundTripTime = 0;
+        };
+
+        /// @brief Number of recent samples the best is chosen from
+        static constexpr size_t SAMPLE_COUNT = 8;
+
+        /// @brief Recent samples
+        Sample samples[SAMPLE_COUNT];
+
+        /// @brief Index to write the next sample to
+        size_t nextSample = 0;
+
+        /// @brief Number of samples written, up to `SAMPLE_COUNT`
+        size_t sampleCount = 0;
+
+        /// @brief Offset of the best sample
+        std::atomic<uint32_t> offset = 0;
+
+        /// @brief Round-trip time of the best sample
+        std::atomic<uint32_t> roundTripTime = 0;
+
+        /// @brief True once a sample was added
+        std::atomic<bool> isSynchronizedFlag = false;
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+namespace vexbridge::utils
+{
+    /**
+     * Consistent overhead byte stuffing (COBS).
+     * Removes every 0x00 from a frame so 0x00 can be used as the frame delimiter.
+     * Adds 1 byte per 254 bytes of input, compared to up to 1 byte per byte when escaping.
+     */
+    struct Cobs
+    {
+        // Prevent instantiation
+        Cobs() = delete;
+
+        /// @brief Frame delimiter. Never appears inside an encoded frame.
+        static constexpr uint8_t DELIMITER = 0x00;
+
+        /// @brief Returned by `decode` if the input is not valid COBS
+        static constexpr size_t INVALID = (size_t)-1;
+
+        /**
+         * Gets the most bytes `encode` adds to an input, not counting the delimiter.
+         * @param inputSize The size of the input.
+         * @return The maximum overhead in bytes.
+         */
+        static constexpr size_t getMaxOverhead(size_t inputSize)
+        {
+            return inputSize / 254 + 1;
+        }
+
+        /**
+         * Gets the most bytes `encode` writes for an input, including the delimiter.
+         * @param inputSize The size of the input.
+         * @return The maximum encoded size in bytes.
+         */
+        static constexpr size_t getMaxEncodedSize(size_t inputSize)
+        {
+            return inputSize + getMaxOverhead(inputSize) + 1;
+        }
+
+        /**
+         * Encodes a frame and appends the delimiter.
+         * Can encode in place if the input starts `getMaxOverhead(input.size())` bytes after the output,
+         * since the output never catches up to the unread input.
+         * @param input The frame to encode.
+         * @param output The output bytes. Must hold `getMaxEncodedSize(input.size())` bytes.
+         * @return The number of bytes written to `output`.
+         */
+        static size_t encode(std::span<const uint8_t> input, std::span<uint8_t> output)
+        {
+            const uint8_t *in = input.data();
+            const size_t inputSize = input.size();
+            uint8_t *out = output.data();
+
+            // Each block starts with a code byte holding the distance to the next 0x00
+            size_t codeIndex = 0;
+            size_t outputIndex = 1;
+            uint8_t code = 1;
+            for (size_t i = 0; i < inputSize; i++)
+            {
+                uint8_t byte = in[i];
+                if (byte != 0)
+                {
+                    out[outputIndex++] = byte;
+                    code++;
+                }
+
+                // End the block at a 0x00 or after 254 data bytes
+                if (byte == 0 || code == 0xFF)
+                {
+                    out[codeIndex] = code;
+                    codeIndex = outputIndex++;
+                    code = 1;
+                }
+            }
+            out[codeIndex] = code;
+
+            out[outputIndex++] = DELIMITER;
+            return outputIndex;
+        }
+
+        /**
+         * Decodes a frame without its delimiter.
+         * The output never grows past the input, so `output` may point to `input.data()` to decode in place.
+         * @param input The encoded frame, without the delimiter.
+         * @param output The output array. Must hold at least `input.size()` bytes.
+         * @return The number of bytes written to `output` or `INVALID` if the input is corrupt.
+         */
+        static size_t decode(std::span<const uint8_t> input, uint8_t *output)
+        {
+            const uint8_t *in = input.data();
+            const size_t inputSize = input.size();
+            size_t outputSize = 0;
+
+            size_t i = 0;
+            while (i < inputSize)
+            {
+                // Each code byte is followed by `code - 1` data bytes
+                uint8_t code = in[i++];
+                if (code == 0 || i + code - 1 > inputSize)
+                    return INVALID;
+
+                for (uint8_t j = 1; j < code; j++)
+                    output[outputSize++] = in[i++];
+
+                // A 0x00 follows every block except full blocks and the last block
+                if (code != 0xFF && i < inputSize)
+                    output[outputSize++] = 0;
+            }
+            return outputSize;
+        }
+    };
+}
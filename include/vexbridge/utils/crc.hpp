@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <span>
+
+namespace vexbridge::utils
+{
+    /**
+     * Generates the CRC-16/CCITT-FALSE lookup table.
+     */
+    constexpr std::array<uint16_t, 256> makeCrc16Table()
+    {
+        std::array<uint16_t, 256> table{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint16_t crc = i << 8;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    /**
+     * Generates the CRC-32 slice-by-4 lookup tables.
+     */
+    constexpr std::array<std::array<uint32_t, 256>, 4> makeCrc32Tables()
+    {
+        std::array<std::array<uint32_t, 256>, 4> tables{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+            tables[0][i] = crc;
+        }
+
+        // Each table advances the previous one by another zero byte
+        for (uint32_t i = 0; i < 256; i++)
+            for (int slice = 1; slice < 4; slice++)
+                tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+        return tables;
+    }
+
+    /**
+     * Table-driven CRC-16 and CRC-32 calculations.
+     * Tables are generated at compile time and stored in flash.
+     */
+    struct Crc
+    {
+        // Prevent instantiation
+        Crc() = delete;
+
+        /**
+         * Calculates the CRC-16/CCITT-FALSE of a span of bytes (poly 0x1021, init 0xFFFF).
+         * Uses one table lookup per byte.
+         * @param bytes The bytes to calculate the CRC of.
+         * @return The CRC of the bytes.
+         */
+        static uint16_t calc16(std::span<const uint8_t> bytes)
+        {
+            uint16_t crc = 0xFFFF;
+            for (uint8_t byte : bytes)
+                crc = (crc << 8) ^ CRC16_TABLE[(crc >> 8) ^ byte];
+            return crc;
+        }
+
+        /**
+         * Calculates the CRC-32 (IEEE 802.3) of a span of bytes.
+         * Uses slice-by-4, processing 4 bytes per iteration with 4 table lookups.
+         * @param bytes The bytes to calculate the CRC of.
+         * @return The CRC of the bytes.
+         */
+        static uint32_t calc32(std::span<const uint8_t> bytes)
+        {
+            uint32_t crc = 0xFFFFFFFF;
+            const uint8_t *data = bytes.data();
+            size_t length = bytes.size();
+
+            // 4 bytes at a time
+            while (length >= 4)
+            {
+                crc ^= (uint32_t)data[0] |
+                       ((uint32_t)data[1] << 8) |
+                       ((uint32_t)data[2] << 16) |
+                       ((uint32_t)data[3] << 24);
+                crc = CRC32_TABLES[3][crc & 0xFF] ^
+                      CRC32_TABLES[2][(crc >> 8) & 0xFF] ^
+                      CRC32_TABLES[1][(crc >> 16) & 0xFF] ^
+                      CRC32_TABLES[0][crc >> 24];
+                data += 4;
+                length -= 4;
+            }
+
+            // Remaining bytes
+            while (length--)
+                crc = (crc >> 8) ^ CRC32_TABLES[0][(crc ^ *data++) & 0xFF];
+
+            return ~crc;
+        }
+
+    private:
+        static constexpr std::array<uint16_t, 256> CRC16_TABLE = makeCrc16Table();
+        static constexpr std::array<std::array<uint32_t, 256>, 4> CRC32_TABLES = makeCrc32Tables();
+    };
+}
@@ -1,12 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include "pros/rtos.hpp"
 
 namespace vexbridge::utils
 {
     /**
      * Represents a daemon that runs in the background while the user program is running.
-     * The method `update` is called repeatedly in a separate PROS task.
+     * The method `update` is called repeatedly in a separate PROS task once `start` is called.
+     * Derived classes must call `start` at the end of their constructor, so `update` never sees unconstructed members.
      * Be sure to call `pros::delay` in `update` to prevent the task from consuming too much CPU time.
      */
     class Daemon
@@ -18,18 +20,53 @@ namespace vexbridge::utils
         }
 
     protected:
+        /**
+         * Starts calling `update`.
+         * Must be called at the end of the most derived constructor. The task exists before then,
+         * so `notify` is safe to call during construction, but it waits here until every member is constructed.
+         */
+        void start()
+        {
+            isStarted.store(true, std::memory_order_release);
+            daemonTask.notify();
+        }
+
         /**
          * Called repeatedly in a separate PROS task.
          * Be sure to call `pros::delay` in this method to prevent the task from consuming too much CPU time.
          */
         virtual void update() = 0;
 
+        /**
+         * Wakes the daemon task if it is waiting in `waitForNotify`.
+         * Safe to call from any task. A notification sent while the daemon is busy is kept,
+         * so its next wait returns immediately.
+         */
+        void notify()
+        {
+            daemonTask.notify();
+        }
+
+        /**
+         * Waits until `notify` is called or the timeout passes.
+         * Must only be called from `update`.
+         * @param timeout The maximum time to wait in milliseconds.
+         */
+        static void waitForNotify(uint32_t timeout)
+        {
+            pros::Task::notify_take(true, timeout);
+        }
+
     private:
         /**
          * The task method that runs the `update` method.
          */
         void runTask()
         {
+            // Wait for the derived class to finish constructing
+            while (!isStarted.load(std::memory_order_acquire))
+                pros::Task::notify_take(true, TIMEOUT_MAX);
+
             while (true)
             {
                 try
@@ -51,7 +88,10 @@ namespace vexbridge::utils
         // Constants
         static constexpr uint32_t REVIVE_DELAY = 1000;
 
+        // True once `start` is called. Declared before the task, so it is constructed before the task reads it.
+        std::atomic<bool> isStarted = false;
+
         // The task that runs the daemon
-        const pros::Task daemonTask;
+        pros::Task daemonTask;
     };
 };
\ No newline at end of file
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <algorithm>
+
+namespace vexbridge::utils
+{
+    /**
+     * Small LZ77 compressor in the style of the LZ4 block format.
+     * Each sequence is a token byte holding 4-bit literal and match lengths, the literals,
+     * then a 16-bit little-endian offset back into the output and the match length.
+     * Lengths of 15 or more continue in bytes of 255 until a byte below 255.
+     * The last sequence only has literals. Matches are found with a single hash table lookup per position,
+     * which finds the repeated headers and value IDs of consecutive serial frames.
+     */
+    struct Lz
+    {
+        // Prevent instantiation
+        Lz() = delete;
+
+        /// @brief Returned by `compress` if the output does not fit, and by `decompress` if the input is corrupt
+        static constexpr size_t INVALID = (size_t)-1;
+
+        /// @brief Shortest match worth encoding, since a match costs at least 3 bytes
+        static constexpr size_t MIN_MATCH = 4;
+
+        /**
+         * Compresses bytes.
+         * @param input The bytes to compress. At most 65535 bytes.
+         * @param output The output bytes.
+         * @return The number of bytes written to `output`, or `INVALID` if the compressed bytes do not fit.
+         */
+        static size_t compress(std::span<const uint8_t> input, std::span<uint8_t> output)
+        {
+            const uint8_t *in = input.data();
+            const size_t inputSize = input.size();
+            if (inputSize > UINT16_MAX)
+                return INVALID;
+
+            // Position of the last occurrence of each hashed 4 bytes, plus 1 so 0 means none
+            uint16_t table[HASH_SIZE] = {};
+
+            size_t outputSize = 0;
+            size_t literalStart = 0;
+            size_t i = 0;
+            while (i + MIN_MATCH <= inputSize)
+            {
+                // Look up the last occurrence of the next 4 bytes
+                uint32_t sequence = read32(in + i);
+                uint16_t &entry = table[hash(sequence)];
+                size_t candidate = entry;
+                entry = i + 1;
+                if (candidate == 0 || read32(in + candidate - 1) != sequence)
+                {
+                    i++;
+                    continue;
+                }
+                candidate--;
+
+                // Extend the match
+                size_t matchLength = MIN_MATCH;
+                while (i + matchLength < inputSize && in[candidate + matchLength] == in[i + matchLength])
+                    matchLength++;
+
+                // Write the literals before the match, then the match
+                if (!writeSequence(output, outputSize, input.subspan(literalStart, i - literalStart), i - candidate, matchLength))
+                    return INVALID;
+                i += matchLength;
+                literalStart = i;
+            }
+
+            // The last sequence only has literals
+            if (!writeSequence(output, outputSize, input.subspan(literalStart), 0, 0))
+                return INVALID;
+            return outputSize;
+        }
+
+        /**
+         * Decompresses bytes written by `compress`.
+         * Every length and offset is checked, so corrupt input never reads or writes out of bounds.
+         * @param input The compressed bytes.
+         * @param output The output bytes.
+         * @return The number of bytes written to `output`, or `INVALID` if the input is corrupt or does not fit.
+         */
+        static size_t decompress(std::span<const uint8_t> input, std::span<uint8_t> output)
+        {
+            const uint8_t *in = input.data();
+            const size_t inputSize = input.size();
+            uint8_t *out = output.data();
+            size_t outputSize = 0;
+
+            size_t i = 0;
+            while (i < inputSize)
+            {
+                uint8_t token = in[i++];
+
+                // Literals
+                size_t literalLength = token >> 4;
+                if (!readLength(input, i, literalLength))
+                    return INVALID;
+                if (literalLength > inputSize - i || literalLength > output.size() - outputSize)
+                    return INVALID;
+                if (literalLength > 0)
+                    memcpy(out + outputSize, in + i, literalLength);
+                i += literalLength;
+                outputSize += literalLength;
+
+                // The last sequence ends after its literals
+                if (i == inputSize)
+                    break;
+
+                // Match
+                if (inputSize - i < 2)
+                    return INVALID;
+                size_t offset = in[i] | (in[i + 1] << 8);
+                i += 2;
+                size_t matchLength = token & 0x0F;
+                if (!readLength(input, i, matchLength))
+                    return INVALID;
+                matchLength += MIN_MATCH;
+                if (offset == 0 || offset > outputSize || matchLength > output.size() - outputSize)
+                    return INVALID;
+
+                // Copied a byte at a time, since the match may overlap its own output
+                for (size_t j = 0; j < matchLength; j++, outputSize++)
+                    out[outputSize] = out[outputSize - offset];
+            }
+            return outputSize;
+        }
+
+    private:
+        /// @brief Number of entries in the hash table. Kept small, since the table is on the stack.
+        static constexpr size_t HASH_SIZE = 256;
+
+        /**
+         * Reads 4 bytes in native byte order.
+         * @param bytes The bytes to read.
+         * @return The bytes as an integer.
+         */
+        static uint32_t read32(const uint8_t *bytes)
+        {
+            uint32_t value;
+            memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        /**
+         * Hashes 4 bytes into the hash table.
+         * @param sequence The bytes to hash.
+         * @return The index in the hash table.
+         */
+        static size_t hash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> 24;
+        }
+
+        /**
+         * Writes a sequence.
+         * @param output The output bytes.
+         * @param outputSize The number of bytes written so far. Advanced past the sequence.
+         * @param literals The literals before the match.
+         * @param offset The distance back to the match, or 0 for the last sequence.
+         * @param matchLength The length of the match, or 0 for the last sequence.
+         * @return False if the sequence does not fit in `output`.
+         */
+        static bool writeSequence(std::span<uint8_t> output, size_t &outputSize, std::span<const uint8_t> literals, size_t offset, size_t matchLength)
+        {
+            // Token
+            size_t matchCode = matchLength == 0 ? 0 : matchLength - MIN_MATCH;
+            if (outputSize >= output.size())
+                return false;
+            size_t tokenIndex = outputSize++;
+            output[tokenIndex] = (std::min(literals.size(), (size_t)15) << 4) | std::min(matchCode, (size_t)15);
+
+            // Literals
+            if (!writeLength(output, outputSize, literals.size()) || literals.size() > output.size() - outputSize)
+                return false;
+            if (!literals.empty())
+                memcpy(output.data() + outputSize, literals.data(), literals.size());
+            outputSize += literals.size();
+
+            // Match
+            if (matchLength == 0)
+                return true;
+            if (output.size() - outputSize < 2)
+                return false;
+            output[outputSize++] = offset & 0xFF;
+            output[outputSize++] = offset >> 8;
+            return writeLength(output, outputSize, matchCode);
+        }
+
+        /**
+         * Writes the bytes that continue a length of 15 or more.
+         * @param output The output bytes.
+         * @param outputSize The number of bytes written so far. Advanced past the bytes.
+         * @param length The length held in the token.
+         * @return False if the bytes do not fit in `output`.
+         */
+        static bool writeLength(std::span<uint8_t> output, size_t &outputSize, size_t length)
+        {
+            if (length < 15)
+                return true;
+            for (length -= 15;; length -= 255)
+            {
+                if (outputSize >= output.size())
+                    return false;
+                output[outputSize++] = std::min(length, (size_t)255);
+                if (length < 255)
+                    return true;
+            }
+        }
+
+        /**
+         * Reads the bytes that continue a length of 15 or more.
+         * @param input The input bytes.
+         * @param i The index of the next byte. Advanced past the bytes.
+         * @param length The length held in the token. Increased by the bytes.
+         * @return False if the input ends before the length.
+         */
+        static bool readLength(std::span<const uint8_t> input, size_t &i, size_t &length)
+        {
+            if (length < 15)
+                return true;
+            while (true)
+            {
+                if (i >= input.size())
+                    return false;
+                uint8_t byte = input[i++];
+                length += byte;
+                if (byte < 255)
+                    return true;
+            }
+        }
+    };
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <utility>
+
+namespace vexbridge::utils
+{
+    /**
+     * Fixed-capacity, lock-free FIFO with many producers and a single consumer.
+     * Each slot carries a sequence number that tells producers and the consumer whose turn it is,
+     * so `push` never waits on a mutex and never allocates after construction.
+     * @tparam T The type of the items. Must be default-constructible and movable.
+     * @tparam Capacity The maximum number of items stored. Must be a power of 2.
+     */
+    template <typename T, size_t Capacity>
+    class MpscQueue
+    {
+        static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity must be a power of 2");
+
+    public:
+        MpscQueue()
+        {
+            for (size_t i = 0; i < Capacity; i++)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Disable copy and assignment
+        MpscQueue(const MpscQueue &) = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        /**
+         * Adds an item to the back of the queue. Safe to call from any task.
+         * @param item The item to add. Left unchanged if the queue is full.
+         * @return True if the item was added, false if the queue is full.
+         */
+        bool push(T &item)
+        {
+            size_t position = tail.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot &slot = slots[position & MASK];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+                // Claim the slot if it is free
+                // On failure, `position` is reloaded with the current tail
+                if (difference == 0)
+                {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.item = std::move(item);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The consumer has not emptied the slot yet
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed the slot first
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Removes the item at the front of the queue. Must only be called from the consumer task.
+         * @param item Set to the removed item.
+         * @return True if an item was removed, false if the queue is empty.
+         */
+        bool pop(T &item)
+        {
+            Slot &slot = slots[head & MASK];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != head + 1)
+                return false;
+
+            // Free the slot for the producer that wraps around to it
+            item = std::move(slot.item);
+            slot.sequence.store(head + Capacity, std::memory_order_release);
+            head++;
+            return true;
+        }
+
+        /**
+         * Checks if the queue is empty. Only exact when called from the consumer task.
+         * @return True if no items are waiting.
+         */
+        bool empty() const
+        {
+            return slots[head & MASK].sequence.load(std::memory_order_acquire) != head + 1;
+        }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        /**
+         * A single item and the sequence number that tells whose turn it is.
+         * The sequence equals the position when the slot is free, and the position plus one when it holds an item.
+         */
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            T item;
+        };
+
+        /// @brief Slots indexed by position
+        Slot slots[Capacity];
+
+        /// @brief Position of the next item to push. Shared by every producer.
+        std::atomic<size_t> tail = 0;
+
+        /// @brief Position of the next item to pop. Only used by the consumer.
+        size_t head = 0;
+    };
+}
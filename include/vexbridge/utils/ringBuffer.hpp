@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <algorithm>
+
+namespace vexbridge::utils
+{
+    /**
+     * Fixed-capacity FIFO of bytes stored in a circular array.
+     * Never allocates after construction.
+     * @tparam Capacity The maximum number of bytes stored. Must be a power of 2.
+     */
+    template <size_t Capacity>
+    class RingBuffer
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of 2");
+
+    public:
+        /// @brief Returned by `find` if the byte was not found
+        static constexpr size_t NPOS = (size_t)-1;
+
+        /**
+         * Gets the number of bytes stored in the buffer.
+         * @return The number of bytes stored.
+         */
+        size_t size() const
+        {
+            return tail - head;
+        }
+
+        /**
+         * Gets the number of bytes that can be written before the buffer is full.
+         * @return The number of free bytes.
+         */
+        size_t getFree() const
+        {
+            return Capacity - size();
+        }
+
+        /**
+         * Checks if the buffer is empty.
+         * @return True if no bytes are stored.
+         */
+        bool empty() const
+        {
+            return head == tail;
+        }
+
+        /**
+         * Gets the byte at an offset from the front of the buffer.
+         * @param offset The offset from the front. Must be less than `size()`.
+         * @return The byte at the offset.
+         */
+        uint8_t at(const size_t offset) const
+        {
+            return data[(head + offset) & MASK];
+        }
+
+        /**
+         * Appends bytes to the back of the buffer.
+         * Only writes as many bytes as there is free space for.
+         * @param input The bytes to append.
+         * @return The number of bytes written.
+         */
+        size_t write(std::span<const uint8_t> input)
+        {
+            size_t length = std::min(input.size(), getFree());
+            size_t start = tail & MASK;
+
+            // Copy up to the end of the array, then wrap to the front
+            size_t firstLength = std::min(length, Capacity - start);
+            memcpy(data + start, input.data(), firstLength);
+            memcpy(data, input.data() + firstLength, length - firstLength);
+
+            tail += length;
+            return length;
+        }
+
+        /**
+         * Gets the largest contiguous free region at the back of the buffer.
+         * Bytes written into the region are added to the buffer with `commit`.
+         * @return The free region.
+         */
+        std::span<uint8_t> getWriteSpan()
+        {
+            size_t start = tail & MASK;
+            return std::span<uint8_t>(data + start, std::min(getFree(), Capacity - start));
+        }
+
+        /**
+         * Adds bytes written into `getWriteSpan` to the buffer.
+         * @param length The number of bytes written. Must be less than or equal to the write span size.
+         */
+        void commit(const size_t length)
+        {
+            tail += std::min(length, getFree());
+        }
+
+        /**
+         * Removes bytes from the front of the buffer.
+         * @param length The number of bytes to remove.
+         */
+        void discard(const size_t length)
+        {
+            head += std::min(length, size());
+        }
+
+        /**
+         * Removes all bytes from the buffer.
+         */
+        void clear()
+        {
+            head = tail;
+        }
+
+        /**
+         * Gets the largest contiguous region of stored bytes starting at an offset.
+         * Stored bytes that wrap around the end of the array are returned by a second call with a larger offset.
+         * @param offset The offset from the front. Must be less than or equal to `size()`.
+         * @return The contiguous region.
+         */
+        std::span<const uint8_t> getReadSpan(const size_t offset) const
+        {
+            size_t start = (head + offset) & MASK;
+            return std::span<const uint8_t>(data + start, std::min(size() - offset, Capacity - start));
+        }
+
+        /**
+         * Finds the first occurrence of a byte using `memchr` on each contiguous region.
+         * @param value The byte to search for.
+         * @param offset The offset from the front to start searching at.
+         * @return The offset of the byte from the front or `NPOS` if not found.
+         */
+        size_t find(const uint8_t value, size_t offset = 0) const
+        {
+            while (offset < size())
+            {
+                std::span<const uint8_t> region = getReadSpan(offset);
+                const void *match = memchr(region.data(), value, region.size());
+                if (match)
+                    return offset + ((const uint8_t *)match - region.data());
+                offset += region.size();
+            }
+            return NPOS;
+        }
+
+        /**
+         * Gets a contiguous view of the bytes at the front of the buffer.
+         * If the bytes wrap around the end of the array, they are copied into `scratch` first.
+         * @param length The number of bytes to view. Must be less than or equal to `size()`.
+         * @param scratch Storage used if the bytes are not contiguous. Must hold at least `length` bytes.
+         * @return A view of the bytes.
+         */
+        std::span<const uint8_t> peek(const size_t length, uint8_t *scratch) const
+        {
+            size_t start = head & MASK;
+            if (start + length <= Capacity)
+                return std::span<const uint8_t>(data + start, length);
+
+            size_t firstLength = Capacity - start;
+            memcpy(scratch, data + start, firstLength);
+            memcpy(scratch + firstLength, data, length - firstLength);
+            return std::span<const uint8_t>(scratch, length);
+        }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        uint8_t data[Capacity];
+        size_t head = 0; // Index of the first byte, unmasked
+        size_t tail = 0; // Index after the last byte, unmasked
+    };
+}
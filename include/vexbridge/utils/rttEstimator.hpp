@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+namespace vexbridge::utils
+{
+    /**
+     * Estimates the retransmit timeout from measured round-trip times.
+     * Uses the Jacobson/Karels smoothed mean and deviation (RFC 6298) in fixed point,
+     * so the timeout follows the link instead of a fixed value.
+     */
+    class RttEstimator
+    {
+    public:
+        /**
+         * Adds a round-trip time measurement.
+         * Only measure packets that were sent once, since the ACK of a resent packet
+         * cannot be matched to a specific transmission (Karn's algorithm).
+         * @param rtt The round-trip time in milliseconds.
+         */
+        void addSample(uint32_t rtt)
+        {
+            if (!hasSample)
+            {
+                // First sample sets the mean and half of it as the deviation
+                smoothedRtt8 = rtt << 3;
+                rttVariance4 = rtt << 1;
+                hasSample = true;
+            }
+            else
+            {
+                // variance = 3/4 variance + 1/4 |mean - rtt|
+                // mean = 7/8 mean + 1/8 rtt
+                int32_t error = (int32_t)rtt - (int32_t)(smoothedRtt8 >> 3);
+                rttVariance4 += std::abs(error) - (int32_t)(rttVariance4 >> 2);
+                smoothedRtt8 += error;
+            }
+
+            // timeout = mean + 4 * variance
+            timeout = std::clamp<uint32_t>((smoothedRtt8 >> 3) + rttVariance4, MIN_TIMEOUT, MAX_TIMEOUT);
+        }
+
+        /**
+         * Gets the timeout of a packet, doubled for each time it was resent.
+         * @param retries The number of times the packet was resent.
+         * @return The timeout in milliseconds.
+         */
+        uint32_t getTimeout(uint8_t retries = 0) const
+        {
+            return std::min<uint32_t>(timeout << std::min<uint8_t>(retries, 8), MAX_TIMEOUT);
+        }
+
+        /**
+         * Gets the smoothed round-trip time.
+         * @return The smoothed round-trip time in milliseconds or 0 if nothing was measured.
+         */
+        uint32_t getSmoothedRtt() const
+        {
+            return smoothedRtt8 >> 3;
+        }
+
+        /// @brief Timeout used before the first measurement in milliseconds
+        static constexpr uint32_t INITIAL_TIMEOUT = 100;
+
+        /// @brief Lowest timeout in milliseconds
+        static constexpr uint32_t MIN_TIMEOUT = 10;
+
+        /// @brief Highest timeout in milliseconds
+        static constexpr uint32_t MAX_TIMEOUT = 2000;
+
+    private:
+        /// @brief Smoothed round-trip time, multiplied by 8
+        int32_t smoothedRtt8 = 0;
+
+        /// @brief Round-trip time mean deviation, multiplied by 4
+        int32_t rttVariance4 = 0;
+
+        /// @brief True once a round-trip time was measured
+        bool hasSample = false;
+
+        /// @brief Current timeout in milliseconds
+        uint32_t timeout = INITIAL_TIMEOUT;
+    };
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+namespace vexbridge::utils
+{
+    class BufferWriter;
+
+    /**
+     * Fixed-capacity byte buffer with a `Buffer`-like interface.
+     * Stored inline, so a whole frame can be built on the stack or in a member without allocating.
+     * @tparam Capacity The maximum number of bytes stored.
+     */
+    template <size_t Capacity>
+    class StaticBuffer
+    {
+    public:
+        /**
+         * Gets the number of bytes stored.
+         * @return The number of bytes stored.
+         */
+        size_t size() const
+        {
+            return length;
+        }
+
+        /**
+         * Gets the maximum number of bytes stored.
+         * @return The capacity in bytes.
+         */
+        static constexpr size_t capacity()
+        {
+            return Capacity;
+        }
+
+        /**
+         * Checks if no bytes are stored.
+         * @return True if the buffer is empty.
+         */
+        bool empty() const
+        {
+            return length == 0;
+        }
+
+        /**
+         * Gets a pointer to the first byte.
+         * @return The stored bytes.
+         */
+        uint8_t *data()
+        {
+            return bytes;
+        }
+
+        const uint8_t *data() const
+        {
+            return bytes;
+        }
+
+        /**
+         * Sets the number of bytes stored.
+         * New bytes are not initialized.
+         * @param newLength The number of bytes to store.
+         * @throws std::runtime_error if `newLength` exceeds the capacity.
+         */
+        void resize(size_t newLength)
+        {
+            if (newLength > Capacity)
+                throw std::runtime_error("StaticBuffer capacity exceeded.");
+            length = newLength;
+        }
+
+        /**
+         * Removes all bytes.
+         */
+        void clear()
+        {
+            length = 0;
+        }
+
+        uint8_t &operator[](size_t index)
+        {
+            return bytes[index];
+        }
+
+        uint8_t operator[](size_t index) const
+        {
+            return bytes[index];
+        }
+
+        /**
+         * Gets a view of the stored bytes.
+         * @return The stored bytes.
+         */
+        operator std::span<const uint8_t>() const
+        {
+            return std::span<const uint8_t>(bytes, length);
+        }
+
+    private:
+        friend class BufferWriter;
+
+        /// @brief Stored bytes, only the first `length` are valid
+        uint8_t bytes[Capacity];
+
+        /// @brief Number of bytes stored
+        size_t length = 0;
+    };
+}
@@ -24,11 +24,13 @@ namespace vexbridge
          * Creates a new value as a child of this group.
          * @param label The label of the value.
          * @param defaultValue The default value.
+         * @param qos How updates are delivered.
+         * @param options The rate limit, deadband, and refresh interval of the value.
          */
         template <typename T>
-        VBValue<T> addValue(const std::string label, const T defaultValue) const
+        VBValue<T> addValue(const std::string label, const T defaultValue, QoS qos = QoS::RELIABLE, const PublishOptions &options = {}) const
         {
-            return VBValue<T>(path + "/" + label, defaultValue);
+            return VBValue<T>(path + "/" + label, defaultValue, qos, options);
         }
 
         /**
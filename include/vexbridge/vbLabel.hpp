@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <atomic>
+#include "vexBridge.hpp"
+
+namespace vexbridge
+{
+    /**
+     * Label whose ID is looked up once and cached.
+     * Setting a value through a label skips hashing the label string, so it is cheap enough to call every loop.
+     * Unlike `VBValue`, a label has no type or default value, and the ID is assigned on first use.
+     */
+    class VBLabel
+    {
+    public:
+        /**
+         * Creates a new label.
+         * The ID is not assigned until the label is first used.
+         * @param label The label of the value.
+         */
+        explicit VBLabel(std::string label)
+            : label(std::move(label))
+        {
+        }
+
+        /**
+         * Gets the ID of the label, assigning one on first use.
+         * @return The ID of the label.
+         */
+        uint16_t getID() const
+        {
+            int32_t cachedID = id.load(std::memory_order_relaxed);
+            if (cachedID < 0)
+            {
+                cachedID = VEXBridge::getOrAssignID(label);
+                id.store(cachedID, std::memory_order_relaxed);
+            }
+            return cachedID;
+        }
+
+        /**
+         * Gets the value from VEXBridge.
+         * @param defaultValue The default value to return if the value does not exist.
+         * @return The current value or the default value.
+         */
+        template <typename T>
+        T get(const T defaultValue) const
+        {
+            return VEXBridge::getByID<T>(getID(), defaultValue);
+        }
+
+        /**
+         * Sets the value to VEXBridge.
+         * @param value The new value.
+         */
+        template <typename T>
+        void set(const T value) const
+        {
+            VEXBridge::setByID(getID(), value);
+        }
+
+    private:
+        const std::string label;
+
+        /// @brief Cached ID of the label or -1 if it was not looked up yet
+        mutable std::atomic<int32_t> id = -1;
+    };
+}
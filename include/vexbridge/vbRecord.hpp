@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include "utils/bufferWriter.hpp"
+#include "utils/bufferReader.hpp"
+
+namespace vexbridge
+{
+    /**
+     * A named field of a record.
+     * @tparam TRecord The struct that declares the field. May be a base of the record.
+     * @tparam TField The type of the field. Must be a bool, an integer of up to 32 bits, a float, or a double.
+     */
+    template <typename TRecord, typename TField>
+    struct RecordField
+    {
+        static_assert(std::is_arithmetic_v<TField> && sizeof(TField) <= 8 && (std::is_floating_point_v<TField> || sizeof(TField) <= 4),
+                      "Record fields must be bools, integers of up to 32 bits, floats, or doubles");
+
+        /**
+         * Creates a new record field.
+         * @param name The name of the field, sent once in the schema.
+         * @param member Pointer to the field.
+         */
+        constexpr RecordField(const char *name, TField TRecord::*member)
+            : name(name),
+              member(member)
+        {
+        }
+
+        /// @brief Name of the field, sent once in the schema
+        const char *name;
+
+        /// @brief Pointer to the field
+        TField TRecord::*member;
+    };
+
+    /**
+     * Lists the fields of a struct, so it can be sent as one `VBValue` in a single packed frame.
+     * Specialize for each struct with a `FIELDS` tuple of `RecordField`:
+     *
+     *     template <>
+     *     struct vexbridge::RecordTraits<Pose>
+     *     {
+     *         static constexpr auto FIELDS = std::make_tuple(
+     *             RecordField("x", &Pose::x),
+     *             RecordField("y", &Pose::y));
+     *     };
+     *
+     * The struct must be default-constructible. Fields are packed big-endian in the order they are listed.
+     */
+    template <typename T>
+    struct RecordTraits;
+
+    /**
+     * Checks if a type has `RecordTraits`.
+     */
+    template <typename T, typename = void>
+    struct IsRecord : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsRecord<T, std::void_t<decltype(RecordTraits<T>::FIELDS)>> : std::true_type
+    {
+    };
+
+    /**
+     * Packs and unpacks records and describes their fields.
+     * @tparam T A type with `RecordTraits`.
+     */
+    template <typename T>
+    struct RecordCodec
+    {
+        static_assert(IsRecord<T>::value, "Type has no RecordTraits");
+
+        /**
+         * Gets the schema of the record, sent once with its label.
+         * Lists every field as `name:type`, separated by commas, where the type is one of
+         * `bool`, `i8`, `u8`, `i16`, `u16`, `i32`, `u32`, `f32`, or `f64`. For example, `x:f64,y:f64`.
+         * The string is built once and never moves, so its address also identifies the record type.
+         * @return The schema of the record.
+         */
+        static const std::string &getSchema()
+        {
+            static const std::string schema = buildSchema();
+            return schema;
+        }
+
+        /**
+         * Gets the size of a packed record.
+         * @return The size in bytes.
+         */
+        static constexpr size_t getSize()
+        {
+            return std::apply([](const auto &...fields)
+                              { return (sizeof(getFieldType(fields)) + ... + 0); }, RecordTraits<T>::FIELDS);
+        }
+
+        /**
+         * Packs a record.
+         * @param writer The writer to append to.
+         * @param record The record to pack.
+         */
+        static void write(utils::BufferWriter &writer, const T &record)
+        {
+            std::apply([&](const auto &...fields)
+                       { (writeField(writer, record.*(fields.member)), ...); }, RecordTraits<T>::FIELDS);
+        }
+
+        /**
+         * Unpacks a record.
+         * @param reader The reader positioned at the packed record.
+         * @param record Set to the unpacked record.
+         */
+        static void read(utils::BufferReader &reader, T &record)
+        {
+            std::apply([&](const auto &...fields)
+                       { (readField(reader, record.*(fields.member)), ...); }, RecordTraits<T>::FIELDS);
+        }
+
+        /**
+         * Compares a packed record to a record without unpacking it into a copy.
+         * Fields are compared with `==`, so NaNs are never equal.
+         * @param reader The reader positioned at the packed record.
+         * @param record The record to compare.
+         * @return True if every field is equal.
+         */
+        static bool equals(utils::BufferReader &reader, const T &record)
+        {
+            return std::apply([&](const auto &...fields)
+                              { return (equalsField(reader, record.*(fields.member)) && ...); }, RecordTraits<T>::FIELDS);
+        }
+
+    private:
+        template <typename TRecord, typename TField>
+        static constexpr TField getFieldType(const RecordField<TRecord, TField> &field)
+        {
+            return TField();
+        }
+
+        static std::string buildSchema()
+        {
+            std::string schema;
+            std::apply([&](const auto &...fields)
+                       { ((schema += (schema.empty() ? "" : ","), schema += fields.name, schema += ":",
+                           schema += getTypeName<decltype(getFieldType(fields))>()),
+                          ...); }, RecordTraits<T>::FIELDS);
+            return schema;
+        }
+
+        template <typename TField>
+        static const char *getTypeName()
+        {
+            if constexpr (std::is_same_v<TField, bool>)
+                return "bool";
+            else if constexpr (std::is_same_v<TField, float>)
+                return "f32";
+            else if constexpr (std::is_same_v<TField, double>)
+                return "f64";
+            else if constexpr (sizeof(TField) == 1)
+                return std::is_signed_v<TField> ? "i8" : "u8";
+            else if constexpr (sizeof(TField) == 2)
+                return std::is_signed_v<TField> ? "i16" : "u16";
+            else
+                return std::is_signed_v<TField> ? "i32" : "u32";
+        }
+
+        template <typename TField>
+        static void writeField(utils::BufferWriter &writer, TField value)
+        {
+            if constexpr (std::is_same_v<TField, float>)
+                writer.writeFloatBE(value);
+            else if constexpr (std::is_same_v<TField, double>)
+                writer.writeDoubleBE(value);
+            else if constexpr (sizeof(TField) == 1)
+                writer.writeUInt8(value);
+            else if constexpr (sizeof(TField) == 2)
+                writer.writeUInt16BE(value);
+            else
+                writer.writeUInt32BE(value);
+        }
+
+        template <typename TField>
+        static void readField(utils::BufferReader &reader, TField &value)
+        {
+            if constexpr (std::is_same_v<TField, bool>)
+                value = reader.readUInt8() != 0;
+            else if constexpr (std::is_same_v<TField, float>)
+                value = reader.readFloatBE();
+            else if constexpr (std::is_same_v<TField, double>)
+                value = reader.readDoubleBE();
+            else if constexpr (sizeof(TField) == 1)
+                value = (TField)reader.readUInt8();
+            else if constexpr (sizeof(TField) == 2)
+                value = (TField)reader.readUInt16BE();
+            else
+                value = (TField)reader.readUInt32BE();
+        }
+
+        template <typename TField>
+        static bool equalsField(utils::BufferReader &reader, TField value)
+        {
+            TField storedValue;
+            readField(reader, storedValue);
+            return storedValue == value;
+        }
+    };
+}
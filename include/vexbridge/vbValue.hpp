@@ -16,11 +16,18 @@ namespace vexbridge
          * Creates a new value with a label and default value.
          * @param label The label of the value.
          * @param defaultValue The default value.
+         * @param qos How updates are delivered. Use `QoS::BEST_EFFORT` for high-rate values where only the latest matters.
+         * @param options The rate limit, deadband, and refresh interval of the value.
          */
-        VBValue(const std::string label, const T defaultValue)
+        VBValue(const std::string label, const T defaultValue, QoS qos = QoS::RELIABLE, const PublishOptions &options = {})
             : id(VEXBridge::getOrAssignID(label)),
               defaultValue(defaultValue)
         {
+            // Set how updates are sent before the first update
+            VEXBridge::setQoSByID(id, qos);
+            if (!options.isDefault())
+                VEXBridge::setPublishOptionsByID(id, options);
+
             // Set the default value
             set(defaultValue);
         }
@@ -34,6 +41,55 @@ namespace vexbridge
             return VEXBridge::getByID<T>(id, defaultValue);
         }
 
+        /**
+         * Gets the time the current value was captured, on this clock.
+         * @return The time in microseconds since the program started, or 0 if the value was never set.
+         */
+        uint64_t getCaptureTime() const
+        {
+            return VEXBridge::getCaptureTimeByID(id);
+        }
+
+        /**
+         * Gets the value along with when it was captured and how many times it changed.
+         * Compare `updateCount` with an earlier snapshot to check if the value changed since.
+         * @return The current snapshot.
+         */
+        ValueSnapshot<T> getSnapshot() const
+        {
+            return VEXBridge::getSnapshotByID<T>(id, defaultValue);
+        }
+
+        /**
+         * Calls a function each time the value changes.
+         * The function runs on the task that changed the value, usually the serial daemon, so it should be short.
+         * @param callback The function to call.
+         * @return A handle to pass to `unsubscribe`.
+         */
+        uint32_t subscribe(ValueSubscriptions::Callback callback) const
+        {
+            return VEXBridge::subscribeByID(id, std::move(callback));
+        }
+
+        /**
+         * Notifies a task each time the value changes.
+         * @param task The task to notify. It can wait with `pros::Task::notify_take`.
+         * @return A handle to pass to `unsubscribe`.
+         */
+        uint32_t notifyOnChange(pros::Task task) const
+        {
+            return VEXBridge::notifyOnChangeByID(id, task);
+        }
+
+        /**
+         * Stops a subscription to the value.
+         * @param handle The handle returned by `subscribe` or `notifyOnChange`.
+         */
+        void unsubscribe(uint32_t handle) const
+        {
+            VEXBridge::unsubscribe(handle);
+        }
+
         /**
          * Sets the value to VEXBridge.
          * @param value The new value.
@@ -43,6 +99,15 @@ namespace vexbridge
             VEXBridge::setByID(id, value);
         }
 
+        /**
+         * Sets the rate limit, deadband, and refresh interval of the value.
+         * @param options The publish options of the value.
+         */
+        void setPublishOptions(const PublishOptions &options) const
+        {
+            VEXBridge::setPublishOptionsByID(id, options);
+        }
+
     private:
         const uint16_t id;
         const T defaultValue;
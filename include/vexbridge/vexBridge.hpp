@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cstring>
+#include <algorithm>
 #include "table/ValueTable.hpp"
 #include "table/LabelTable.hpp"
 #include "serial/drivers/usbSerialDriver.hpp"
 #include "serial/serialSocket.hpp"
 #include "serial/serialWriter.hpp"
+#include "vbRecord.hpp"
 
 using namespace vexbridge::table;
 using namespace vexbridge::serial;
@@ -21,12 +23,179 @@ namespace vexbridge
         /**
          * Opens a new socket connection to the VEXBridge.
          * Once instantiated, all calls to `VEXBridge` can be made statically.
+         * @param framingType How frames are delimited. Must match the VEXBridge.
+         * @param isRecorded True to also record every packet sent to the SD card, so telemetry is kept
+         * when no dashboard is connected. Each run is recorded to a new `/usd/vbNNN.vbr` file.
          */
-        VEXBridge()
-            : socket(std::make_unique<SerialSocket>(std::make_unique<USBSerialDriver>()))
+        VEXBridge(FramingType framingType = FramingType::BYTE_STUFFING, bool isRecorded = false)
+            : socket(std::make_unique<SerialSocket>(std::make_shared<USBSerialDriver>(), framingType,
+                                                    isRecorded ? std::make_shared<FrameRecorder>("/usd", framingType) : nullptr))
         {
         }
 
+        /**
+         * Coalesces value updates into batches instead of sending each update immediately.
+         * Only the latest value of each label is sent, once per flush interval.
+         * Should be called once at startup before any values are set.
+         * @param flushInterval The time between flushes in milliseconds.
+         */
+        static void enableCoalescing(uint32_t flushInterval = DEFAULT_FLUSH_INTERVAL)
+        {
+            SerialWriter::enableCoalescing(flushInterval);
+        }
+
+        /**
+         * Sends float and double arrays as 16-bit fixed point, and only the elements that changed
+         * since the last version VEXBridge received. Shrinks path and array updates at the cost of precision.
+         * Each array is scaled to its largest element, so precision is about 1/32767 of that element.
+         */
+        static void enableArrayQuantization()
+        {
+            SerialPacketWriter::setArrayQuantization(true);
+        }
+
+        /**
+         * Stamps every value update with the time it was set, so the host knows when each value was captured.
+         * Values set locally also keep that time, see `getCaptureTimeByID`.
+         * Values the host stamps are always moved to this clock.
+         * Should be called once at startup before any values are set.
+         */
+        static void enableTimestamps()
+        {
+            SerialWriter::setTimestamped(true);
+            ValueTable::setCaptureTimed(true);
+        }
+
+        /**
+         * Publishes the usage counters of the packet block pool under `_vexbridge/pool/<block size>/`.
+         * Call periodically to check that the pool has stopped growing and never falls back to the heap.
+         */
+        static void publishPoolStats()
+        {
+            // Assign the labels once, so publishing does not allocate
+            static uint16_t statIDs[BlockPool::SIZE_CLASS_COUNT][4];
+            static bool isAssigned = false;
+            if (!isAssigned)
+            {
+                for (size_t i = 0; i < BlockPool::SIZE_CLASS_COUNT; i++)
+                {
+                    std::string prefix = "_vexbridge/pool/" + std::to_string(BlockPool::SIZE_CLASSES[i]) + "/";
+                    statIDs[i][0] = getOrAssignID(prefix + "in_use");
+                    statIDs[i][1] = getOrAssignID(prefix + "high_water");
+                    statIDs[i][2] = getOrAssignID(prefix + "capacity");
+                    statIDs[i][3] = getOrAssignID(prefix + "heap_fallbacks");
+                }
+                isAssigned = true;
+            }
+
+            // Publish the counters
+            for (size_t i = 0; i < BlockPool::SIZE_CLASS_COUNT; i++)
+            {
+                BlockPoolStats stats = BlockPool::getStats(i);
+                setByID<int>(statIDs[i][0], stats.inUse);
+                setByID<int>(statIDs[i][1], stats.highWater);
+                setByID<int>(statIDs[i][2], stats.capacity);
+                setByID<int>(statIDs[i][3], stats.heapFallbacks);
+            }
+        }
+
+        /**
+         * Publishes the usage counters of every serial socket under `_vexbridge/serial/`.
+         * Call periodically to check how much the serial daemon reads per update and whether received bytes are dropped.
+         * Also publishes the longest measured round-trip time of any socket.
+         */
+        static void publishSerialStats()
+        {
+            // Assign the labels once, so publishing does not allocate
+            static uint16_t bytesReadID = getOrAssignID("_vexbridge/serial/bytes_read");
+            static uint16_t bytesWrittenID = getOrAssignID("_vexbridge/serial/bytes_written");
+            static uint16_t sdkCallsID = getOrAssignID("_vexbridge/serial/sdk_calls");
+            static uint16_t overrunsID = getOrAssignID("_vexbridge/serial/overruns");
+            static uint16_t discardedID = getOrAssignID("_vexbridge/serial/discarded");
+            static uint16_t supersededID = getOrAssignID("_vexbridge/serial/superseded");
+            static uint16_t queueOverflowsID = getOrAssignID("_vexbridge/serial/queue_overflows");
+            static uint16_t roundTripID = getOrAssignID("_vexbridge/serial/round_trip_us");
+
+            // Sum the counters of all sockets
+            SerialDriverStats totalStats;
+            uint32_t roundTripTime = 0;
+            for (auto socket : SerialSocket::allInstances)
+            {
+                roundTripTime = std::max(roundTripTime, socket->getClockSync().getRoundTripTime());
+                SerialDriverStats stats = socket->getStats();
+                totalStats.bytesRead += stats.bytesRead;
+                totalStats.bytesWritten += stats.bytesWritten;
+                totalStats.sdkCalls += stats.sdkCalls;
+                totalStats.overruns += stats.overruns;
+                totalStats.discarded += stats.discarded;
+                totalStats.superseded += stats.superseded;
+                totalStats.queueOverflows += stats.queueOverflows;
+            }
+
+            // Publish the counters
+            setByID<int>(bytesReadID, totalStats.bytesRead);
+            setByID<int>(bytesWrittenID, totalStats.bytesWritten);
+            setByID<int>(sdkCallsID, totalStats.sdkCalls);
+            setByID<int>(overrunsID, totalStats.overruns);
+            setByID<int>(discardedID, totalStats.discarded);
+            setByID<int>(supersededID, totalStats.superseded);
+            setByID<int>(queueOverflowsID, totalStats.queueOverflows);
+            setByID<int>(roundTripID, roundTripTime);
+        }
+
+        /**
+         * Sets how updates of a value are delivered.
+         * Values are `QoS::RELIABLE` until set otherwise.
+         * @param label The label of the value.
+         * @param qos The delivery class of the value.
+         */
+        static void setQoS(const std::string &label, QoS qos)
+        {
+            setQoSByID(getOrAssignID(label), qos);
+        }
+
+        /**
+         * Sets how updates of a value are delivered.
+         * @param id The ID of the value.
+         * @param qos The delivery class of the value.
+         */
+        static void setQoSByID(const uint16_t id, QoS qos)
+        {
+            SerialWriter::setQoS(id, qos);
+        }
+
+        /**
+         * Sets the rate limit, deadband, and refresh interval of a value.
+         * Values send every change immediately until set otherwise.
+         * @param label The label of the value.
+         * @param options The publish options of the value.
+         */
+        static void setPublishOptions(const std::string &label, const PublishOptions &options)
+        {
+            setPublishOptionsByID(getOrAssignID(label), options);
+        }
+
+        /**
+         * Sets the rate limit, deadband, and refresh interval of a value.
+         * @param id The ID of the value.
+         * @param options The publish options of the value.
+         */
+        static void setPublishOptionsByID(const uint16_t id, const PublishOptions &options)
+        {
+            SerialWriter::setPublishOptions(id, options);
+        }
+
+        /**
+         * Limits the bytes per second written to each serial port.
+         * Values with publish options are held back while the link is over budget, so they never starve
+         * labels, parameters, or vision traffic. All traffic counts against the budget.
+         * @param bytesPerSecond The byte budget of the link, or 0 for no limit.
+         */
+        static void setLinkBudget(uint32_t bytesPerSecond)
+        {
+            SerialWriter::setLinkBudget(bytesPerSecond);
+        }
+
         /**
          * Retrieves a value from VEXBridge.
          * @param label The label of the value.
@@ -34,17 +203,79 @@ namespace vexbridge
          * @return The value of the value or the default value if the value does not exist.
          */
         template <typename T>
-        static T get(const std::string label, const T defaultValue)
+        static T get(const std::string &label, const T defaultValue)
         {
             // Get the ID of the value
-            if (!LabelTable::contains(label))
+            int32_t id = LabelTable::get(label);
+            if (id < 0)
                 return defaultValue;
-            int16_t id = LabelTable::get(label);
 
             // Get the value
             return getByID<T>(id, defaultValue);
         }
 
+        /**
+         * Gets the time the latest value of an ID was captured.
+         * Values the sender stamped are moved to this clock using the offset measured by `PingPacket` exchanges,
+         * so the age of a value is `pros::micros() - getCaptureTimeByID(id)` and includes the link delay.
+         * Values without a timestamp, or received before the clocks are synchronized, were captured when they arrived.
+         * Values set locally were captured when they were set, if timestamps are enabled or any value has subscribers.
+         * @param id The ID of the value.
+         * @return The time in microseconds since the program started,
+         * or 0 if the value was never set or was set locally without a capture time.
+         */
+        static uint64_t getCaptureTimeByID(const uint16_t id)
+        {
+            return ValueTable::getCaptureTime(id);
+        }
+
+        /**
+         * Gets the value of an ID along with when it was captured and how many times it changed.
+         * Reads never wait on the serial daemon, and the value, time, and count always come from the same update.
+         * @param id The ID of the value.
+         * @param defaultValue The default value to return if the value does not exist.
+         * @return The snapshot of the value, with a capture time of 0 if the value does not exist.
+         * @throws std::runtime_error if the value is of a different type.
+         */
+        template <typename T>
+        static ValueSnapshot<T> getSnapshotByID(const uint16_t id, const T defaultValue)
+        {
+            return ValueTable::getSnapshot<T>(id, defaultValue);
+        }
+
+        /**
+         * Calls a function each time the value or vision frame of an ID changes, whether it was set locally or received.
+         * The function runs on the task that changed the value, usually the serial daemon, so it should be short.
+         * @param id The ID of the value.
+         * @param callback The function to call. Must not subscribe or unsubscribe.
+         * @return A handle to pass to `unsubscribe`.
+         */
+        static uint32_t subscribeByID(const uint16_t id, ValueSubscriptions::Callback callback)
+        {
+            return ValueSubscriptions::subscribe(id, std::move(callback));
+        }
+
+        /**
+         * Notifies a task each time the value or vision frame of an ID changes.
+         * Lets a task wait with `pros::Task::notify_take` and wake as soon as the serial daemon receives a change.
+         * @param id The ID of the value.
+         * @param task The task to notify.
+         * @return A handle to pass to `unsubscribe`.
+         */
+        static uint32_t notifyOnChangeByID(const uint16_t id, pros::Task task)
+        {
+            return ValueSubscriptions::notifyOnChange(id, task);
+        }
+
+        /**
+         * Stops a subscription made with `subscribeByID` or `notifyOnChangeByID`.
+         * @param handle The handle of the subscription.
+         */
+        static void unsubscribe(const uint32_t handle)
+        {
+            ValueSubscriptions::unsubscribe(handle);
+        }
+
         /**
          * Updates a value to the VEXBridge.
          * Sends a packet to the VEXBridge to update the value.
@@ -52,7 +283,7 @@ namespace vexbridge
          * @param value The new value.
          */
         template <typename T>
-        static void set(const std::string label, const T value)
+        static void set(const std::string &label, const T value)
         {
             setByID(getOrAssignID(label), value);
         }
@@ -63,14 +294,13 @@ namespace vexbridge
          * @param label The label to get the ID of.
          * @return The ID of the label.
          */
-        static uint16_t getOrAssignID(const std::string label)
+        static uint16_t getOrAssignID(const std::string &label)
         {
-            if (!LabelTable::contains(label))
-            {
-                auto id = LabelTable::create(label);
+            bool isCreated = false;
+            uint16_t id = LabelTable::getOrCreate(label, isCreated);
+            if (isCreated)
                 SerialWriter::assignLabel(id, label);
-            }
-            return LabelTable::get(label);
+            return id;
         }
 
         /**
@@ -78,20 +308,13 @@ namespace vexbridge
          * @param id The ID of the value.
          * @param defaultValue The default value to return if the value does not exist.
          * @return The value of the value or the default value if the value does not exist.
+         * @throws std::runtime_error if the value is of a different type.
          */
         template <typename T>
         static T getByID(const uint16_t id, const T defaultValue)
         {
-            // Check the type
-            if (!ValueTable::isType<T>(id))
-                throw std::runtime_error("Type mismatch for value " + std::to_string(id));
-
-            // Check if the value exists
-            if (!ValueTable::contains(id))
-                return defaultValue;
-
-            // Get the value
-            return ValueTable::get<T>(id);
+            // Throws if the value is of a different type
+            return ValueTable::get<T>(id, defaultValue);
         }
 
         /**
@@ -103,15 +326,43 @@ namespace vexbridge
         template <typename T>
         static void setByID(const uint16_t id, const T value)
         {
-            if (ValueTable::contains(id) &&
-                ValueTable::get<T>(id) == value)
-                return;
+            // Records are packed into a single update
+            if constexpr (IsRecord<T>::value)
+                setRecordByID(id, value);
 
-            ValueTable::set(id, value);
-            updateValue<T>(id, value);
+            // Only send values that changed
+            else if (ValueTable::set(id, value))
+                updateValue<T>(id, value);
         }
 
     protected:
+        /**
+         * Updates a struct value with `RecordTraits` in a single packed packet.
+         * The schema is announced with the label the first time the value is set to this record type.
+         * @param id The ID of the value.
+         * @param value The new value.
+         */
+        template <typename T>
+        static void setRecordByID(const uint16_t id, const T &value)
+        {
+            const std::string &schema = RecordCodec<T>::getSchema();
+            bool isSchemaAnnounced = ValueTable::getSchema(id) == &schema;
+
+            // Only send values that changed
+            if (!ValueTable::set(id, value))
+                return;
+
+            // Resend the label with the schema, so the host can unpack the record
+            if (!isSchemaAnnounced)
+                SerialWriter::assignLabel(id, LabelTable::getLabel(id), schema);
+
+            Buffer packedValue;
+            packedValue.reserve(RecordCodec<T>::getSize());
+            BufferWriter writer(packedValue);
+            RecordCodec<T>::write(writer, value);
+            SerialWriter::updateRecord(id, std::move(packedValue));
+        }
+
         template <typename T>
         static void updateValue(const uint16_t id, const T value)
         {
@@ -120,6 +371,9 @@ namespace vexbridge
         }
 
     private:
+        /// @brief Default time between coalesced flushes in milliseconds
+        static constexpr uint32_t DEFAULT_FLUSH_INTERVAL = 20;
+
         std::unique_ptr<SerialSocket> socket;
     };
 }
@@ -3,5 +3,6 @@
 #include "vexBridge.hpp"
 #include "vbGroup.hpp"
 #include "vbValue.hpp"
+#include "vbLabel.hpp"
 
 using namespace vexbridge;
\ No newline at end of file